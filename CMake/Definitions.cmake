@@ -9,6 +9,7 @@ foreach(
   DISABLE_ZERO_TIER
   DISABLE_STREAMING_MUSIC
   DISABLE_STREAMING_SOUNDS
+  DISABLE_RENDER_THREADS
   BUILD_TESTING
   GPERF
   GPERF_HEAP_MAIN
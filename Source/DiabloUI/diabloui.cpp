@@ -460,6 +460,7 @@ void UiHandleEvents(SDL_Event *event)
 		} else if (event->window.event == SDL_WINDOWEVENT_HIDDEN) {
 			gbActive = false;
 		} else if (event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+			InvalidateOutputSurface();
 			ReinitializeHardwareCursor();
 		} else if (event->window.event == SDL_WINDOWEVENT_FOCUS_LOST) {
 			music_mute();
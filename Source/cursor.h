@@ -37,7 +37,7 @@ extern int8_t pcursinvitem;
 extern uint16_t pcursstashitem;
 extern int8_t pcursitem;
 extern int8_t pcursobj;
-extern int8_t pcursplr;
+extern DVL_API_FOR_TEST int8_t pcursplr;
 extern Point cursPosition;
 extern DVL_API_FOR_TEST int pcurs;
 
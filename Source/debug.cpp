@@ -962,6 +962,11 @@ std::string DebugCmdToggleFPS(const string_view parameter)
 	return "";
 }
 
+std::string DebugCmdPlayerGFXStats(const string_view parameter)
+{
+	return fmt::format("Player graphics shown from the previous set while loading: {}", GetPlayerGFXStallsAvoided());
+}
+
 std::vector<DebugCmdItem> DebugCmdList = {
 	{ "help", "Prints help overview or help for a specific command.", "({command})", &DebugCmdHelp },
 	{ "give gold", "Fills the inventory with gold.", "", &DebugCmdGiveGoldCheat },
@@ -998,6 +1003,7 @@ std::vector<DebugCmdItem> DebugCmdList = {
 	{ "questinfo", "Shows info of quests.", "{id}", &DebugCmdQuestInfo },
 	{ "playerinfo", "Shows info of player.", "{playerid}", &DebugCmdPlayerInfo },
 	{ "fps", "Toggles displaying FPS", "", &DebugCmdToggleFPS },
+	{ "plrgfxstats", "Shows how often player graphics were loaded without stopping the game.", "", &DebugCmdPlayerGFXStats },
 };
 
 } // namespace
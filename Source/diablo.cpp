@@ -30,7 +30,9 @@
 #include "drlg_l4.h"
 #include "dx.h"
 #include "encrypt.h"
+#include "engine/assets.hpp"
 #include "engine/cel_sprite.hpp"
+#include "engine/benchmark.hpp"
 #include "engine/demomode.h"
 #include "engine/load_cel.hpp"
 #include "engine/load_file.hpp"
@@ -41,6 +43,7 @@
 #include "help.h"
 #include "hwcursor.hpp"
 #include "init.h"
+#include "interfac.h"
 #include "lighting.h"
 #include "loadsave.h"
 #include "menu.h"
@@ -56,6 +59,7 @@
 #include "panels/spell_list.hpp"
 #include "pfile.h"
 #include "plrmsg.h"
+#include "portal.h"
 #include "qol/chatlog.h"
 #include "qol/itemlabels.h"
 #include "qol/monhealthbar.h"
@@ -186,6 +190,8 @@ void FreeGame()
 	FreeDebugGFX();
 #endif
 	FreeGameMem();
+	// FreeGameMem also runs between levels, where the prefetched assets of the next level have to survive
+	ClearPreloadedAssets();
 	music_stop();
 }
 
@@ -781,12 +787,16 @@ void RunGameLoop(interface_mode uMsg)
 			continue;
 		}
 
+		if (ActiveBenchmark != nullptr)
+			ActiveBenchmark->BeginFrame();
 		diablo_color_cyc_logic();
 		multi_process_network_packets();
 		game_loop(gbGameLoopStartup);
 		gbGameLoopStartup = false;
 		if (drawGame)
 			DrawAndBlit();
+		if (ActiveBenchmark != nullptr)
+			ActiveBenchmark->EndFrame();
 #ifdef GPERF_HEAP_FIRST_GAME_ITERATION
 		if (run_game_iteration++ == 0)
 			HeapProfilerDump("first_game_iteration");
@@ -847,6 +857,7 @@ void PrintHelpOption(string_view flags, string_view description)
 	PrintHelpOption("--record <#>", _(/* TRANSLATORS: Commandline Option */ "Record a demo file"));
 	PrintHelpOption("--demo <#>", _(/* TRANSLATORS: Commandline Option */ "Play a demo file"));
 	PrintHelpOption("--timedemo", _(/* TRANSLATORS: Commandline Option */ "Disable all frame limiting during demo playback"));
+	PrintHelpOption("--benchmark <file>", _(/* TRANSLATORS: Commandline Option */ "Play the demo without a window and write timings to a JSON file"));
 	printNewlineInConsole();
 	printInConsole(_(/* TRANSLATORS: Commandline Option */ "Game selection:"));
 	printNewlineInConsole();
@@ -882,6 +893,7 @@ void DiabloParseFlags(int argc, char **argv)
 	std::string currentCommand;
 #endif
 	bool timedemo = false;
+	std::string benchmarkReport;
 	int demoNumber = -1;
 	int recordNumber = -1;
 	bool createDemoReference = false;
@@ -922,6 +934,18 @@ void DiabloParseFlags(int argc, char **argv)
 			gbShowIntro = false;
 		} else if (arg == "--timedemo") {
 			timedemo = true;
+		} else if (arg == "--benchmark") {
+			if (i + 1 == argc) {
+				PrintFlagsRequiresArgument("--benchmark");
+				diablo_quit(0);
+			}
+			benchmarkReport = argv[++i];
+			timedemo = true;
+#ifndef USE_SDL1
+			// Nothing is presented while benchmarking, so there is no need for a real window or audio device.
+			SDL_setenv("SDL_VIDEODRIVER", "dummy", /*overwrite=*/0);
+			SDL_setenv("SDL_AUDIODRIVER", "dummy", /*overwrite=*/0);
+#endif
 		} else if (arg == "--record") {
 			if (i + 1 == argc) {
 				PrintFlagsRequiresArgument("--record");
@@ -971,8 +995,14 @@ void DiabloParseFlags(int argc, char **argv)
 		DebugCmdsFromCommandLine.push_back(currentCommand);
 #endif
 
+	if (!benchmarkReport.empty() && demoNumber == -1) {
+		printInConsole("--benchmark requires --demo");
+		printNewlineInConsole();
+		diablo_quit(1);
+	}
+
 	if (demoNumber != -1)
-		demo::InitPlayBack(demoNumber, timedemo);
+		demo::InitPlayBack(demoNumber, timedemo, std::move(benchmarkReport));
 	if (recordNumber != -1)
 		demo::InitRecording(recordNumber, createDemoReference);
 }
@@ -1099,65 +1129,102 @@ void DiabloDeinit()
 		SDL_Quit();
 }
 
-void LoadLvlGFX()
-{
-	assert(pDungeonCels == nullptr);
-	constexpr int SpecialCelWidth = 64;
+struct LevelGfxPaths {
+	const char *cel;
+	const char *til;
+	const char *min;
+	const char *special;
+};
 
-	switch (leveltype) {
+LevelGfxPaths GetLevelGfxPaths(dungeon_type levelType)
+{
+	switch (levelType) {
 	case DTYPE_TOWN:
-		if (gbIsHellfire) {
-			pDungeonCels = LoadFileInMem("NLevels\\TownData\\Town.CEL");
-			pMegaTiles = LoadFileInMem<MegaTile>("NLevels\\TownData\\Town.TIL");
-			pLevelPieces = LoadFileInMem<uint16_t>("NLevels\\TownData\\Town.MIN");
-		} else {
-			pDungeonCels = LoadFileInMem("Levels\\TownData\\Town.CEL");
-			pMegaTiles = LoadFileInMem<MegaTile>("Levels\\TownData\\Town.TIL");
-			pLevelPieces = LoadFileInMem<uint16_t>("Levels\\TownData\\Town.MIN");
-		}
-		pSpecialCels = LoadCel("Levels\\TownData\\TownS.CEL", SpecialCelWidth);
-		break;
+		if (gbIsHellfire)
+			return { "NLevels\\TownData\\Town.CEL", "NLevels\\TownData\\Town.TIL", "NLevels\\TownData\\Town.MIN", "Levels\\TownData\\TownS.CEL" };
+		return { "Levels\\TownData\\Town.CEL", "Levels\\TownData\\Town.TIL", "Levels\\TownData\\Town.MIN", "Levels\\TownData\\TownS.CEL" };
 	case DTYPE_CATHEDRAL:
-		pDungeonCels = LoadFileInMem("Levels\\L1Data\\L1.CEL");
-		pMegaTiles = LoadFileInMem<MegaTile>("Levels\\L1Data\\L1.TIL");
-		pLevelPieces = LoadFileInMem<uint16_t>("Levels\\L1Data\\L1.MIN");
-		pSpecialCels = LoadCel("Levels\\L1Data\\L1S.CEL", SpecialCelWidth);
-		break;
+		return { "Levels\\L1Data\\L1.CEL", "Levels\\L1Data\\L1.TIL", "Levels\\L1Data\\L1.MIN", "Levels\\L1Data\\L1S.CEL" };
 	case DTYPE_CATACOMBS:
-		pDungeonCels = LoadFileInMem("Levels\\L2Data\\L2.CEL");
-		pMegaTiles = LoadFileInMem<MegaTile>("Levels\\L2Data\\L2.TIL");
-		pLevelPieces = LoadFileInMem<uint16_t>("Levels\\L2Data\\L2.MIN");
-		pSpecialCels = LoadCel("Levels\\L2Data\\L2S.CEL", SpecialCelWidth);
-		break;
+		return { "Levels\\L2Data\\L2.CEL", "Levels\\L2Data\\L2.TIL", "Levels\\L2Data\\L2.MIN", "Levels\\L2Data\\L2S.CEL" };
 	case DTYPE_CAVES:
-		pDungeonCels = LoadFileInMem("Levels\\L3Data\\L3.CEL");
-		pMegaTiles = LoadFileInMem<MegaTile>("Levels\\L3Data\\L3.TIL");
-		pLevelPieces = LoadFileInMem<uint16_t>("Levels\\L3Data\\L3.MIN");
-		pSpecialCels = LoadCel("Levels\\L1Data\\L1S.CEL", SpecialCelWidth);
-		break;
+		return { "Levels\\L3Data\\L3.CEL", "Levels\\L3Data\\L3.TIL", "Levels\\L3Data\\L3.MIN", "Levels\\L1Data\\L1S.CEL" };
 	case DTYPE_HELL:
-		pDungeonCels = LoadFileInMem("Levels\\L4Data\\L4.CEL");
-		pMegaTiles = LoadFileInMem<MegaTile>("Levels\\L4Data\\L4.TIL");
-		pLevelPieces = LoadFileInMem<uint16_t>("Levels\\L4Data\\L4.MIN");
-		pSpecialCels = LoadCel("Levels\\L2Data\\L2S.CEL", SpecialCelWidth);
-		break;
+		return { "Levels\\L4Data\\L4.CEL", "Levels\\L4Data\\L4.TIL", "Levels\\L4Data\\L4.MIN", "Levels\\L2Data\\L2S.CEL" };
 	case DTYPE_NEST:
-		pDungeonCels = LoadFileInMem("NLevels\\L6Data\\L6.CEL");
-		pMegaTiles = LoadFileInMem<MegaTile>("NLevels\\L6Data\\L6.TIL");
-		pLevelPieces = LoadFileInMem<uint16_t>("NLevels\\L6Data\\L6.MIN");
-		pSpecialCels = LoadCel("Levels\\L1Data\\L1S.CEL", SpecialCelWidth);
-		break;
+		return { "NLevels\\L6Data\\L6.CEL", "NLevels\\L6Data\\L6.TIL", "NLevels\\L6Data\\L6.MIN", "Levels\\L1Data\\L1S.CEL" };
 	case DTYPE_CRYPT:
-		pDungeonCels = LoadFileInMem("NLevels\\L5Data\\L5.CEL");
-		pMegaTiles = LoadFileInMem<MegaTile>("NLevels\\L5Data\\L5.TIL");
-		pLevelPieces = LoadFileInMem<uint16_t>("NLevels\\L5Data\\L5.MIN");
-		pSpecialCels = LoadCel("NLevels\\L5Data\\L5S.CEL", SpecialCelWidth);
-		break;
+		return { "NLevels\\L5Data\\L5.CEL", "NLevels\\L5Data\\L5.TIL", "NLevels\\L5Data\\L5.MIN", "NLevels\\L5Data\\L5S.CEL" };
 	default:
 		app_fatal("LoadLvlGFX");
 	}
 }
 
+void LoadLvlGFX()
+{
+	assert(pDungeonCels == nullptr);
+	constexpr int SpecialCelWidth = 64;
+
+	const LevelGfxPaths paths = GetLevelGfxPaths(leveltype);
+	PreloadAssets({ paths.cel, paths.til, paths.min, paths.special });
+	pDungeonCels = LoadFileInMem(paths.cel);
+	pMegaTiles = LoadFileInMem<MegaTile>(paths.til);
+	pLevelPieces = LoadFileInMem<uint16_t>(paths.min);
+	pSpecialCels = LoadCel(paths.special, SpecialCelWidth);
+}
+
+/** Distance in tiles from a staircase or town portal at which the tileset of the level behind it is read ahead */
+constexpr int PrefetchDistance = 8;
+
+/** Level type whose tileset was read ahead last, so that it is only requested once while the player is close */
+dungeon_type PrefetchedLevelType = DTYPE_NONE;
+
+/**
+ * @brief Returns the type of the level behind the closest entrance within PrefetchDistance of the position.
+ * @return DTYPE_NONE if there is no entrance close enough
+ */
+dungeon_type GetNearbyLevelType(Point position)
+{
+	dungeon_type levelType = DTYPE_NONE;
+	int closest = PrefetchDistance + 1;
+	for (int i = 0; i < numtrigs; i++) {
+		const dungeon_type triggerLevelType = GetTriggerLevelType(trigs[i]);
+		const int distance = position.WalkingDistance(trigs[i].position);
+		if (triggerLevelType != DTYPE_NONE && distance < closest) {
+			levelType = triggerLevelType;
+			closest = distance;
+		}
+	}
+	for (auto &missile : Missiles) {
+		if (missile._mitype != MIS_TOWN)
+			continue;
+		const int distance = position.WalkingDistance(missile.position.tile);
+		if (distance < closest) {
+			// Portals in town lead to the level of the player that opened it, all others lead to town
+			levelType = leveltype == DTYPE_TOWN ? Portals[missile._misource].ltype : DTYPE_TOWN;
+			closest = distance;
+		}
+	}
+	return levelType;
+}
+
+/**
+ * @brief Reads the tileset of the level the player is walking towards ahead, so that LoadLvlGFX finds it in memory.
+ *
+ * Monster graphics are not read ahead as the monster types of a level are only picked while loading it.
+ */
+void PrefetchNearbyLevelGFX()
+{
+	const dungeon_type levelType = GetNearbyLevelType(MyPlayer->position.tile);
+	if (levelType == PrefetchedLevelType)
+		return;
+	PrefetchedLevelType = levelType;
+	if (levelType == DTYPE_NONE)
+		return;
+	const LevelGfxPaths paths = GetLevelGfxPaths(levelType);
+	PrefetchAssets({ paths.cel, paths.til, paths.min, paths.special });
+}
+
 void LoadAllGFX()
 {
 	IncProgress();
@@ -1165,9 +1232,15 @@ void LoadAllGFX()
 	InitVirtualGamepadGFX(renderer);
 #endif
 	IncProgress();
-	InitObjectGFX();
+	{
+		LoadingStage stage("Objects");
+		InitObjectGFX();
+	}
 	IncProgress();
-	InitMissileGFX(gbIsHellfire);
+	{
+		LoadingStage stage("Missiles");
+		InitMissileGFX(gbIsHellfire);
+	}
 	IncProgress();
 }
 
@@ -1255,28 +1328,29 @@ void GameLogic()
 	if (!ProcessInput()) {
 		return;
 	}
+	ProcessPlayerGFXLoads();
 	if (gbProcessPlayers) {
 		gGameLogicStep = GameLogicStep::ProcessPlayers;
-		ProcessPlayers();
+		RunBenchmarkSection("ProcessPlayers", ProcessPlayers);
 	}
 	if (leveltype != DTYPE_TOWN) {
 		gGameLogicStep = GameLogicStep::ProcessMonsters;
-		ProcessMonsters();
+		RunBenchmarkSection("ProcessMonsters", ProcessMonsters);
 		gGameLogicStep = GameLogicStep::ProcessObjects;
-		ProcessObjects();
+		RunBenchmarkSection("ProcessObjects", ProcessObjects);
 		gGameLogicStep = GameLogicStep::ProcessMissiles;
-		ProcessMissiles();
+		RunBenchmarkSection("ProcessMissiles", ProcessMissiles);
 		gGameLogicStep = GameLogicStep::ProcessItems;
-		ProcessItems();
-		ProcessLightList();
-		ProcessVisionList();
+		RunBenchmarkSection("ProcessItems", ProcessItems);
+		RunBenchmarkSection("ProcessLightList", ProcessLightList);
+		RunBenchmarkSection("ProcessVisionList", ProcessVisionList);
 	} else {
 		gGameLogicStep = GameLogicStep::ProcessTowners;
-		ProcessTowners();
+		RunBenchmarkSection("ProcessTowners", ProcessTowners);
 		gGameLogicStep = GameLogicStep::ProcessItemsTown;
-		ProcessItems();
+		RunBenchmarkSection("ProcessItems", ProcessItems);
 		gGameLogicStep = GameLogicStep::ProcessMissilesTown;
-		ProcessMissiles();
+		RunBenchmarkSection("ProcessMissiles", ProcessMissiles);
 	}
 	gGameLogicStep = GameLogicStep::None;
 
@@ -1288,6 +1362,7 @@ void GameLogic()
 
 	sound_update();
 	CheckTriggers();
+	PrefetchNearbyLevelGFX();
 	CheckQuests();
 	force_redraw |= 1;
 	pfile_update(false);
@@ -1719,6 +1794,7 @@ void FreeGameMem()
 	FreeObjectGFX();
 	FreeMonsterSnd();
 	FreeTownerGFX();
+	ClearPlayerGFXLoads();
 #ifndef USE_SDL1
 	DeactivateVirtualGamepad();
 	FreeVirtualGamepadGFX();
@@ -2093,7 +2169,11 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	SetRndSeed(glSeedTbl[currlevel]);
 	IncProgress();
 	MakeLightTable();
-	LoadLvlGFX();
+	PrefetchedLevelType = DTYPE_NONE;
+	{
+		LoadingStage stage("Level tiles");
+		LoadLvlGFX();
+	}
 	IncProgress();
 
 	if (firstflag) {
@@ -2137,7 +2217,10 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 		SetRndSeed(glSeedTbl[currlevel]);
 
 		if (leveltype != DTYPE_TOWN) {
-			GetLevelMTypes();
+			{
+				LoadingStage stage("Monsters");
+				GetLevelMTypes();
+			}
 			InitThemes();
 			LoadAllGFX();
 		} else {
@@ -2146,7 +2229,10 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 			InitVirtualGamepadGFX(renderer);
 #endif
 			IncProgress();
-			InitMissileGFX(gbIsHellfire);
+			{
+				LoadingStage stage("Missiles");
+				InitMissileGFX(gbIsHellfire);
+			}
 			IncProgress();
 			IncProgress();
 		}
@@ -2242,7 +2328,10 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	} else {
 		LoadSetMap();
 		IncProgress();
-		GetLevelMTypes();
+		{
+			LoadingStage stage("Monsters");
+			GetLevelMTypes();
+		}
 		IncProgress();
 		InitGolems();
 		InitMonsters();
@@ -2250,7 +2339,10 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 #if !defined(USE_SDL1) && !defined(__vita__)
 		InitVirtualGamepadGFX(renderer);
 #endif
-		InitMissileGFX(gbIsHellfire);
+		{
+			LoadingStage stage("Missiles");
+			InitMissileGFX(gbIsHellfire);
+		}
 		IncProgress();
 		InitCorpses();
 		IncProgress();
@@ -2301,6 +2393,7 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	}
 
 	SetDungeonMicros();
+	ClearPreloadedAssets();
 
 	IncProgress();
 	IncProgress();
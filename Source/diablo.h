@@ -61,7 +61,7 @@ enum class MouseActionType : int {
 extern uint32_t glSeedTbl[NUMLEVELS];
 extern dungeon_type gnLevelTypeTbl[NUMLEVELS];
 extern Point MousePosition;
-extern bool gbRunGame;
+extern DVL_API_FOR_TEST bool gbRunGame;
 extern bool gbRunGameResult;
 extern bool ReturnToMainMenu;
 extern DVL_API_FOR_TEST bool zoomflag;
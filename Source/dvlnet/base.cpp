@@ -155,9 +155,11 @@ void base::RecvLocal(packet &pkt)
 		Connect(pkt.Source());
 	}
 	switch (pkt.Type()) {
-	case PT_MESSAGE:
-		message_queue.emplace_back(pkt.Source(), pkt.Message());
+	case PT_MESSAGE: {
+		const buffer_span message = pkt.Message();
+		message_queue.emplace_back(pkt.Source(), buffer_t(message.begin(), message.end()));
 		break;
+	}
 	case PT_TURN:
 		HandleTurn(pkt);
 		break;
@@ -1,5 +1,6 @@
 #include "dvlnet/frame_queue.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "dvlnet/packet.h"
@@ -7,39 +8,59 @@
 namespace devilution {
 namespace net {
 
+namespace {
+
+constexpr size_t MinRingSize = 4096;
+
+} // namespace
+
 framesize_t frame_queue::Size() const
 {
 	return current_size;
 }
 
-buffer_t frame_queue::Read(framesize_t s)
+void frame_queue::Read(unsigned char *dest, framesize_t s)
 {
 	if (current_size < s)
 		throw frame_queue_exception();
-	buffer_t ret;
-	while (s > 0 && s >= buffer_deque.front().size()) {
-		s -= buffer_deque.front().size();
-		current_size -= buffer_deque.front().size();
-		ret.insert(ret.end(),
-		    buffer_deque.front().begin(),
-		    buffer_deque.front().end());
-		buffer_deque.pop_front();
-	}
-	if (s > 0) {
-		ret.insert(ret.end(),
-		    buffer_deque.front().begin(),
-		    buffer_deque.front().begin() + s);
-		buffer_deque.front().erase(buffer_deque.front().begin(),
-		    buffer_deque.front().begin() + s);
-		current_size -= s;
-	}
-	return ret;
+	// The unread bytes may wrap around the end of the ring.
+	const size_t first = std::min<size_t>(s, ring.size() - read_pos);
+	std::memcpy(dest, &ring[read_pos], first);
+	std::memcpy(dest + first, &ring[0], s - first);
+	read_pos = (read_pos + s) & (ring.size() - 1);
+	current_size -= s;
+	if (current_size == 0)
+		read_pos = 0;
+}
+
+void frame_queue::Reserve(size_t size)
+{
+	if (size <= ring.size())
+		return;
+	size_t newSize = std::max(ring.size(), MinRingSize);
+	while (newSize < size)
+		newSize *= 2;
+
+	// Unwrap the unread bytes to the start of the new ring.
+	buffer_t newRing(newSize);
+	const framesize_t unread = current_size;
+	if (unread != 0)
+		Read(newRing.data(), unread);
+	ring = std::move(newRing);
+	read_pos = 0;
+	current_size = unread;
 }
 
-void frame_queue::Write(buffer_t buf)
+void frame_queue::Write(const unsigned char *data, size_t size)
 {
-	current_size += buf.size();
-	buffer_deque.push_back(std::move(buf));
+	if (size == 0)
+		return;
+	Reserve(current_size + size);
+	const size_t writePos = (read_pos + current_size) & (ring.size() - 1);
+	const size_t first = std::min(size, ring.size() - writePos);
+	std::memcpy(&ring[writePos], data, first);
+	std::memcpy(&ring[0], data + first, size - first);
+	current_size += size;
 }
 
 bool frame_queue::PacketReady()
@@ -47,8 +68,9 @@ bool frame_queue::PacketReady()
 	if (nextsize == 0) {
 		if (Size() < sizeof(framesize_t))
 			return false;
-		auto szbuf = Read(sizeof(framesize_t));
-		std::memcpy(&nextsize, &szbuf[0], sizeof(framesize_t));
+		unsigned char szbuf[sizeof(framesize_t)];
+		Read(szbuf, sizeof(framesize_t));
+		std::memcpy(&nextsize, szbuf, sizeof(framesize_t));
 		if (nextsize == 0)
 			throw frame_queue_exception();
 	}
@@ -59,7 +81,8 @@ buffer_t frame_queue::ReadPacket()
 {
 	if (nextsize == 0 || Size() < nextsize)
 		throw frame_queue_exception();
-	auto ret = Read(nextsize);
+	buffer_t ret(nextsize);
+	Read(ret.data(), nextsize);
 	nextsize = 0;
 	return ret;
 }
@@ -1,7 +1,7 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <exception>
 #include <vector>
 
@@ -25,17 +25,21 @@ public:
 	constexpr static framesize_t max_frame_size = 0xFFFF;
 
 private:
+	/** Received bytes that have not been read yet, stored as a ring buffer with a power of two size */
+	buffer_t ring;
+	/** Position of the first unread byte in `ring` */
+	size_t read_pos = 0;
 	framesize_t current_size = 0;
-	std::deque<buffer_t> buffer_deque;
 	framesize_t nextsize = 0;
 
 	framesize_t Size() const;
-	buffer_t Read(framesize_t s);
+	void Read(unsigned char *dest, framesize_t s);
+	void Reserve(size_t size);
 
 public:
 	bool PacketReady();
 	buffer_t ReadPacket();
-	void Write(buffer_t buf);
+	void Write(const unsigned char *data, size_t size);
 
 	static buffer_t MakeFrame(buffer_t packetbuf);
 };
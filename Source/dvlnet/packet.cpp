@@ -138,7 +138,7 @@ plr_t packet::Destination() const
 	return m_dest;
 }
 
-const buffer_t &packet::Message()
+buffer_span packet::Message()
 {
 	assert(have_decrypted);
 	CheckPacketTypeOneOf({ PT_MESSAGE }, m_type);
@@ -193,14 +193,10 @@ void packet_in::Create(buffer_t buf)
 	if (buf.size() < sizeof(packet_type) + 2 * sizeof(plr_t))
 		throw packet_exception();
 
+	// Parsing doesn't modify the buffer, so `Data()` still returns the original
+	// data that the TCP server implementation forwards to clients.
 	decrypted_buffer = std::move(buf);
 	have_decrypted = true;
-
-	// TCP server implementation forwards the original data to clients
-	// so although we are not decrypting anything,
-	// we save a copy in encrypted_buffer anyway
-	encrypted_buffer = decrypted_buffer;
-	have_encrypted = true;
 }
 
 #ifdef PACKET_ENCRYPTION
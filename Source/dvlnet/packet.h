@@ -46,6 +46,48 @@ typedef std::array<unsigned char, crypto_secretbox_KEYBYTES> key_t;
 using key_t = uint8_t;
 #endif
 
+/** A read-only view of a range of bytes, e.g. the payload of a received packet. */
+class buffer_span {
+public:
+	buffer_span() = default;
+
+	buffer_span(const unsigned char *data, size_t size)
+	    : data_(data)
+	    , size_(size)
+	{
+	}
+
+	buffer_span(const buffer_t &buf)
+	    : data_(buf.data())
+	    , size_(buf.size())
+	{
+	}
+
+	const unsigned char *data() const
+	{
+		return data_;
+	}
+
+	size_t size() const
+	{
+		return size_;
+	}
+
+	const unsigned char *begin() const
+	{
+		return data_;
+	}
+
+	const unsigned char *end() const
+	{
+		return data_ + size_;
+	}
+
+private:
+	const unsigned char *data_ = nullptr;
+	size_t size_ = 0;
+};
+
 struct turn_t {
 	seq_t SequenceNumber;
 	int32_t Value;
@@ -80,7 +122,8 @@ protected:
 	packet_type m_type;
 	plr_t m_src;
 	plr_t m_dest;
-	buffer_t m_message;
+	/** Points into `decrypted_buffer` for received packets, and into the message passed to `create` for sent ones */
+	buffer_span m_message;
 	turn_t m_turn;
 	cookie_t m_cookie;
 	plr_t m_newplr;
@@ -93,6 +136,10 @@ protected:
 	bool have_decrypted = false;
 	buffer_t encrypted_buffer;
 	buffer_t decrypted_buffer;
+	/** Position of the next unread byte in `decrypted_buffer` when parsing a received packet */
+	size_t read_pos = 0;
+	/** Storage for the message that `m_message` points to when sending a packet */
+	buffer_t message_data;
 
 public:
 	packet(const key_t &k)
@@ -103,7 +150,7 @@ public:
 	packet_type Type();
 	plr_t Source() const;
 	plr_t Destination() const;
-	const buffer_t &Message();
+	buffer_span Message();
 	turn_t Turn();
 	cookie_t Cookie();
 	plr_t NewPlayer();
@@ -124,6 +171,7 @@ public:
 	using packet_proc<packet_in>::packet_proc;
 	void Create(buffer_t buf);
 	void process_element(buffer_t &x);
+	void process_element(buffer_span &x);
 	template <class T>
 	void process_element(T &x);
 	void Decrypt(buffer_t buf);
@@ -137,6 +185,7 @@ public:
 	void create(Args... args);
 
 	void process_element(buffer_t &x);
+	void process_element(buffer_span &x);
 	template <class T>
 	void process_element(T &x);
 	template <class T>
@@ -193,18 +242,23 @@ void packet_proc<P>::process_data()
 
 inline void packet_in::process_element(buffer_t &x)
 {
-	x.insert(x.begin(), decrypted_buffer.begin(), decrypted_buffer.end());
-	decrypted_buffer.resize(0);
+	x.assign(decrypted_buffer.begin() + read_pos, decrypted_buffer.end());
+	read_pos = decrypted_buffer.size();
+}
+
+inline void packet_in::process_element(buffer_span &x)
+{
+	x = buffer_span(decrypted_buffer.data() + read_pos, decrypted_buffer.size() - read_pos);
+	read_pos = decrypted_buffer.size();
 }
 
 template <class T>
 void packet_in::process_element(T &x)
 {
-	if (decrypted_buffer.size() < sizeof(T))
+	if (decrypted_buffer.size() - read_pos < sizeof(T))
 		throw packet_exception();
-	std::memcpy(&x, decrypted_buffer.data(), sizeof(T));
-	decrypted_buffer.erase(decrypted_buffer.begin(),
-	    decrypted_buffer.begin() + sizeof(T));
+	std::memcpy(&x, decrypted_buffer.data() + read_pos, sizeof(T));
+	read_pos += sizeof(T);
 }
 
 template <>
@@ -239,7 +293,8 @@ inline void packet_out::create<PT_MESSAGE>(plr_t s, plr_t d, buffer_t m)
 	m_type = PT_MESSAGE;
 	m_src = s;
 	m_dest = d;
-	m_message = std::move(m);
+	message_data = std::move(m);
+	m_message = buffer_span(message_data);
 }
 
 template <>
@@ -351,6 +406,11 @@ inline void packet_out::process_element(buffer_t &x)
 	decrypted_buffer.insert(decrypted_buffer.end(), x.begin(), x.end());
 }
 
+inline void packet_out::process_element(buffer_span &x)
+{
+	decrypted_buffer.insert(decrypted_buffer.end(), x.begin(), x.end());
+}
+
 template <class T>
 void packet_out::process_element(T &x)
 {
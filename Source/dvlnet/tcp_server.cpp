@@ -72,9 +72,7 @@ void tcp_server::HandleReceive(const scc &con, const asio::error_code &ec,
 		DropConnection(con);
 		return;
 	}
-	con->recv_buffer.resize(bytesRead);
-	con->recv_queue.Write(std::move(con->recv_buffer));
-	con->recv_buffer.resize(frame_queue::max_frame_size);
+	con->recv_queue.Write(con->recv_buffer.data(), bytesRead);
 	try {
 		while (con->recv_queue.PacketReady()) {
 			try {
@@ -5,14 +5,21 @@
  */
 #include "dx.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
 #include <SDL.h>
 
 #include "controls/plrctrls.h"
 #include "controls/touch/renderers.h"
 #include "engine.h"
+#include "engine/dirty_region.hpp"
 #include "options.h"
 #include "utils/display.h"
 #include "utils/log.hpp"
+#include "utils/sdl_geometry.h"
 #include "utils/sdl_wrap.h"
 
 #ifdef __3DS__
@@ -38,6 +45,14 @@ SDLSurfaceUniquePtr RendererTextureSurface;
 SDL_Surface *PalSurface;
 namespace {
 SDLSurfaceUniquePtr PinnedPalSurface;
+
+#ifndef USE_SDL1
+/** Parts of the output surface that changed since the last `RenderPresent` */
+DirtyRegion OutputDirtyRegion;
+
+/** Whether the output surface was written to without going through `Blit`, or the texture or window surface was recreated */
+bool OutputNeedsFullUpload = true;
+#endif
 } // namespace
 
 /** Whether we render directly to the screen surface, i.e. `PalSurface == GetOutputSurface()` */
@@ -78,6 +93,108 @@ void LimitFrameRate()
 	frameDeadline = tc + v + refreshDelay;
 }
 
+#ifndef USE_SDL1
+/** The palette of `PalSurface` mapped to the pixel format of the output surface */
+std::array<Uint32, 256> PalSurfaceColorMap;
+unsigned int PalSurfaceColorMapVersion = 0;
+Uint32 PalSurfaceColorMapFormat = SDL_PIXELFORMAT_UNKNOWN;
+
+const std::array<Uint32, 256> &GetPalSurfaceColorMap(const SDL_PixelFormat &format)
+{
+	if (PalSurfaceColorMapVersion == pal_surface_palette_version && PalSurfaceColorMapFormat == format.format)
+		return PalSurfaceColorMap;
+
+	const SDL_Palette &palette = *PalSurface->format->palette;
+	PalSurfaceColorMap.fill(0);
+	for (int i = 0; i < palette.ncolors && i < 256; i++) {
+		const SDL_Color &color = palette.colors[i];
+		PalSurfaceColorMap[i] = SDL_MapRGBA(&format, color.r, color.g, color.b, color.a);
+	}
+	PalSurfaceColorMapVersion = pal_surface_palette_version;
+	PalSurfaceColorMapFormat = format.format;
+	return PalSurfaceColorMap;
+}
+
+/**
+ * @brief Clips the rectangles the same way `SDL_BlitSurface` does.
+ * @return false if there is nothing to copy
+ */
+bool ClipBlit(const SDL_Surface &src, SDL_Rect *srcRect, const SDL_Surface &dst, SDL_Rect *dstRect)
+{
+	SDL_Rect srcClipped = srcRect != nullptr ? *srcRect : SDL_Rect { 0, 0, src.w, src.h };
+	int dstX = dstRect != nullptr ? dstRect->x : 0;
+	int dstY = dstRect != nullptr ? dstRect->y : 0;
+
+	if (srcClipped.x < 0) {
+		srcClipped.w += srcClipped.x;
+		dstX -= srcClipped.x;
+		srcClipped.x = 0;
+	}
+	if (srcClipped.y < 0) {
+		srcClipped.h += srcClipped.y;
+		dstY -= srcClipped.y;
+		srcClipped.y = 0;
+	}
+	srcClipped.w = std::min(srcClipped.w, src.w - srcClipped.x);
+	srcClipped.h = std::min(srcClipped.h, src.h - srcClipped.y);
+
+	const SDL_Rect &clip = dst.clip_rect;
+	if (dstX < clip.x) {
+		srcClipped.x += clip.x - dstX;
+		srcClipped.w -= clip.x - dstX;
+		dstX = clip.x;
+	}
+	if (dstY < clip.y) {
+		srcClipped.y += clip.y - dstY;
+		srcClipped.h -= clip.y - dstY;
+		dstY = clip.y;
+	}
+	srcClipped.w = std::min(srcClipped.w, clip.x + clip.w - dstX);
+	srcClipped.h = std::min(srcClipped.h, clip.y + clip.h - dstY);
+
+	const bool visible = srcClipped.w > 0 && srcClipped.h > 0;
+	if (srcRect != nullptr)
+		*srcRect = srcClipped;
+	if (dstRect != nullptr)
+		*dstRect = SDL_Rect { dstX, dstY, visible ? srcClipped.w : 0, visible ? srcClipped.h : 0 };
+	return visible;
+}
+
+/**
+ * @brief Copies `PalSurface` to a 32-bit output surface through a cached color map.
+ *
+ * This is equivalent to `SDL_BlitSurface` but avoids SDL re-mapping the palette
+ * every time it changes and the overhead of SDL's generic blitters.
+ * @return false if the surfaces are not supported and `SDL_BlitSurface` has to be used
+ */
+bool BlitPalSurface(SDL_Surface *src, SDL_Rect *srcRect, SDL_Surface *dst, SDL_Rect *dstRect)
+{
+	if (src != PalSurface || src->format->BytesPerPixel != 1 || src->format->palette == nullptr
+	    || dst->format->BytesPerPixel != 4 || SDL_MUSTLOCK(src) || SDL_MUSTLOCK(dst))
+		return false;
+	Uint32 colorKey;
+	SDL_BlendMode blendMode;
+	if (SDL_GetColorKey(src, &colorKey) == 0 || SDL_GetSurfaceBlendMode(src, &blendMode) < 0 || blendMode != SDL_BLENDMODE_NONE)
+		return false;
+
+	SDL_Rect srcClipped = srcRect != nullptr ? *srcRect : SDL_Rect { 0, 0, src->w, src->h };
+	SDL_Rect dstClipped = dstRect != nullptr ? *dstRect : SDL_Rect { 0, 0, 0, 0 };
+	if (ClipBlit(*src, &srcClipped, *dst, &dstClipped)) {
+		const std::array<Uint32, 256> &colorMap = GetPalSurfaceColorMap(*dst->format);
+		const auto *srcRow = static_cast<const std::uint8_t *>(src->pixels) + srcClipped.y * src->pitch + srcClipped.x;
+		auto *dstRow = static_cast<std::uint8_t *>(dst->pixels) + dstClipped.y * dst->pitch + dstClipped.x * 4;
+		for (int y = 0; y < srcClipped.h; y++, srcRow += src->pitch, dstRow += dst->pitch) {
+			auto *dstPixels = reinterpret_cast<Uint32 *>(dstRow);
+			for (int x = 0; x < srcClipped.w; x++)
+				dstPixels[x] = colorMap[srcRow[x]];
+		}
+	}
+	if (dstRect != nullptr)
+		*dstRect = dstClipped;
+	return true;
+}
+#endif
+
 } // namespace
 
 void dx_init()
@@ -159,8 +276,10 @@ void Blit(SDL_Surface *src, SDL_Rect *srcRect, SDL_Rect *dstRect)
 {
 	SDL_Surface *dst = GetOutputSurface();
 #ifndef USE_SDL1
-	if (SDL_BlitSurface(src, srcRect, dst, dstRect) < 0)
+	if (!BlitPalSurface(src, srcRect, dst, dstRect) && SDL_BlitSurface(src, srcRect, dst, dstRect) < 0)
 		ErrSdl();
+	// SDL_BlitSurface stores the clipped destination in `dstRect`.
+	OutputDirtyRegion.Add(dstRect != nullptr ? MakeRectangle(*dstRect) : Rectangle { { 0, 0 }, { dst->w, dst->h } });
 #else
 	if (!OutputRequiresScaling()) {
 		if (SDL_BlitSurface(src, srcRect, dst, dstRect) < 0)
@@ -216,9 +335,22 @@ void RenderPresent()
 
 #ifndef USE_SDL1
 	if (renderer != nullptr) {
-		if (SDL_UpdateTexture(texture.get(), nullptr, surface->pixels, surface->pitch) <= -1) { // pitch is 2560
-			ErrSdl();
+		if (OutputNeedsFullUpload) {
+			if (SDL_UpdateTexture(texture.get(), nullptr, surface->pixels, surface->pitch) <= -1) { // pitch is 2560
+				ErrSdl();
+			}
+		} else {
+			// Only upload the parts of the texture that have changed, the texture keeps the rest.
+			for (const Rectangle &rect : OutputDirtyRegion.Rects()) {
+				const SDL_Rect sdlRect = MakeSdlRect(rect);
+				const auto *pixels = static_cast<const Uint8 *>(surface->pixels) + rect.position.y * surface->pitch + rect.position.x * surface->format->BytesPerPixel;
+				if (SDL_UpdateTexture(texture.get(), &sdlRect, pixels, surface->pitch) <= -1) {
+					ErrSdl();
+				}
+			}
 		}
+		OutputDirtyRegion.Clear();
+		OutputNeedsFullUpload = false;
 
 		// Clear buffer to avoid artifacts in case the window was resized
 		if (SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255) <= -1) { // TODO only do this if window was resized
@@ -241,11 +373,25 @@ void RenderPresent()
 		}
 	} else {
 		if (ControlMode == ControlTypes::VirtualGamepad) {
+			// The gamepad is drawn on top of the whole surface.
 			RenderVirtualGamepad(surface);
+			OutputNeedsFullUpload = true;
 		}
-		if (SDL_UpdateWindowSurface(ghMainWnd) <= -1) {
-			ErrSdl();
+		if (OutputNeedsFullUpload) {
+			if (SDL_UpdateWindowSurface(ghMainWnd) <= -1) {
+				ErrSdl();
+			}
+		} else if (!OutputDirtyRegion.IsEmpty()) {
+			std::vector<SDL_Rect> rects;
+			rects.reserve(OutputDirtyRegion.Rects().size());
+			for (const Rectangle &rect : OutputDirtyRegion.Rects())
+				rects.push_back(MakeSdlRect(rect));
+			if (SDL_UpdateWindowSurfaceRects(ghMainWnd, rects.data(), static_cast<int>(rects.size())) <= -1) {
+				ErrSdl();
+			}
 		}
+		OutputDirtyRegion.Clear();
+		OutputNeedsFullUpload = false;
 		LimitFrameRate();
 	}
 #else
@@ -258,6 +404,13 @@ void RenderPresent()
 #endif
 }
 
+void InvalidateOutputSurface()
+{
+#ifndef USE_SDL1
+	OutputNeedsFullUpload = true;
+#endif
+}
+
 void PaletteGetEntries(int dwNumEntries, SDL_Color *lpEntries)
 {
 	for (int i = 0; i < dwNumEntries; i++) {
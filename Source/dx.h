@@ -21,6 +21,8 @@ void InitPalette();
 void BltFast(SDL_Rect *srcRect, SDL_Rect *dstRect);
 void Blit(SDL_Surface *src, SDL_Rect *srcRect, SDL_Rect *dstRect);
 void RenderPresent();
+/** @brief Makes the next `RenderPresent` upload the whole output surface instead of the blitted parts. */
+void InvalidateOutputSurface();
 void PaletteGetEntries(int dwNumEntries, SDL_Color *lpEntries);
 
 } // namespace devilution
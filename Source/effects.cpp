@@ -5,6 +5,10 @@
  */
 #include "effects.h"
 
+#include <string>
+#include <vector>
+
+#include "engine/assets.hpp"
 #include "engine/random.hpp"
 #include "init.h"
 #include "player.h"
@@ -1216,12 +1220,23 @@ void InitMonsterSND(int monst)
 	}
 
 	const int mtype = LevelMonsterTypes[monst].mtype;
+	std::vector<std::string> paths;
 	for (int i = 0; i < 4; i++) {
 		if (MonstSndChar[i] != 's' || MonstersData[mtype].snd_special) {
 			for (int j = 0; j < 2; j++) {
 				char path[MAX_PATH];
 				sprintf(path, MonstersData[mtype].sndfile, MonstSndChar[i], j + 1);
-				LevelMonsterTypes[monst].Snds[i][j] = sound_file_load(path);
+				paths.emplace_back(path);
+			}
+		}
+	}
+	PreloadAssets(paths);
+
+	size_t pathIndex = 0;
+	for (int i = 0; i < 4; i++) {
+		if (MonstSndChar[i] != 's' || MonstersData[mtype].snd_special) {
+			for (int j = 0; j < 2; j++) {
+				LevelMonsterTypes[monst].Snds[i][j] = sound_file_load(paths[pathIndex++].c_str());
 			}
 		}
 	}
@@ -1240,6 +1255,8 @@ void FreeMonsterSnd()
 			}
 		}
 	}
+	// Voices that played the freed sounds would keep their decoded audio alive
+	ReleaseIdleVoices();
 }
 
 bool CalculateSoundPosition(Point soundPosition, int *plVolume, int *plPan)
@@ -1291,6 +1308,7 @@ void sound_stop()
 	for (auto &sfx : sgSFX) {
 		if (sfx.pSnd != nullptr && sfx.pSnd->DSB.IsLoaded()) {
 			sfx.pSnd->DSB.Stop();
+			sfx.pSnd->DSB.ReleaseDecodedAudio();
 		}
 	}
 }
@@ -1,55 +1,105 @@
 #include "engine/assets.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "init.h"
 #include "mpq/mpq_sdl_rwops.hpp"
 #include "utils/file_util.h"
 #include "utils/log.hpp"
 #include "utils/paths.h"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/stdcompat/cstddef.hpp"
+#include "utils/task_pool.hpp"
 
 namespace devilution {
 
 namespace {
 
-bool OpenMpqFile(const char *filename, MpqArchive **archive, uint32_t *fileNumber)
+bool OpenMpqFile(const char *filename, bool hellfire, MpqArchive **archive, uint32_t *fileNumber)
 {
 	const MpqArchive::FileHash fileHash = MpqArchive::CalculateFileHash(filename);
-	const auto at = [=](std::optional<MpqArchive> &src) -> bool {
-		if (src && src->GetFileNumber(fileHash, *fileNumber)) {
-			*archive = &(*src);
+	for (std::optional<MpqArchive> *src : GetMpqSearchOrder(hellfire)) {
+		if (*src && (*src)->GetFileNumber(fileHash, *fileNumber)) {
+			*archive = &(**src);
 			return true;
 		}
-		return false;
+	}
+	return false;
+}
+
+/** Where an asset was found the first time it was opened. */
+struct AssetLocation {
+	enum class Source : uint8_t {
+		/** The asset does not exist */
+		None,
+		/** A file on disk, stored in `path` */
+		File,
+		/** A file in one of the MPQ archives */
+		Mpq,
 	};
 
-	return at(font_mpq) || at(lang_mpq) || at(devilutionx_mpq)
-	    || (gbIsHellfire && (at(hfvoice_mpq) || at(hfmusic_mpq) || at(hfbarb_mpq) || at(hfbard_mpq) || at(hfmonk_mpq) || at(hellfire_mpq))) || at(spawn_mpq) || at(diabdat_mpq);
-}
+	Source source = Source::None;
+	MpqArchive *archive = nullptr;
+	uint32_t fileNumber = 0;
+	std::string path;
+};
 
-} // namespace
+/**
+ * @brief Locations of the assets that have been opened so far, by the name they were requested with.
+ *
+ * The archives searched depend on gbIsHellfire, so there is one index for each value.
+ * MPQ archives don't list their contents, so the index is filled in as assets are opened
+ * instead of up front. After that opening an asset again costs one lookup instead of
+ * probing the file system and every archive.
+ */
+std::array<std::unordered_map<std::string, AssetLocation>, 2> AssetIndex;
+SdlMutex AssetIndexMutex;
 
-SDL_RWops *OpenAsset(const char *filename, bool threadsafe)
+bool FindIndexedAsset(const char *filename, bool hellfire, AssetLocation &location)
 {
-	std::string relativePath = filename;
-#ifndef _WIN32
-	std::replace(relativePath.begin(), relativePath.end(), '\\', '/');
-#endif
+	const std::lock_guard<SdlMutex> lock(AssetIndexMutex);
+	const auto &index = AssetIndex[hellfire ? 1 : 0];
+	const auto it = index.find(filename);
+	if (it == index.end())
+		return false;
+	location = it->second;
+	return true;
+}
 
-	if (relativePath[0] == '/')
-		return SDL_RWFromFile(relativePath.c_str(), "rb");
+void AddIndexedAsset(const char *filename, bool hellfire, AssetLocation location)
+{
+	const std::lock_guard<SdlMutex> lock(AssetIndexMutex);
+	AssetIndex[hellfire ? 1 : 0].emplace(filename, std::move(location));
+}
 
+/**
+ * @brief Searches the same places as before the index existed and opens the asset if it is found.
+ */
+SDL_RWops *OpenUnindexedAsset(const char *filename, const std::string &relativePath, bool threadsafe, bool hellfire, AssetLocation &location)
+{
 	SDL_RWops *rwops;
 
 	// SDL always logs an error in Debug mode.
 	// We check the file presence in Debug mode to avoid this.
 	const bool isDebug = SDL_LOG_PRIORITY_DEBUG >= SDL_LogGetPriority(SDL_LOG_CATEGORY_APPLICATION);
 
-	const auto loadFile = [&rwops, isDebug](const std::string &path) {
-		return (!isDebug || FileExists(path.c_str()))
-		    && (rwops = SDL_RWFromFile(path.c_str(), "rb")) != nullptr;
+	const auto loadFile = [&rwops, &location, isDebug](const std::string &path) {
+		if ((isDebug && !FileExists(path.c_str()))
+		    || (rwops = SDL_RWFromFile(path.c_str(), "rb")) == nullptr)
+			return false;
+		location.source = AssetLocation::Source::File;
+		location.path = path;
+		return true;
 	};
 
 	// Files in the `PrefPath()` directory can override MPQ contents.
@@ -62,10 +112,10 @@ SDL_RWops *OpenAsset(const char *filename, bool threadsafe)
 	}
 
 	// Load from all the MPQ archives.
-	MpqArchive *archive;
-	uint32_t fileNumber;
-	if (OpenMpqFile(filename, &archive, &fileNumber))
-		return SDL_RWops_FromMpqFile(*archive, fileNumber, filename, threadsafe);
+	if (OpenMpqFile(filename, hellfire, &location.archive, &location.fileNumber)) {
+		location.source = AssetLocation::Source::Mpq;
+		return SDL_RWops_FromMpqFile(*location.archive, location.fileNumber, filename, threadsafe);
+	}
 
 	// Load from the `/assets` directory next to the devilutionx binary.
 	if (loadFile(paths::AssetsPath() + relativePath))
@@ -74,11 +124,284 @@ SDL_RWops *OpenAsset(const char *filename, bool threadsafe)
 #if defined(__ANDROID__) || defined(__APPLE__)
 	// Fall back to the bundled assets on supported systems.
 	// This is handled by SDL when we pass a relative path.
-	if (!paths::AssetsPath().empty() && (rwops = SDL_RWFromFile(relativePath.c_str(), "rb")))
+	if (!paths::AssetsPath().empty() && (rwops = SDL_RWFromFile(relativePath.c_str(), "rb"))) {
+		location.source = AssetLocation::Source::File;
+		location.path = relativePath;
 		return rwops;
+	}
 #endif
 
 	return nullptr;
 }
 
+/**
+ * @brief Opens an asset from disk or the MPQ archives.
+ * @param hellfire Whether to search the Hellfire archives, passed in as gbIsHellfire may change while preloading
+ */
+SDL_RWops *OpenAssetFromSources(const char *filename, bool threadsafe, bool hellfire)
+{
+	std::string relativePath = filename;
+#ifndef _WIN32
+	std::replace(relativePath.begin(), relativePath.end(), '\\', '/');
+#endif
+
+	if (relativePath[0] == '/')
+		return SDL_RWFromFile(relativePath.c_str(), "rb");
+
+	AssetLocation location;
+	if (FindIndexedAsset(filename, hellfire, location)) {
+		switch (location.source) {
+		case AssetLocation::Source::File:
+			return SDL_RWFromFile(location.path.c_str(), "rb");
+		case AssetLocation::Source::Mpq:
+			return SDL_RWops_FromMpqFile(*location.archive, location.fileNumber, filename, threadsafe);
+		case AssetLocation::Source::None:
+			return nullptr;
+		}
+	}
+
+	SDL_RWops *rwops = OpenUnindexedAsset(filename, relativePath, threadsafe, hellfire, location);
+	AddIndexedAsset(filename, hellfire, std::move(location));
+	return rwops;
+}
+
+/** The contents of an asset read ahead on a worker thread. */
+struct PreloadedAsset {
+	bool done = false;
+	/** nullptr if the asset could not be read */
+	std::unique_ptr<byte[]> data;
+	std::size_t size = 0;
+	/** Read ahead by PrefetchAssets, may be dropped again to stay within PrefetchBudget */
+	bool speculative = false;
+	/** Position in PrefetchOrder, only valid for speculative assets */
+	std::list<std::string>::iterator lruPosition;
+};
+
+/** Assets that are being or have been read ahead and were not opened yet, by the name they were requested with. */
+std::unordered_map<std::string, PreloadedAsset> PreloadedAssets;
+/** Names of the speculative assets, least recently requested first */
+std::list<std::string> PrefetchOrder;
+/** Total size of the speculative assets that have been read */
+std::size_t PrefetchedBytes;
+/** Enough for the tilesets behind a few nearby entrances */
+std::size_t PrefetchBudget = 16 * 1024 * 1024;
+SdlMutex PreloadMutex;
+SdlCond PreloadDone;
+std::unique_ptr<TaskPool> PreloadPool;
+
+TaskPool *GetPreloadPool()
+{
+	if (PreloadPool == nullptr) {
+		const int numCpus = SDL_GetCPUCount();
+		if (numCpus <= 1)
+			return nullptr;
+		// The main thread keeps running the code that consumes the assets.
+		PreloadPool = std::make_unique<TaskPool>(numCpus - 1);
+	}
+	return PreloadPool.get();
+}
+
+/**
+ * @brief Makes a speculative asset a regular preloaded one that is kept until it is opened.
+ *
+ * Has to be called with PreloadMutex held.
+ */
+void KeepPreloadedAsset(PreloadedAsset &asset)
+{
+	if (!asset.speculative)
+		return;
+	PrefetchOrder.erase(asset.lruPosition);
+	if (asset.done)
+		PrefetchedBytes -= asset.size;
+	asset.speculative = false;
+}
+
+/**
+ * @brief Drops the least recently requested speculative assets that have been read until PrefetchBudget is met.
+ *
+ * Has to be called with PreloadMutex held.
+ */
+void EvictPrefetchedAssets()
+{
+	auto it = PrefetchOrder.begin();
+	while (PrefetchedBytes > PrefetchBudget && it != PrefetchOrder.end()) {
+		auto asset = PreloadedAssets.find(*it);
+		if (!asset->second.done) {
+			++it;
+			continue;
+		}
+		PrefetchedBytes -= asset->second.size;
+		it = PrefetchOrder.erase(it);
+		PreloadedAssets.erase(asset);
+	}
+}
+
+void PreloadAsset(const std::string &filename, bool hellfire)
+{
+	std::unique_ptr<byte[]> data;
+	std::size_t size = 0;
+	SDL_RWops *handle = OpenAssetFromSources(filename.c_str(), /*threadsafe=*/true, hellfire);
+	if (handle != nullptr) {
+		// A failed size query returns -1, which must not turn into a huge allocation
+		const Sint64 fileSize = SDL_RWsize(handle);
+		if (fileSize > 0) {
+			size = static_cast<std::size_t>(fileSize);
+			data = std::unique_ptr<byte[]> { new byte[size] };
+			if (SDL_RWread(handle, data.get(), size, 1) != 1)
+				data = nullptr;
+		}
+		SDL_RWclose(handle);
+	}
+	if (data == nullptr)
+		size = 0;
+
+	const std::lock_guard<SdlMutex> lock(PreloadMutex);
+	PreloadedAsset &asset = PreloadedAssets[filename];
+	asset.data = std::move(data);
+	asset.size = size;
+	asset.done = true;
+	if (asset.speculative) {
+		PrefetchedBytes += size;
+		EvictPrefetchedAssets();
+	}
+	PreloadDone.broadcast();
+}
+
+extern "C" {
+
+static int SDLCALL CloseOwnedMemory(SDL_RWops *context)
+{
+	delete[] reinterpret_cast<byte *>(const_cast<Uint8 *>(context->hidden.mem.base));
+	SDL_FreeRW(context);
+	return 0;
+}
+
+} // extern "C"
+
+/**
+ * @brief Hands out the data of a preloaded asset, waiting for it to be read if needed.
+ * @return nullptr if the asset was not preloaded or could not be read
+ */
+SDL_RWops *OpenPreloadedAsset(const char *filename)
+{
+	std::unique_ptr<byte[]> data;
+	std::size_t size;
+	{
+		std::lock_guard<SdlMutex> lock(PreloadMutex);
+		if (PreloadedAssets.empty())
+			return nullptr;
+		auto it = PreloadedAssets.find(filename);
+		if (it == PreloadedAssets.end())
+			return nullptr;
+		// Keep the asset from being evicted while waiting for it
+		KeepPreloadedAsset(it->second);
+		while (!it->second.done) {
+			PreloadDone.wait(PreloadMutex);
+			it = PreloadedAssets.find(filename);
+		}
+		data = std::move(it->second.data);
+		size = it->second.size;
+		PreloadedAssets.erase(it);
+	}
+	if (data == nullptr)
+		return nullptr;
+
+	SDL_RWops *rwops = SDL_RWFromConstMem(data.get(), static_cast<int>(size));
+	if (rwops == nullptr)
+		return nullptr;
+	rwops->close = &CloseOwnedMemory;
+	data.release();
+	return rwops;
+}
+
+} // namespace
+
+MpqSearchOrder GetMpqSearchOrder(bool hellfire)
+{
+	static const std::array<std::optional<MpqArchive> *, 5> DiabloOrder { &font_mpq, &lang_mpq, &devilutionx_mpq, &spawn_mpq, &diabdat_mpq };
+	static const std::array<std::optional<MpqArchive> *, 11> HellfireOrder { &font_mpq, &lang_mpq, &devilutionx_mpq, &hfvoice_mpq, &hfmusic_mpq, &hfbarb_mpq, &hfbard_mpq, &hfmonk_mpq, &hellfire_mpq, &spawn_mpq, &diabdat_mpq };
+	if (!hellfire)
+		return DiabloOrder;
+	return HellfireOrder;
+}
+
+SDL_RWops *OpenAsset(const char *filename, bool threadsafe)
+{
+	SDL_RWops *rwops = OpenPreloadedAsset(filename);
+	if (rwops != nullptr)
+		return rwops;
+	return OpenAssetFromSources(filename, threadsafe, gbIsHellfire);
+}
+
+void PreloadAssets(const std::vector<std::string> &filenames)
+{
+	TaskPool *pool = GetPreloadPool();
+	if (pool == nullptr)
+		return;
+
+	const bool hellfire = gbIsHellfire;
+	const std::lock_guard<SdlMutex> lock(PreloadMutex);
+	for (const std::string &filename : filenames) {
+		auto inserted = PreloadedAssets.emplace(filename, PreloadedAsset {});
+		if (!inserted.second) {
+			KeepPreloadedAsset(inserted.first->second);
+			continue;
+		}
+		pool->Submit([filename, hellfire]() { PreloadAsset(filename, hellfire); });
+	}
+}
+
+void PrefetchAssets(const std::vector<std::string> &filenames)
+{
+	TaskPool *pool = GetPreloadPool();
+	if (pool == nullptr)
+		return;
+
+	const bool hellfire = gbIsHellfire;
+	const std::lock_guard<SdlMutex> lock(PreloadMutex);
+	for (const std::string &filename : filenames) {
+		auto inserted = PreloadedAssets.emplace(filename, PreloadedAsset {});
+		PreloadedAsset &asset = inserted.first->second;
+		if (!inserted.second) {
+			if (asset.speculative)
+				PrefetchOrder.splice(PrefetchOrder.end(), PrefetchOrder, asset.lruPosition);
+			continue;
+		}
+		asset.speculative = true;
+		asset.lruPosition = PrefetchOrder.insert(PrefetchOrder.end(), filename);
+		pool->Submit([filename, hellfire]() { PreloadAsset(filename, hellfire); });
+	}
+}
+
+std::size_t SetPrefetchBudget(std::size_t bytes)
+{
+	const std::lock_guard<SdlMutex> lock(PreloadMutex);
+	const std::size_t previous = PrefetchBudget;
+	PrefetchBudget = bytes;
+	EvictPrefetchedAssets();
+	return previous;
+}
+
+void WaitForPreloadedAssets()
+{
+	if (PreloadPool != nullptr)
+		PreloadPool->Wait();
+}
+
+void ClearPreloadedAssets()
+{
+	WaitForPreloadedAssets();
+	const std::lock_guard<SdlMutex> lock(PreloadMutex);
+	PreloadedAssets.clear();
+	PrefetchOrder.clear();
+	PrefetchedBytes = 0;
+}
+
+void InvalidateAssetIndex()
+{
+	const std::lock_guard<SdlMutex> lock(AssetIndexMutex);
+	for (auto &index : AssetIndex)
+		index.clear();
+}
+
 } // namespace devilution
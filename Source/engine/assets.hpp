@@ -1,14 +1,96 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
 #include <SDL.h>
 
+#include "utils/stdcompat/optional.hpp"
+
 namespace devilution {
 
+class MpqArchive;
+
 /**
  * @brief Opens a Storm file and creates a read-only SDL_RWops from its handle.
  *
  * Closes the handle when it gets closed.
+ *
+ * Where an asset was found is remembered, so opening it again skips the search.
  */
 SDL_RWops *OpenAsset(const char *filename, bool threadsafe = false);
 
+/**
+ * @brief A view of one of the fixed MPQ search orders.
+ */
+class MpqSearchOrder {
+public:
+	template <std::size_t N>
+	constexpr MpqSearchOrder(const std::array<std::optional<MpqArchive> *, N> &archives)
+	    : begin_(archives.data())
+	    , end_(archives.data() + N)
+	{
+	}
+
+	[[nodiscard]] std::optional<MpqArchive> *const *begin() const
+	{
+		return begin_;
+	}
+
+	[[nodiscard]] std::optional<MpqArchive> *const *end() const
+	{
+		return end_;
+	}
+
+private:
+	std::optional<MpqArchive> *const *begin_;
+	std::optional<MpqArchive> *const *end_;
+};
+
+/**
+ * @brief The MPQ archives in the order they are searched for an asset, the first one containing it is used.
+ */
+MpqSearchOrder GetMpqSearchOrder(bool hellfire);
+
+/**
+ * @brief Forgets where assets were found, has to be called whenever the MPQ archives or asset paths change.
+ */
+void InvalidateAssetIndex();
+
+/**
+ * @brief Starts reading the given assets on worker threads.
+ *
+ * The next OpenAsset of one of the names returns the data that was read ahead, waiting for it
+ * if needed, so callers keep opening assets in the same order as without preloading.
+ * Does nothing on single core systems.
+ */
+void PreloadAssets(const std::vector<std::string> &filenames);
+
+/**
+ * @brief Starts reading assets that will likely be needed soon on worker threads.
+ *
+ * Works like PreloadAssets, except that the assets are kept in a bounded cache where the least
+ * recently requested ones are dropped first. Requesting an asset again marks it as recently used,
+ * a later PreloadAssets of the same name keeps it until it is opened.
+ */
+void PrefetchAssets(const std::vector<std::string> &filenames);
+
+/**
+ * @brief Sets how many bytes of prefetched assets are kept, dropping the least recently requested ones that don't fit.
+ * @return The previous budget
+ */
+std::size_t SetPrefetchBudget(std::size_t bytes);
+
+/**
+ * @brief Blocks until every asset that is being preloaded or prefetched has been read.
+ */
+void WaitForPreloadedAssets();
+
+/**
+ * @brief Waits for outstanding preloads and frees the assets that were preloaded but never opened.
+ */
+void ClearPreloadedAssets();
+
 } // namespace devilution
@@ -0,0 +1,99 @@
+#include "engine/benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <fmt/format.h>
+
+namespace devilution {
+
+BenchmarkRecorder *ActiveBenchmark = nullptr;
+
+namespace {
+
+double ToMilliseconds(BenchmarkRecorder::Clock::duration time)
+{
+	return std::chrono::duration<double, std::milli>(time).count();
+}
+
+double Percentile(const std::vector<double> &sorted, double percent)
+{
+	const auto rank = static_cast<std::size_t>(std::ceil(percent / 100.0 * sorted.size()));
+	return sorted[std::max<std::size_t>(rank, 1) - 1];
+}
+
+void AppendSummary(std::string &out, const TimingSummary &summary)
+{
+	out += fmt::format(R"({{"count": {}, "meanMs": {:.4f}, "p50Ms": {:.4f}, "p95Ms": {:.4f}, "p99Ms": {:.4f}, "maxMs": {:.4f}}})",
+	    summary.count, summary.meanMs, summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.maxMs);
+}
+
+} // namespace
+
+TimingSummary SummarizeTimings(std::vector<double> samplesMs)
+{
+	TimingSummary summary {};
+	summary.count = samplesMs.size();
+	if (samplesMs.empty())
+		return summary;
+
+	std::sort(samplesMs.begin(), samplesMs.end());
+	double total = 0;
+	for (double sample : samplesMs)
+		total += sample;
+	summary.meanMs = total / samplesMs.size();
+	summary.p50Ms = Percentile(samplesMs, 50);
+	summary.p95Ms = Percentile(samplesMs, 95);
+	summary.p99Ms = Percentile(samplesMs, 99);
+	summary.maxMs = samplesMs.back();
+	return summary;
+}
+
+void BenchmarkRecorder::BeginFrame()
+{
+	frameStart_ = Clock::now();
+}
+
+void BenchmarkRecorder::EndFrame()
+{
+	frameTimesMs_.push_back(ToMilliseconds(Clock::now() - frameStart_));
+	for (Section &section : sections_) {
+		if (!section.ranThisFrame)
+			continue;
+		section.samplesMs.push_back(section.currentFrameMs);
+		section.currentFrameMs = 0;
+		section.ranThisFrame = false;
+	}
+}
+
+void BenchmarkRecorder::AddSectionTime(const char *name, Clock::duration time)
+{
+	auto it = std::find_if(sections_.begin(), sections_.end(), [name](const Section &section) {
+		return strcmp(section.name, name) == 0;
+	});
+	if (it == sections_.end())
+		it = sections_.insert(sections_.end(), Section { name, {}, 0, false });
+	it->currentFrameMs += ToMilliseconds(time);
+	it->ranThisFrame = true;
+}
+
+std::string BenchmarkRecorder::ToJson() const
+{
+	std::string out = "{\n";
+	out += fmt::format("  \"frames\": {},\n", frameTimesMs_.size());
+	out += "  \"frame\": ";
+	AppendSummary(out, SummarizeTimings(frameTimesMs_));
+	out += ",\n  \"sections\": {";
+	for (std::size_t i = 0; i < sections_.size(); i++) {
+		out += fmt::format("{}\n    \"{}\": ", i == 0 ? "" : ",", sections_[i].name);
+		AppendSummary(out, SummarizeTimings(sections_[i].samplesMs));
+	}
+	out += "\n  },\n  \"frameTimesMs\": [";
+	for (std::size_t i = 0; i < frameTimesMs_.size(); i++)
+		out += fmt::format("{}{:.4f}", i == 0 ? "" : ", ", frameTimesMs_[i]);
+	out += "]\n}\n";
+	return out;
+}
+
+} // namespace devilution
@@ -0,0 +1,103 @@
+/**
+ * @file benchmark.hpp
+ *
+ * Collection of frame and section timings while benchmarking demo playback.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace devilution {
+
+struct TimingSummary {
+	std::size_t count;
+	double meanMs;
+	double p50Ms;
+	double p95Ms;
+	double p99Ms;
+	double maxMs;
+};
+
+/**
+ * @brief Computes the mean and the nearest-rank percentiles of the given timings.
+ */
+TimingSummary SummarizeTimings(std::vector<double> samplesMs);
+
+class BenchmarkRecorder {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	void BeginFrame();
+	void EndFrame();
+
+	/**
+	 * @brief Adds time spent in a section to the current frame.
+	 * @param name Name of the section, must outlive the recorder
+	 */
+	void AddSectionTime(const char *name, Clock::duration time);
+
+	[[nodiscard]] std::size_t FrameCount() const
+	{
+		return frameTimesMs_.size();
+	}
+
+	/**
+	 * @brief Returns the summaries of the frame and section timings and the time of every frame as JSON.
+	 *
+	 * Sections are summarized over the frames they ran in.
+	 */
+	[[nodiscard]] std::string ToJson() const;
+
+private:
+	struct Section {
+		const char *name;
+		std::vector<double> samplesMs;
+		double currentFrameMs;
+		bool ranThisFrame;
+	};
+
+	std::vector<Section> sections_;
+	std::vector<double> frameTimesMs_;
+	Clock::time_point frameStart_;
+};
+
+/** The benchmark that is being recorded, nullptr unless a demo is benchmarked. */
+extern BenchmarkRecorder *ActiveBenchmark;
+
+/**
+ * @brief Adds the time until the end of the scope to a section of the active benchmark.
+ */
+class BenchmarkSection {
+public:
+	explicit BenchmarkSection(const char *name)
+	    : name_(name)
+	{
+		if (ActiveBenchmark != nullptr)
+			start_ = BenchmarkRecorder::Clock::now();
+	}
+
+	~BenchmarkSection()
+	{
+		if (ActiveBenchmark != nullptr)
+			ActiveBenchmark->AddSectionTime(name_, BenchmarkRecorder::Clock::now() - start_);
+	}
+
+	BenchmarkSection(const BenchmarkSection &) = delete;
+	BenchmarkSection &operator=(const BenchmarkSection &) = delete;
+
+private:
+	const char *name_;
+	BenchmarkRecorder::Clock::time_point start_;
+};
+
+template <typename F>
+void RunBenchmarkSection(const char *name, F &&fn)
+{
+	BenchmarkSection section(name);
+	fn();
+}
+
+} // namespace devilution
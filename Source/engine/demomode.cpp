@@ -1,15 +1,23 @@
-#include <deque>
+#include <array>
+#include <cstring>
 #include <fstream>
-#include <iostream>
+#include <optional>
 #include <sstream>
 
 #include "controls/plrctrls.h"
 #include "demomode.h"
+#include "engine/benchmark.hpp"
+#include "engine/random.hpp"
 #include "menu.h"
+#include "missiles.h"
+#include "monster.h"
 #include "nthread.h"
 #include "options.h"
 #include "pfile.h"
+#include "player.h"
 #include "utils/display.h"
+#include "utils/endian.hpp"
+#include "utils/log.hpp"
 #include "utils/paths.h"
 
 namespace devilution {
@@ -20,6 +28,8 @@ enum class DemoMsgType {
 	GameTick = 0,
 	Rendering = 1,
 	Message = 2,
+	/** Checksum of the game state before a game tick, only present in binary demos. */
+	Checksum = 3,
 };
 
 struct demoMsg {
@@ -28,15 +38,36 @@ struct demoMsg {
 	int32_t wParam;
 	int32_t lParam;
 	float progressToNextGameTick;
+	uint32_t tick;
+	uint32_t checksum;
 };
 
+/**
+ * Binary demos start with this signature followed by the format version.
+ * CSV demos start with their version number as text instead.
+ */
+constexpr std::array<char, 3> BinaryDemoSignature { 'D', 'M', 'O' };
+constexpr uint8_t BinaryDemoVersion = 1;
+
+/** Number of game ticks between two game state checksums in recorded demos. */
+constexpr uint16_t RecordChecksumInterval = 20;
+
 int DemoNumber = -1;
 bool Timedemo = false;
+std::string BenchmarkReport;
+std::optional<BenchmarkRecorder> Benchmark;
 int RecordNumber = -1;
 bool CreateDemoReference = false;
 
 std::ofstream DemoRecording;
-std::deque<demoMsg> Demo_Message_Queue;
+uint32_t RecordedTicks = 0;
+
+std::ifstream DemoFile;
+bool DemoFileIsBinary = false;
+/** Message that has been read from the demo file but not processed yet. */
+std::optional<demoMsg> PendingDemoMessage;
+/** Tick at which the game state first differed from the recording. */
+std::optional<uint32_t> DivergedTick;
 uint32_t DemoModeLastTick = 0;
 
 int LogicTick = 0;
@@ -45,30 +76,179 @@ int StartTime = 0;
 int DemoGraphicsWidth = 640;
 int DemoGraphicsHeight = 480;
 
-void PumpDemoMessage(DemoMsgType demoMsgType, uint32_t message, int32_t wParam, int32_t lParam, float progressToNextGameTick)
+void WriteLE16(std::ostream &out, uint16_t value)
 {
-	demoMsg msg;
-	msg.type = demoMsgType;
-	msg.message = message;
-	msg.wParam = wParam;
-	msg.lParam = lParam;
-	msg.progressToNextGameTick = progressToNextGameTick;
-
-	Demo_Message_Queue.push_back(msg);
+	const char bytes[] = { static_cast<char>(value), static_cast<char>(value >> 8) };
+	out.write(bytes, sizeof(bytes));
 }
 
-bool LoadDemoMessages(int i)
+void WriteLE32(std::ostream &out, uint32_t value)
 {
-	std::ifstream demofile;
-	char demoFilename[16];
-	snprintf(demoFilename, 15, "demo_%d.dmo", i);
-	demofile.open(paths::PrefPath() + demoFilename);
-	if (!demofile.is_open()) {
+	const char bytes[] = { static_cast<char>(value), static_cast<char>(value >> 8), static_cast<char>(value >> 16), static_cast<char>(value >> 24) };
+	out.write(bytes, sizeof(bytes));
+}
+
+void WriteFloat(std::ostream &out, float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	WriteLE32(out, bits);
+}
+
+float LoadFloat(const uint8_t *b)
+{
+	const uint32_t bits = LoadLE32(b);
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/**
+ * @brief FNV-1a hash of the parts of the game state that any desync affects sooner or later.
+ */
+uint32_t ComputeGameStateChecksum()
+{
+	uint32_t hash = 2166136261U;
+	const auto add = [&hash](uint32_t value) {
+		for (int i = 0; i < 4; i++) {
+			hash ^= (value >> (i * 8)) & 0xFF;
+			hash *= 16777619U;
+		}
+	};
+
+	add(GetLCGEngineState());
+	add(currlevel);
+	for (const Player &player : Players) {
+		if (!player.plractive)
+			continue;
+		add(player.position.tile.x);
+		add(player.position.tile.y);
+		add(player._pmode);
+		add(player._pHitPoints);
+		add(player._pMana);
+		add(player._pExperience);
+		add(player._pGold);
+	}
+	add(ActiveMonsterCount);
+	for (int i = 0; i < ActiveMonsterCount; i++) {
+		const Monster &monster = Monsters[ActiveMonsters[i]];
+		add(ActiveMonsters[i]);
+		add(monster.position.tile.x);
+		add(monster.position.tile.y);
+		add(static_cast<uint32_t>(monster._mmode));
+		add(monster._mhitpoints);
+	}
+	add(static_cast<uint32_t>(Missiles.size()));
+	return hash;
+}
+
+bool ReadBinaryDemoMessage(demoMsg &msg)
+{
+	std::array<uint8_t, 17> record;
+	if (!DemoFile.read(reinterpret_cast<char *>(record.data()), 1))
+		return false;
+
+	msg.type = static_cast<DemoMsgType>(record[0]);
+	size_t size;
+	switch (msg.type) {
+	case DemoMsgType::GameTick:
+	case DemoMsgType::Rendering:
+		size = 4;
+		break;
+	case DemoMsgType::Message:
+		size = 16;
+		break;
+	case DemoMsgType::Checksum:
+		size = 8;
+		break;
+	default:
+		LogError("Invalid demo message type {}", record[0]);
 		return false;
 	}
+	if (!DemoFile.read(reinterpret_cast<char *>(&record[1]), size))
+		return false;
+
+	if (msg.type == DemoMsgType::Checksum) {
+		msg.tick = LoadLE32(&record[1]);
+		msg.checksum = LoadLE32(&record[5]);
+		return true;
+	}
+	msg.progressToNextGameTick = LoadFloat(&record[1]);
+	if (msg.type == DemoMsgType::Message) {
+		msg.message = LoadLE32(&record[5]);
+		msg.wParam = static_cast<int32_t>(LoadLE32(&record[9]));
+		msg.lParam = static_cast<int32_t>(LoadLE32(&record[13]));
+	}
+	return true;
+}
+
+bool ReadCsvDemoMessage(demoMsg &msg)
+{
+	std::string line;
+	if (!std::getline(DemoFile, line) || line.empty() || line[0] == '\r')
+		return false;
+	std::stringstream command(line);
+
+	std::string number;
+	std::getline(command, number, ',');
+	msg.type = static_cast<DemoMsgType>(std::stoi(number));
+
+	std::getline(command, number, ',');
+	msg.progressToNextGameTick = std::stof(number);
+
+	if (msg.type == DemoMsgType::Message) {
+		std::getline(command, number, ',');
+		msg.message = std::stoi(number);
+		std::getline(command, number, ',');
+		msg.wParam = std::stoi(number);
+		std::getline(command, number, ',');
+		msg.lParam = std::stoi(number);
+	}
+	return true;
+}
+
+/**
+ * @brief Returns the next message of the demo without consuming it, reading it from the file if needed.
+ * @return nullptr at the end of the demo
+ */
+const demoMsg *PeekDemoMessage()
+{
+	if (!PendingDemoMessage) {
+		demoMsg msg {};
+		if (DemoFileIsBinary ? ReadBinaryDemoMessage(msg) : ReadCsvDemoMessage(msg))
+			PendingDemoMessage = msg;
+	}
+	return PendingDemoMessage ? &*PendingDemoMessage : nullptr;
+}
+
+void PopDemoMessage()
+{
+	PendingDemoMessage = std::nullopt;
+}
+
+void CloseDemo()
+{
+	DemoFile.close();
+	PendingDemoMessage = std::nullopt;
+}
+
+bool LoadBinaryDemoHeader()
+{
+	std::array<uint8_t, 10> header;
+	if (!DemoFile.read(reinterpret_cast<char *>(header.data()), header.size()))
+		return false;
+
+	gSaveNumber = static_cast<int>(LoadLE32(&header[0]));
+	DemoGraphicsWidth = LoadLE16(&header[4]);
+	DemoGraphicsHeight = LoadLE16(&header[6]);
+	// The checksum interval (header[8]) is informational, playback checks every checksum that is present.
+	return true;
+}
 
+bool LoadCsvDemoHeader()
+{
 	std::string line;
-	std::getline(demofile, line);
+	std::getline(DemoFile, line);
 	std::stringstream header(line);
 
 	std::string number;
@@ -86,51 +266,71 @@ bool LoadDemoMessages(int i)
 	std::getline(header, number, ',');
 	DemoGraphicsHeight = std::stoi(number);
 
-	while (std::getline(demofile, line)) {
-		std::stringstream command(line);
-
-		std::getline(command, number, ',');
-		int typeNum = std::stoi(number);
-		auto type = static_cast<DemoMsgType>(typeNum);
+	return true;
+}
 
-		std::getline(command, number, ',');
-		float progressToNextGameTick = std::stof(number);
-
-		switch (type) {
-		case DemoMsgType::Message: {
-			std::getline(command, number, ',');
-			uint32_t message = std::stoi(number);
-			std::getline(command, number, ',');
-			int32_t wParam = std::stoi(number);
-			std::getline(command, number, ',');
-			int32_t lParam = std::stoi(number);
-			PumpDemoMessage(type, message, wParam, lParam, progressToNextGameTick);
-			break;
-		}
-		default:
-			PumpDemoMessage(type, 0, 0, 0, progressToNextGameTick);
-			break;
-		}
+/**
+ * @brief Opens the demo and reads its header, messages are streamed from the file during playback.
+ */
+bool LoadDemo(int i)
+{
+	char demoFilename[16];
+	snprintf(demoFilename, 15, "demo_%d.dmo", i);
+	CloseDemo();
+	DivergedTick = std::nullopt;
+	DemoFile.open(paths::PrefPath() + demoFilename, std::fstream::binary);
+	if (!DemoFile.is_open()) {
+		return false;
 	}
 
-	demofile.close();
+	std::array<char, 4> signature;
+	DemoFileIsBinary = DemoFile.read(signature.data(), signature.size())
+	    && std::equal(BinaryDemoSignature.begin(), BinaryDemoSignature.end(), signature.begin());
+	if (DemoFileIsBinary) {
+		if (static_cast<uint8_t>(signature[3]) != BinaryDemoVersion || !LoadBinaryDemoHeader())
+			return false;
+	} else {
+		DemoFile.clear();
+		DemoFile.seekg(0);
+		if (!LoadCsvDemoHeader())
+			return false;
+	}
 
 	DemoModeLastTick = SDL_GetTicks();
 
 	return true;
 }
 
+/**
+ * @brief Checks the game state against the checksums recorded for the coming game tick.
+ * @return false if the game state differs from the recording
+ */
+bool VerifyDemoChecksums()
+{
+	for (const demoMsg *dmsg = PeekDemoMessage(); dmsg != nullptr && dmsg->type == DemoMsgType::Checksum; dmsg = PeekDemoMessage()) {
+		const uint32_t expected = dmsg->checksum;
+		const uint32_t tick = dmsg->tick;
+		PopDemoMessage();
+		if (ComputeGameStateChecksum() != expected) {
+			DivergedTick = tick;
+			return false;
+		}
+	}
+	return true;
+}
+
 } // namespace
 
 namespace demo {
 
-void InitPlayBack(int demoNumber, bool timedemo)
+void InitPlayBack(int demoNumber, bool timedemo, std::string benchmarkReport)
 {
 	DemoNumber = demoNumber;
 	Timedemo = timedemo;
+	BenchmarkReport = std::move(benchmarkReport);
 	ControlMode = ControlTypes::KeyboardAndMouse;
 
-	if (!LoadDemoMessages(demoNumber)) {
+	if (!LoadDemo(demoNumber)) {
 		SDL_Log("Unable to load demo file");
 		diablo_quit(1);
 	}
@@ -166,11 +366,24 @@ bool IsRecording()
 	return RecordNumber != -1;
 };
 
+std::optional<uint32_t> GetDivergedTick()
+{
+	return DivergedTick;
+}
+
 bool GetRunGameLoop(bool &drawGame, bool &processInput)
 {
-	if (Demo_Message_Queue.empty())
+	if (!VerifyDemoChecksums()) {
+		SDL_Log("Demo: Game state differs from the recording at game tick %u", *DivergedTick);
+		gbRunGame = false;
+		drawGame = false;
+		processInput = false;
+		return false;
+	}
+	const demoMsg *next = PeekDemoMessage();
+	if (next == nullptr)
 		app_fatal("Demo queue empty");
-	demoMsg dmsg = Demo_Message_Queue.front();
+	demoMsg dmsg = *next;
 	if (dmsg.type == DemoMsgType::Message)
 		app_fatal("Unexpected Message");
 	if (Timedemo) {
@@ -197,7 +410,7 @@ bool GetRunGameLoop(bool &drawGame, bool &processInput)
 		}
 	}
 	gfProgressToNextGameTick = dmsg.progressToNextGameTick;
-	Demo_Message_Queue.pop_front();
+	PopDemoMessage();
 	if (dmsg.type == DemoMsgType::GameTick)
 		LogicTick++;
 	return dmsg.type == DemoMsgType::GameTick;
@@ -214,7 +427,7 @@ bool FetchMessage(tagMSG *lpMsg)
 			return true;
 		}
 		if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE) {
-			Demo_Message_Queue.clear();
+			CloseDemo();
 			ClearMessageQueue();
 			DemoNumber = -1;
 			Timedemo = false;
@@ -232,16 +445,14 @@ bool FetchMessage(tagMSG *lpMsg)
 		}
 	}
 
-	if (!Demo_Message_Queue.empty()) {
-		demoMsg dmsg = Demo_Message_Queue.front();
-		if (dmsg.type == DemoMsgType::Message) {
-			lpMsg->message = dmsg.message;
-			lpMsg->lParam = dmsg.lParam;
-			lpMsg->wParam = dmsg.wParam;
-			gfProgressToNextGameTick = dmsg.progressToNextGameTick;
-			Demo_Message_Queue.pop_front();
-			return true;
-		}
+	const demoMsg *dmsg = PeekDemoMessage();
+	if (dmsg != nullptr && dmsg->type == DemoMsgType::Message) {
+		lpMsg->message = dmsg->message;
+		lpMsg->lParam = dmsg->lParam;
+		lpMsg->wParam = dmsg->wParam;
+		gfProgressToNextGameTick = dmsg->progressToNextGameTick;
+		PopDemoMessage();
+		return true;
 	}
 
 	lpMsg->message = 0;
@@ -253,14 +464,27 @@ bool FetchMessage(tagMSG *lpMsg)
 
 void RecordGameLoopResult(bool runGameLoop)
 {
-	DemoRecording << static_cast<uint32_t>(runGameLoop ? DemoMsgType::GameTick : DemoMsgType::Rendering) << "," << gfProgressToNextGameTick << "\n";
+	if (runGameLoop) {
+		if (RecordedTicks % RecordChecksumInterval == 0) {
+			DemoRecording.put(static_cast<char>(DemoMsgType::Checksum));
+			WriteLE32(DemoRecording, RecordedTicks);
+			WriteLE32(DemoRecording, ComputeGameStateChecksum());
+		}
+		RecordedTicks++;
+	}
+	DemoRecording.put(static_cast<char>(runGameLoop ? DemoMsgType::GameTick : DemoMsgType::Rendering));
+	WriteFloat(DemoRecording, gfProgressToNextGameTick);
 }
 
 void RecordMessage(tagMSG *lpMsg)
 {
 	if (!gbRunGame || !DemoRecording.is_open())
 		return;
-	DemoRecording << static_cast<uint32_t>(DemoMsgType::Message) << "," << gfProgressToNextGameTick << "," << lpMsg->message << "," << lpMsg->wParam << "," << lpMsg->lParam << "\n";
+	DemoRecording.put(static_cast<char>(DemoMsgType::Message));
+	WriteFloat(DemoRecording, gfProgressToNextGameTick);
+	WriteLE32(DemoRecording, lpMsg->message);
+	WriteLE32(DemoRecording, static_cast<uint32_t>(lpMsg->wParam));
+	WriteLE32(DemoRecording, static_cast<uint32_t>(lpMsg->lParam));
 }
 
 void NotifyGameLoopStart()
@@ -268,13 +492,23 @@ void NotifyGameLoopStart()
 	if (IsRecording()) {
 		char demoFilename[16];
 		snprintf(demoFilename, 15, "demo_%d.dmo", RecordNumber);
-		DemoRecording.open(paths::PrefPath() + demoFilename, std::fstream::trunc);
-		DemoRecording << "0," << gSaveNumber << "," << gnScreenWidth << "," << gnScreenHeight << "\n";
+		DemoRecording.open(paths::PrefPath() + demoFilename, std::fstream::trunc | std::fstream::binary);
+		DemoRecording.write(BinaryDemoSignature.data(), BinaryDemoSignature.size());
+		DemoRecording.put(static_cast<char>(BinaryDemoVersion));
+		WriteLE32(DemoRecording, static_cast<uint32_t>(gSaveNumber));
+		WriteLE16(DemoRecording, static_cast<uint16_t>(gnScreenWidth));
+		WriteLE16(DemoRecording, static_cast<uint16_t>(gnScreenHeight));
+		WriteLE16(DemoRecording, RecordChecksumInterval);
+		RecordedTicks = 0;
 	}
 
 	if (IsRunning()) {
 		StartTime = SDL_GetTicks();
 		LogicTick = 0;
+		if (!BenchmarkReport.empty()) {
+			Benchmark.emplace();
+			ActiveBenchmark = &*Benchmark;
+		}
 	}
 }
 
@@ -290,12 +524,26 @@ void NotifyGameLoopEnd()
 	}
 
 	if (IsRunning()) {
+		CloseDemo();
 		float secounds = (SDL_GetTicks() - StartTime) / 1000.0;
-		SDL_Log("%d frames, %.2f seconds: %.1f fps", LogicTick, secounds, LogicTick / secounds);
+		SDL_Log("%d frames, %.2f seconds: %.1f fps (%d render threads)", LogicTick, secounds, LogicTick / secounds, *sgOptions.Graphics.renderThreads);
 		gbRunGameResult = false;
 		gbRunGame = false;
 
-		HeroCompareResult compareResult = pfile_compare_hero_demo(DemoNumber);
+		if (Benchmark) {
+			ActiveBenchmark = nullptr;
+			std::ofstream report(BenchmarkReport, std::fstream::trunc);
+			report << Benchmark->ToJson();
+			report.close();
+			if (report.fail()) {
+				LogError("Failed to write benchmark report {}", BenchmarkReport);
+				diablo_quit(1);
+			}
+			SDL_Log("Benchmark: %u frames written to %s", static_cast<unsigned>(Benchmark->FrameCount()), BenchmarkReport.c_str());
+			Benchmark = std::nullopt;
+		}
+
+		HeroCompareResult compareResult = DivergedTick ? HeroCompareResult::Difference : pfile_compare_hero_demo(DemoNumber);
 		switch (compareResult) {
 		case HeroCompareResult::ReferenceNotFound:
 			SDL_Log("Timedemo: No final comparision cause reference is not present.");
@@ -305,6 +553,9 @@ void NotifyGameLoopEnd()
 			break;
 		case HeroCompareResult::Difference:
 			SDL_Log("Timedemo: Different outcome then inital run. ;(");
+			// The timings of a diverged replay aren't comparable, fail the benchmark run.
+			if (!BenchmarkReport.empty())
+				diablo_quit(1);
 			break;
 		}
 	}
@@ -5,18 +5,29 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <string>
+
 #include "miniwin/miniwin.h"
+#include "utils/stdcompat/optional.hpp"
 
 namespace devilution {
 
 namespace demo {
 
-void InitPlayBack(int demoNumber, bool timedemo);
+/**
+ * @param benchmarkReport If not empty, the playback is benchmarked and the timings are written to this file as JSON
+ */
+void InitPlayBack(int demoNumber, bool timedemo, std::string benchmarkReport = {});
 void InitRecording(int recordNumber, bool createDemoReference);
 void OverrideOptions();
 
 bool IsRunning();
 bool IsRecording();
+/**
+ * @brief Game tick at which the played back game state first differed from the recording.
+ */
+std::optional<uint32_t> GetDivergedTick();
 
 bool GetRunGameLoop(bool &drawGame, bool &processInput);
 bool FetchMessage(tagMSG *lpMsg);
@@ -0,0 +1,101 @@
+#include "engine/dirty_region.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace devilution {
+
+namespace {
+
+int Right(const Rectangle &rect)
+{
+	return rect.position.x + rect.size.width;
+}
+
+int Bottom(const Rectangle &rect)
+{
+	return rect.position.y + rect.size.height;
+}
+
+int Area(const Rectangle &rect)
+{
+	return rect.size.width * rect.size.height;
+}
+
+Rectangle Union(const Rectangle &a, const Rectangle &b)
+{
+	const int left = std::min(a.position.x, b.position.x);
+	const int top = std::min(a.position.y, b.position.y);
+	const int right = std::max(Right(a), Right(b));
+	const int bottom = std::max(Bottom(a), Bottom(b));
+	return { { left, top }, { right - left, bottom - top } };
+}
+
+/** @brief Whether the rectangles overlap or share an edge. */
+bool Touches(const Rectangle &a, const Rectangle &b)
+{
+	return a.position.x <= Right(b) && b.position.x <= Right(a)
+	    && a.position.y <= Bottom(b) && b.position.y <= Bottom(a);
+}
+
+/** @brief Number of pixels that are covered by the union of the rectangles but by neither of them. */
+int MergeCost(const Rectangle &a, const Rectangle &b)
+{
+	const int overlapWidth = std::max(0, std::min(Right(a), Right(b)) - std::max(a.position.x, b.position.x));
+	const int overlapHeight = std::max(0, std::min(Bottom(a), Bottom(b)) - std::max(a.position.y, b.position.y));
+	return Area(Union(a, b)) - (Area(a) + Area(b) - overlapWidth * overlapHeight);
+}
+
+} // namespace
+
+void DirtyRegion::Add(Rectangle rect)
+{
+	if (rect.size.width <= 0 || rect.size.height <= 0)
+		return;
+
+	// Merging can make the new rectangle touch ones that were checked before, so repeat until nothing changes.
+	bool merged = true;
+	while (merged) {
+		merged = false;
+		for (auto it = rects_.begin(); it != rects_.end(); ++it) {
+			if (Touches(*it, rect)) {
+				rect = Union(*it, rect);
+				rects_.erase(it);
+				merged = true;
+				break;
+			}
+		}
+	}
+	rects_.push_back(rect);
+
+	if (rects_.size() <= MaxRects)
+		return;
+
+	std::size_t bestA = 0;
+	std::size_t bestB = 1;
+	int bestCost = std::numeric_limits<int>::max();
+	for (std::size_t a = 0; a < rects_.size(); a++) {
+		for (std::size_t b = a + 1; b < rects_.size(); b++) {
+			const int cost = MergeCost(rects_[a], rects_[b]);
+			if (cost < bestCost) {
+				bestCost = cost;
+				bestA = a;
+				bestB = b;
+			}
+		}
+	}
+	const Rectangle combined = Union(rects_[bestA], rects_[bestB]);
+	rects_.erase(rects_.begin() + bestB);
+	rects_.erase(rects_.begin() + bestA);
+	Add(combined);
+}
+
+int DirtyRegion::Area() const
+{
+	int area = 0;
+	for (const Rectangle &rect : rects_)
+		area += devilution::Area(rect);
+	return area;
+}
+
+} // namespace devilution
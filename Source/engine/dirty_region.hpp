@@ -0,0 +1,55 @@
+/**
+ * @file dirty_region.hpp
+ *
+ * Tracking of the parts of a surface that need to be updated.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "engine/rectangle.hpp"
+
+namespace devilution {
+
+/**
+ * @brief A set of non-overlapping rectangles that covers every area added to it.
+ *
+ * Overlapping and touching rectangles are merged as they are added.
+ * Once there are more than `MaxRects` rectangles, the two rectangles
+ * that waste the least area when merged are combined.
+ */
+class DirtyRegion {
+public:
+	static constexpr std::size_t MaxRects = 16;
+
+	/**
+	 * @brief Adds an area to the region, empty rectangles are ignored.
+	 */
+	void Add(Rectangle rect);
+
+	void Clear()
+	{
+		rects_.clear();
+	}
+
+	[[nodiscard]] bool IsEmpty() const
+	{
+		return rects_.empty();
+	}
+
+	[[nodiscard]] const std::vector<Rectangle> &Rects() const
+	{
+		return rects_;
+	}
+
+	/**
+	 * @brief Total number of pixels covered by the region.
+	 */
+	[[nodiscard]] int Area() const;
+
+private:
+	std::vector<Rectangle> rects_;
+};
+
+} // namespace devilution
@@ -13,6 +13,21 @@
 #include "options.h"
 #include "utils/attributes.h"
 
+// Debugging variables
+// #define DEBUG_RENDER_COLOR
+// #define DEBUG_RENDER_OFFSET_X 5
+// #define DEBUG_RENDER_OFFSET_Y 5
+
+#ifndef DEBUG_RENDER_COLOR
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DUN_RENDER_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DUN_RENDER_NEON
+#endif
+#endif
+
 namespace devilution {
 
 namespace {
@@ -110,11 +125,6 @@ std::int_fast16_t GetTileHeight(TileType tile)
 	return Height;
 }
 
-// Debugging variables
-// #define DEBUG_RENDER_COLOR
-// #define DEBUG_RENDER_OFFSET_X 5
-// #define DEBUG_RENDER_OFFSET_Y 5
-
 #ifdef DEBUG_RENDER_COLOR
 int DBGCOLOR = 0;
 
@@ -452,7 +462,114 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLineBlended(std::uint8_t *dst, co
 #endif
 }
 
-template <TransparencyType Transparency, LightType Light>
+#if defined(DUN_RENDER_SSE2) || defined(DUN_RENDER_NEON)
+constexpr bool HasVectorizedBackend = true;
+
+#ifdef DUN_RENDER_SSE2
+using PixelVector = __m128i;
+
+/** Expands the 16 most significant bits of `mask` to 16 bytes of 0xFF (bit set) or 0x00 (bit not set). */
+DVL_ALWAYS_INLINE PixelVector ExpandMask16(std::uint32_t mask)
+{
+	const __m128i bits = _mm_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+	const __m128i bytes = _mm_unpacklo_epi64(
+	    _mm_set1_epi8(static_cast<char>(mask >> 24)),
+	    _mm_set1_epi8(static_cast<char>(mask >> 16)));
+	return _mm_cmpeq_epi8(_mm_and_si128(bytes, bits), bits);
+}
+
+DVL_ALWAYS_INLINE PixelVector LoadPixels(const std::uint8_t *src)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+}
+
+DVL_ALWAYS_INLINE PixelVector ZeroPixels()
+{
+	return _mm_setzero_si128();
+}
+
+/** Stores `pixels` to `dst` where `mask` is set, leaving the other pixels unchanged. */
+DVL_ALWAYS_INLINE void StorePixelsMasked(std::uint8_t *dst, PixelVector mask, PixelVector pixels)
+{
+	const __m128i old = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(_mm_and_si128(mask, pixels), _mm_andnot_si128(mask, old)));
+}
+#else
+using PixelVector = uint8x16_t;
+
+/** Expands the 16 most significant bits of `mask` to 16 bytes of 0xFF (bit set) or 0x00 (bit not set). */
+DVL_ALWAYS_INLINE PixelVector ExpandMask16(std::uint32_t mask)
+{
+	static const std::uint8_t Bits[16] = { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 };
+	const uint8x16_t bytes = vcombine_u8(
+	    vdup_n_u8(static_cast<std::uint8_t>(mask >> 24)),
+	    vdup_n_u8(static_cast<std::uint8_t>(mask >> 16)));
+	return vtstq_u8(bytes, vld1q_u8(Bits));
+}
+
+DVL_ALWAYS_INLINE PixelVector LoadPixels(const std::uint8_t *src)
+{
+	return vld1q_u8(src);
+}
+
+DVL_ALWAYS_INLINE PixelVector ZeroPixels()
+{
+	return vdupq_n_u8(0);
+}
+
+/** Stores `pixels` to `dst` where `mask` is set, leaving the other pixels unchanged. */
+DVL_ALWAYS_INLINE void StorePixelsMasked(std::uint8_t *dst, PixelVector mask, PixelVector pixels)
+{
+	vst1q_u8(dst, vbslq_u8(mask, pixels, vld1q_u8(dst)));
+}
+#endif
+
+/**
+ * @brief Vectorized variant of `RenderLineBlended`.
+ *
+ * Opaque pixels are written 16 at a time with a masked store, only the pixels that need
+ * a `paletteTransparencyLookup` are visited one by one.
+ *
+ * @param mask Opacity mask, with all bits past `n` cleared.
+ */
+template <LightType Light>
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLineBlendedVectorized(std::uint8_t *dst, const std::uint8_t *src, std::uint_fast8_t n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	const std::uint32_t firstNOnes = std::uint32_t(-1) << ((sizeof(std::uint32_t) * CHAR_BIT) - n);
+	if (Light == LightType::FullyDark) {
+		ForEachSetBit(~mask & firstNOnes, [dst](int i) { dst[i] = paletteTransparencyLookup[0][dst[i]]; });
+	} else if (Light == LightType::FullyLit) {
+		ForEachSetBit(~mask & firstNOnes, [dst, src](int i) { dst[i] = paletteTransparencyLookup[dst[i]][src[i]]; });
+	} else { // Partially lit
+		ForEachSetBit(~mask & firstNOnes, [dst, src, tbl](int i) { dst[i] = paletteTransparencyLookup[dst[i]][tbl[src[i]]]; });
+		// There is no byte gather in SSE2/NEON, so the light table lookup stays scalar.
+		ForEachSetBit(mask, [dst, src, tbl](int i) { dst[i] = tbl[src[i]]; });
+		return;
+	}
+
+	std::uint_fast8_t i = 0;
+	for (; i + 16 <= n; i += 16, mask <<= 16) {
+		StorePixelsMasked(dst + i, ExpandMask16(mask), Light == LightType::FullyDark ? ZeroPixels() : LoadPixels(src + i));
+	}
+	dst += i;
+	src += i;
+	if (Light == LightType::FullyDark) {
+		ForEachSetBit(mask, [dst](int j) { dst[j] = 0; });
+	} else {
+		ForEachSetBit(mask, [dst, src](int j) { dst[j] = src[j]; });
+	}
+}
+#else
+constexpr bool HasVectorizedBackend = false;
+
+template <LightType Light>
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLineBlendedVectorized(std::uint8_t *dst, const std::uint8_t *src, std::uint_fast8_t n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	RenderLineBlended<Light>(dst, src, n, tbl, mask);
+}
+#endif
+
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLine(std::uint8_t *dst, const std::uint8_t *src, std::uint_fast8_t n, const std::uint8_t *tbl, std::uint32_t mask)
 {
 	if (Transparency == TransparencyType::Solid) {
@@ -467,7 +584,9 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLine(std::uint8_t *dst, const std
 		mask &= firstNOnes;
 		if (mask == firstNOnes) {
 			RenderLineOpaque<Light>(dst, src, n, tbl);
-		} else if (Transparency == TransparencyType::Blended) {
+		} else if (Backend == TileRenderBackend::Vectorized) {
+			RenderLineBlendedVectorized<Light>(dst, src, n, tbl, mask);
+		} else {
 			RenderLineBlended<Light>(dst, src, n, tbl, mask);
 		}
 	}
@@ -494,36 +613,36 @@ Clip CalculateClip(std::int_fast16_t x, std::int_fast16_t y, std::int_fast16_t w
 	return clip;
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderSquareFull(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl)
 {
 	for (auto i = 0; i < Height; ++i, dst -= dstPitch, --mask) {
-		RenderLine<Transparency, Light>(dst, src, Width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, Width, tbl, *mask);
 		src += Width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderSquareClipped(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	src += clip.bottom * Height + clip.left;
 	for (auto i = 0; i < clip.height; ++i, dst -= dstPitch, --mask) {
-		RenderLine<Transparency, Light>(dst, src, clip.width, tbl, (*mask) << clip.left);
+		RenderLine<Transparency, Light, Backend>(dst, src, clip.width, tbl, (*mask) << clip.left);
 		src += Width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderSquare(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	if (clip.width == Width && clip.height == Height) {
-		RenderSquareFull<Transparency, Light>(dst, dstPitch, src, mask, tbl);
+		RenderSquareFull<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl);
 	} else {
-		RenderSquareClipped<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderSquareClipped<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderTransparentSquareFull(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl)
 {
 	for (auto i = 0; i < Height; ++i, dst -= dstPitch + Width, --mask) {
@@ -533,7 +652,7 @@ DVL_ATTRIBUTE_HOT void RenderTransparentSquareFull(std::uint8_t *dst, int dstPit
 		while (drawWidth > 0) {
 			auto v = static_cast<std::int8_t>(*src++);
 			if (v > 0) {
-				RenderLine<Transparency, Light>(dst, src, v, tbl, m);
+				RenderLine<Transparency, Light, Backend>(dst, src, v, tbl, m);
 				src += v;
 			} else {
 				v = -v;
@@ -545,7 +664,7 @@ DVL_ATTRIBUTE_HOT void RenderTransparentSquareFull(std::uint8_t *dst, int dstPit
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 // NOLINTNEXTLINE(readability-function-cognitive-complexity): Actually complex and has to be fast.
 DVL_ATTRIBUTE_HOT void RenderTransparentSquareClipped(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
@@ -580,7 +699,7 @@ DVL_ATTRIBUTE_HOT void RenderTransparentSquareClipped(std::uint8_t *dst, int dst
 			if (v > 0) {
 				if (v > remainingLeftClip) {
 					const auto overshoot = v - remainingLeftClip;
-					RenderLine<Transparency, Light>(dst, src + remainingLeftClip, overshoot, tbl, m);
+					RenderLine<Transparency, Light, Backend>(dst, src + remainingLeftClip, overshoot, tbl, m);
 					dst += overshoot;
 					drawWidth -= overshoot;
 				}
@@ -602,13 +721,13 @@ DVL_ATTRIBUTE_HOT void RenderTransparentSquareClipped(std::uint8_t *dst, int dst
 			auto v = static_cast<std::int8_t>(*src++);
 			if (v > 0) {
 				if (v > drawWidth) {
-					RenderLine<Transparency, Light>(dst, src, drawWidth, tbl, m);
+					RenderLine<Transparency, Light, Backend>(dst, src, drawWidth, tbl, m);
 					src += v;
 					dst += drawWidth;
 					drawWidth -= v;
 					break;
 				}
-				RenderLine<Transparency, Light>(dst, src, v, tbl, m);
+				RenderLine<Transparency, Light, Backend>(dst, src, v, tbl, m);
 				src += v;
 			} else {
 				v = -v;
@@ -629,13 +748,13 @@ DVL_ATTRIBUTE_HOT void RenderTransparentSquareClipped(std::uint8_t *dst, int dst
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderTransparentSquare(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	if (clip.width == Width && clip.height == Height) {
-		RenderTransparentSquareFull<Transparency, Light>(dst, dstPitch, src, mask, tbl);
+		RenderTransparentSquareFull<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl);
 	} else {
-		RenderTransparentSquareClipped<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderTransparentSquareClipped<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 	}
 }
 
@@ -677,26 +796,26 @@ std::size_t CalculateTriangleSourceSkipUpperBottom(std::int_fast16_t numLines)
 	return 2 * TriangleUpperHeight * numLines - numLines * (numLines - 1) + 2 * ((numLines + 1) / 2);
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderLeftTriangleFull(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl)
 {
 	dst += XStep * (LowerHeight - 1);
 	for (auto i = 1; i <= LowerHeight; ++i, dst -= dstPitch + XStep, --mask) {
 		src += 2 * (i % 2);
 		const auto width = XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width;
 	}
 	dst += 2 * XStep;
 	for (auto i = 1; i <= TriangleUpperHeight; ++i, dst -= dstPitch - XStep, --mask) {
 		src += 2 * (i % 2);
 		const auto width = Width - XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderLeftTriangleClipVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY(clip);
@@ -706,7 +825,7 @@ DVL_ATTRIBUTE_HOT void RenderLeftTriangleClipVertical(std::uint8_t *dst, int dst
 	for (auto i = 1 + clipY.lowerBottom; i <= lowerMax; ++i, dst -= dstPitch + XStep, --mask) {
 		src += 2 * (i % 2);
 		const auto width = XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width;
 	}
 	src += CalculateTriangleSourceSkipUpperBottom(clipY.upperBottom);
@@ -715,12 +834,12 @@ DVL_ATTRIBUTE_HOT void RenderLeftTriangleClipVertical(std::uint8_t *dst, int dst
 	for (auto i = 1 + clipY.upperBottom; i <= upperMax; ++i, dst -= dstPitch - XStep, --mask) {
 		src += 2 * (i % 2);
 		const auto width = Width - XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderLeftTriangleClipLeftAndVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY(clip);
@@ -734,7 +853,7 @@ DVL_ATTRIBUTE_HOT void RenderLeftTriangleClipLeftAndVertical(std::uint8_t *dst,
 		const auto startX = Width - XStep * i;
 		const auto skip = startX < clipLeft ? clipLeft - startX : 0;
 		if (width > skip)
-			RenderLine<Transparency, Light>(dst + skip, src + skip, width - skip, tbl, (*mask) << skip);
+			RenderLine<Transparency, Light, Backend>(dst + skip, src + skip, width - skip, tbl, (*mask) << skip);
 		src += width;
 	}
 	src += CalculateTriangleSourceSkipUpperBottom(clipY.upperBottom);
@@ -746,12 +865,12 @@ DVL_ATTRIBUTE_HOT void RenderLeftTriangleClipLeftAndVertical(std::uint8_t *dst,
 		const auto startX = XStep * i;
 		const auto skip = startX < clipLeft ? clipLeft - startX : 0;
 		if (width > skip)
-			RenderLine<Transparency, Light>(dst + skip, src + skip, width - skip, tbl, (*mask) << skip);
+			RenderLine<Transparency, Light, Backend>(dst + skip, src + skip, width - skip, tbl, (*mask) << skip);
 		src += width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderLeftTriangleClipRightAndVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY(clip);
@@ -763,7 +882,7 @@ DVL_ATTRIBUTE_HOT void RenderLeftTriangleClipRightAndVertical(std::uint8_t *dst,
 		src += 2 * (i % 2);
 		const auto width = XStep * i;
 		if (width > clipRight)
-			RenderLine<Transparency, Light>(dst, src, width - clipRight, tbl, *mask);
+			RenderLine<Transparency, Light, Backend>(dst, src, width - clipRight, tbl, *mask);
 		src += width;
 	}
 	src += CalculateTriangleSourceSkipUpperBottom(clipY.upperBottom);
@@ -774,43 +893,43 @@ DVL_ATTRIBUTE_HOT void RenderLeftTriangleClipRightAndVertical(std::uint8_t *dst,
 		const auto width = Width - XStep * i;
 		if (width <= clipRight)
 			break;
-		RenderLine<Transparency, Light>(dst, src, width - clipRight, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width - clipRight, tbl, *mask);
 		src += width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderLeftTriangle(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	if (clip.width == Width) {
 		if (clip.height == TriangleHeight) {
-			RenderLeftTriangleFull<Transparency, Light>(dst, dstPitch, src, mask, tbl);
+			RenderLeftTriangleFull<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl);
 		} else {
-			RenderLeftTriangleClipVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+			RenderLeftTriangleClipVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 		}
 	} else if (clip.right == 0) {
-		RenderLeftTriangleClipLeftAndVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderLeftTriangleClipLeftAndVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 	} else {
-		RenderLeftTriangleClipRightAndVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderLeftTriangleClipRightAndVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderRightTriangleFull(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl)
 {
 	for (auto i = 1; i <= LowerHeight; ++i, dst -= dstPitch, --mask) {
 		const auto width = XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width + 2 * (i % 2);
 	}
 	for (auto i = 1; i <= TriangleUpperHeight; ++i, dst -= dstPitch, --mask) {
 		const auto width = Width - XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width + 2 * (i % 2);
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderRightTriangleClipVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY(clip);
@@ -818,19 +937,19 @@ DVL_ATTRIBUTE_HOT void RenderRightTriangleClipVertical(std::uint8_t *dst, int ds
 	const auto lowerMax = LowerHeight - clipY.lowerTop;
 	for (auto i = 1 + clipY.lowerBottom; i <= lowerMax; ++i, dst -= dstPitch, --mask) {
 		const auto width = XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width + 2 * (i % 2);
 	}
 	src += CalculateTriangleSourceSkipUpperBottom(clipY.upperBottom);
 	const auto upperMax = TriangleUpperHeight - clipY.upperTop;
 	for (auto i = 1 + clipY.upperBottom; i <= upperMax; ++i, dst -= dstPitch, --mask) {
 		const auto width = Width - XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width + 2 * (i % 2);
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderRightTriangleClipLeftAndVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY(clip);
@@ -840,7 +959,7 @@ DVL_ATTRIBUTE_HOT void RenderRightTriangleClipLeftAndVertical(std::uint8_t *dst,
 	for (auto i = 1 + clipY.lowerBottom; i <= lowerMax; ++i, dst -= dstPitch, --mask) {
 		const auto width = XStep * i;
 		if (width > clipLeft)
-			RenderLine<Transparency, Light>(dst, src + clipLeft, width - clipLeft, tbl, (*mask) << clipLeft);
+			RenderLine<Transparency, Light, Backend>(dst, src + clipLeft, width - clipLeft, tbl, (*mask) << clipLeft);
 		src += width + 2 * (i % 2);
 	}
 	src += CalculateTriangleSourceSkipUpperBottom(clipY.upperBottom);
@@ -849,12 +968,12 @@ DVL_ATTRIBUTE_HOT void RenderRightTriangleClipLeftAndVertical(std::uint8_t *dst,
 		const auto width = Width - XStep * i;
 		if (width <= clipLeft)
 			break;
-		RenderLine<Transparency, Light>(dst, src + clipLeft, width - clipLeft, tbl, (*mask) << clipLeft);
+		RenderLine<Transparency, Light, Backend>(dst, src + clipLeft, width - clipLeft, tbl, (*mask) << clipLeft);
 		src += width + 2 * (i % 2);
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderRightTriangleClipRightAndVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY(clip);
@@ -865,7 +984,7 @@ DVL_ATTRIBUTE_HOT void RenderRightTriangleClipRightAndVertical(std::uint8_t *dst
 		const auto width = XStep * i;
 		const auto skip = Width - width < clipRight ? clipRight - (Width - width) : 0;
 		if (width > skip)
-			RenderLine<Transparency, Light>(dst, src, width - skip, tbl, *mask);
+			RenderLine<Transparency, Light, Backend>(dst, src, width - skip, tbl, *mask);
 		src += width + 2 * (i % 2);
 	}
 	src += CalculateTriangleSourceSkipUpperBottom(clipY.upperBottom);
@@ -874,45 +993,45 @@ DVL_ATTRIBUTE_HOT void RenderRightTriangleClipRightAndVertical(std::uint8_t *dst
 		const auto width = Width - XStep * i;
 		const auto skip = Width - width < clipRight ? clipRight - (Width - width) : 0;
 		if (width > skip)
-			RenderLine<Transparency, Light>(dst, src, width - skip, tbl, *mask);
+			RenderLine<Transparency, Light, Backend>(dst, src, width - skip, tbl, *mask);
 		src += width + 2 * (i % 2);
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderRightTriangle(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	if (clip.width == Width) {
 		if (clip.height == TriangleHeight) {
-			RenderRightTriangleFull<Transparency, Light>(dst, dstPitch, src, mask, tbl);
+			RenderRightTriangleFull<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl);
 		} else {
-			RenderRightTriangleClipVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+			RenderRightTriangleClipVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 		}
 	} else if (clip.right == 0) {
-		RenderRightTriangleClipLeftAndVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderRightTriangleClipLeftAndVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 	} else {
-		RenderRightTriangleClipRightAndVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderRightTriangleClipRightAndVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderLeftTrapezoidFull(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl)
 {
 	dst += XStep * (LowerHeight - 1);
 	for (auto i = 1; i <= LowerHeight; ++i, dst -= dstPitch + XStep, --mask) {
 		src += 2 * (i % 2);
 		const auto width = XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width;
 	}
 	dst += XStep;
 	for (auto i = 1; i <= TrapezoidUpperHeight; ++i, dst -= dstPitch, --mask) {
-		RenderLine<Transparency, Light>(dst, src, Width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, Width, tbl, *mask);
 		src += Width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderLeftTrapezoidClipVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY<TrapezoidUpperHeight>(clip);
@@ -922,19 +1041,19 @@ DVL_ATTRIBUTE_HOT void RenderLeftTrapezoidClipVertical(std::uint8_t *dst, int ds
 	for (auto i = 1 + clipY.lowerBottom; i <= lowerMax; ++i, dst -= dstPitch + XStep, --mask) {
 		src += 2 * (i % 2);
 		const auto width = XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width;
 	}
 	src += clipY.upperBottom * Width;
 	dst += XStep;
 	const auto upperMax = TrapezoidUpperHeight - clipY.upperTop;
 	for (auto i = 1 + clipY.upperBottom; i <= upperMax; ++i, dst -= dstPitch, --mask) {
-		RenderLine<Transparency, Light>(dst, src, Width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, Width, tbl, *mask);
 		src += Width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderLeftTrapezoidClipLeftAndVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY<TrapezoidUpperHeight>(clip);
@@ -948,19 +1067,19 @@ DVL_ATTRIBUTE_HOT void RenderLeftTrapezoidClipLeftAndVertical(std::uint8_t *dst,
 		const auto startX = Width - XStep * i;
 		const auto skip = startX < clipLeft ? clipLeft - startX : 0;
 		if (width > skip)
-			RenderLine<Transparency, Light>(dst + skip, src + skip, width - skip, tbl, (*mask) << skip);
+			RenderLine<Transparency, Light, Backend>(dst + skip, src + skip, width - skip, tbl, (*mask) << skip);
 		src += width;
 	}
 	src += clipY.upperBottom * Width + clipLeft;
 	dst += XStep + clipLeft;
 	const auto upperMax = TrapezoidUpperHeight - clipY.upperTop;
 	for (auto i = 1 + clipY.upperBottom; i <= upperMax; ++i, dst -= dstPitch, --mask) {
-		RenderLine<Transparency, Light>(dst, src, clip.width, tbl, (*mask) << clipLeft);
+		RenderLine<Transparency, Light, Backend>(dst, src, clip.width, tbl, (*mask) << clipLeft);
 		src += Width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderLeftTrapezoidClipRightAndVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY<TrapezoidUpperHeight>(clip);
@@ -972,49 +1091,49 @@ DVL_ATTRIBUTE_HOT void RenderLeftTrapezoidClipRightAndVertical(std::uint8_t *dst
 		src += 2 * (i % 2);
 		const auto width = XStep * i;
 		if (width > clipRight)
-			RenderLine<Transparency, Light>(dst, src, width - clipRight, tbl, *mask);
+			RenderLine<Transparency, Light, Backend>(dst, src, width - clipRight, tbl, *mask);
 		src += width;
 	}
 	src += clipY.upperBottom * Width;
 	dst += XStep;
 	const auto upperMax = TrapezoidUpperHeight - clipY.upperTop;
 	for (auto i = 1 + clipY.upperBottom; i <= upperMax; ++i, dst -= dstPitch, --mask) {
-		RenderLine<Transparency, Light>(dst, src, clip.width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, clip.width, tbl, *mask);
 		src += Width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderLeftTrapezoid(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	if (clip.width == Width) {
 		if (clip.height == Height) {
-			RenderLeftTrapezoidFull<Transparency, Light>(dst, dstPitch, src, mask, tbl);
+			RenderLeftTrapezoidFull<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl);
 		} else {
-			RenderLeftTrapezoidClipVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+			RenderLeftTrapezoidClipVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 		}
 	} else if (clip.right == 0) {
-		RenderLeftTrapezoidClipLeftAndVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderLeftTrapezoidClipLeftAndVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 	} else {
-		RenderLeftTrapezoidClipRightAndVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderLeftTrapezoidClipRightAndVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderRightTrapezoidFull(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl)
 {
 	for (auto i = 1; i <= LowerHeight; ++i, dst -= dstPitch, --mask) {
 		const auto width = XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width + 2 * (i % 2);
 	}
 	for (auto i = 1; i <= TrapezoidUpperHeight; ++i, dst -= dstPitch, --mask) {
-		RenderLine<Transparency, Light>(dst, src, Width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, Width, tbl, *mask);
 		src += Width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderRightTrapezoidClipVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY<TrapezoidUpperHeight>(clip);
@@ -1022,18 +1141,18 @@ DVL_ATTRIBUTE_HOT void RenderRightTrapezoidClipVertical(std::uint8_t *dst, int d
 	src += CalculateTriangleSourceSkipLowerBottom(clipY.lowerBottom);
 	for (auto i = 1 + clipY.lowerBottom; i <= lowerMax; ++i, dst -= dstPitch, --mask) {
 		const auto width = XStep * i;
-		RenderLine<Transparency, Light>(dst, src, width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, width, tbl, *mask);
 		src += width + 2 * (i % 2);
 	}
 	src += clipY.upperBottom * Width;
 	const auto upperMax = TrapezoidUpperHeight - clipY.upperTop;
 	for (auto i = 1 + clipY.upperBottom; i <= upperMax; ++i, dst -= dstPitch, --mask) {
-		RenderLine<Transparency, Light>(dst, src, Width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, Width, tbl, *mask);
 		src += Width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderRightTrapezoidClipLeftAndVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY<TrapezoidUpperHeight>(clip);
@@ -1043,18 +1162,18 @@ DVL_ATTRIBUTE_HOT void RenderRightTrapezoidClipLeftAndVertical(std::uint8_t *dst
 	for (auto i = 1 + clipY.lowerBottom; i <= lowerMax; ++i, dst -= dstPitch, --mask) {
 		const auto width = XStep * i;
 		if (width > clipLeft)
-			RenderLine<Transparency, Light>(dst, src + clipLeft, width - clipLeft, tbl, (*mask) << clipLeft);
+			RenderLine<Transparency, Light, Backend>(dst, src + clipLeft, width - clipLeft, tbl, (*mask) << clipLeft);
 		src += width + 2 * (i % 2);
 	}
 	src += clipY.upperBottom * Width + clipLeft;
 	const auto upperMax = TrapezoidUpperHeight - clipY.upperTop;
 	for (auto i = 1 + clipY.upperBottom; i <= upperMax; ++i, dst -= dstPitch, --mask) {
-		RenderLine<Transparency, Light>(dst, src, clip.width, tbl, (*mask) << clipLeft);
+		RenderLine<Transparency, Light, Backend>(dst, src, clip.width, tbl, (*mask) << clipLeft);
 		src += Width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderRightTrapezoidClipRightAndVertical(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	const auto clipY = CalculateDiamondClipY<TrapezoidUpperHeight>(clip);
@@ -1065,54 +1184,54 @@ DVL_ATTRIBUTE_HOT void RenderRightTrapezoidClipRightAndVertical(std::uint8_t *ds
 		const auto width = XStep * i;
 		const auto skip = Width - width < clipRight ? clipRight - (Width - width) : 0;
 		if (width > skip)
-			RenderLine<Transparency, Light>(dst, src, width - skip, tbl, *mask);
+			RenderLine<Transparency, Light, Backend>(dst, src, width - skip, tbl, *mask);
 		src += width + 2 * (i % 2);
 	}
 	src += clipY.upperBottom * Width;
 	const auto upperMax = TrapezoidUpperHeight - clipY.upperTop;
 	for (auto i = 1 + clipY.upperBottom; i <= upperMax; ++i, dst -= dstPitch, --mask) {
-		RenderLine<Transparency, Light>(dst, src, clip.width, tbl, *mask);
+		RenderLine<Transparency, Light, Backend>(dst, src, clip.width, tbl, *mask);
 		src += Width;
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderRightTrapezoid(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	if (clip.width == Width) {
 		if (clip.height == Height) {
-			RenderRightTrapezoidFull<Transparency, Light>(dst, dstPitch, src, mask, tbl);
+			RenderRightTrapezoidFull<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl);
 		} else {
-			RenderRightTrapezoidClipVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+			RenderRightTrapezoidClipVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 		}
 	} else if (clip.right == 0) {
-		RenderRightTrapezoidClipLeftAndVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderRightTrapezoidClipLeftAndVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 	} else {
-		RenderRightTrapezoidClipRightAndVertical<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderRightTrapezoidClipRightAndVertical<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 	}
 }
 
-template <TransparencyType Transparency, LightType Light>
+template <TransparencyType Transparency, LightType Light, TileRenderBackend Backend>
 DVL_ATTRIBUTE_HOT void RenderTileType(TileType tile, std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
 {
 	switch (tile) {
 	case TileType::Square:
-		RenderSquare<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderSquare<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 		break;
 	case TileType::TransparentSquare:
-		RenderTransparentSquare<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderTransparentSquare<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 		break;
 	case TileType::LeftTriangle:
-		RenderLeftTriangle<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderLeftTriangle<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 		break;
 	case TileType::RightTriangle:
-		RenderRightTriangle<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderRightTriangle<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 		break;
 	case TileType::LeftTrapezoid:
-		RenderLeftTrapezoid<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderLeftTrapezoid<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 		break;
 	case TileType::RightTrapezoid:
-		RenderRightTrapezoid<Transparency, Light>(dst, dstPitch, src, mask, tbl, clip);
+		RenderRightTrapezoid<Transparency, Light, Backend>(dst, dstPitch, src, mask, tbl, clip);
 		break;
 	}
 }
@@ -1241,8 +1360,51 @@ void RenderBlackTileFull(std::uint8_t *dst, int dstPitch)
 	}
 }
 
+TileRenderBackend ActiveTileRenderBackend = HasVectorizedBackend ? TileRenderBackend::Vectorized : TileRenderBackend::Scalar;
+
+template <TileRenderBackend Backend>
+DVL_ATTRIBUTE_HOT void RenderTileWithBackend(TileType tile, std::uint8_t *dst, int dstPitch, const std::uint8_t *src, const std::uint32_t *mask, const std::uint8_t *tbl, Clip clip)
+{
+	if (mask == &SolidMask[TILE_HEIGHT - 1]) {
+		// Solid lines are plain `memset`/`memcpy`/light table lookups, which are the same for every backend.
+		if (LightTableIndex == LightsMax) {
+			RenderTileType<TransparencyType::Solid, LightType::FullyDark, TileRenderBackend::Scalar>(tile, dst, dstPitch, src, mask, tbl, clip);
+		} else if (LightTableIndex == 0) {
+			RenderTileType<TransparencyType::Solid, LightType::FullyLit, TileRenderBackend::Scalar>(tile, dst, dstPitch, src, mask, tbl, clip);
+		} else {
+			RenderTileType<TransparencyType::Solid, LightType::PartiallyLit, TileRenderBackend::Scalar>(tile, dst, dstPitch, src, mask, tbl, clip);
+		}
+	} else {
+		mask -= clip.bottom;
+		if (LightTableIndex == LightsMax) {
+			RenderTileType<TransparencyType::Blended, LightType::FullyDark, Backend>(tile, dst, dstPitch, src, mask, tbl, clip);
+		} else if (LightTableIndex == 0) {
+			RenderTileType<TransparencyType::Blended, LightType::FullyLit, Backend>(tile, dst, dstPitch, src, mask, tbl, clip);
+		} else {
+			RenderTileType<TransparencyType::Blended, LightType::PartiallyLit, Backend>(tile, dst, dstPitch, src, mask, tbl, clip);
+		}
+	}
+}
+
 } // namespace
 
+bool IsVectorizedTileRenderBackendAvailable()
+{
+	return HasVectorizedBackend;
+}
+
+TileRenderBackend GetTileRenderBackend()
+{
+	return ActiveTileRenderBackend;
+}
+
+void SetTileRenderBackend(TileRenderBackend backend)
+{
+	if (backend == TileRenderBackend::Vectorized && !HasVectorizedBackend)
+		backend = TileRenderBackend::Scalar;
+	ActiveTileRenderBackend = backend;
+}
+
 void RenderTile(const Surface &out, Point position)
 {
 	const auto tile = static_cast<TileType>((level_cel_block & 0x7000) >> 12);
@@ -1270,23 +1432,10 @@ void RenderTile(const Surface &out, Point position)
 	std::uint8_t *dst = out.at(static_cast<int>(position.x + clip.left), static_cast<int>(position.y - clip.bottom));
 	const auto dstPitch = out.pitch();
 
-	if (mask == &SolidMask[TILE_HEIGHT - 1]) {
-		if (LightTableIndex == LightsMax) {
-			RenderTileType<TransparencyType::Solid, LightType::FullyDark>(tile, dst, dstPitch, src, mask, tbl, clip);
-		} else if (LightTableIndex == 0) {
-			RenderTileType<TransparencyType::Solid, LightType::FullyLit>(tile, dst, dstPitch, src, mask, tbl, clip);
-		} else {
-			RenderTileType<TransparencyType::Solid, LightType::PartiallyLit>(tile, dst, dstPitch, src, mask, tbl, clip);
-		}
+	if (ActiveTileRenderBackend == TileRenderBackend::Vectorized) {
+		RenderTileWithBackend<TileRenderBackend::Vectorized>(tile, dst, dstPitch, src, mask, tbl, clip);
 	} else {
-		mask -= clip.bottom;
-		if (LightTableIndex == LightsMax) {
-			RenderTileType<TransparencyType::Blended, LightType::FullyDark>(tile, dst, dstPitch, src, mask, tbl, clip);
-		} else if (LightTableIndex == 0) {
-			RenderTileType<TransparencyType::Blended, LightType::FullyLit>(tile, dst, dstPitch, src, mask, tbl, clip);
-		} else {
-			RenderTileType<TransparencyType::Blended, LightType::PartiallyLit>(tile, dst, dstPitch, src, mask, tbl, clip);
-		}
+		RenderTileWithBackend<TileRenderBackend::Scalar>(tile, dst, dstPitch, src, mask, tbl, clip);
 	}
 }
 
@@ -5,10 +5,40 @@
  */
 #pragma once
 
+#include <cstdint>
+
 #include "engine.h"
 
 namespace devilution {
 
+/**
+ * @brief Implementation of the per-line inner loops used by `RenderTile`.
+ */
+enum class TileRenderBackend : std::uint8_t {
+	/** Portable byte-at-a-time implementation. This is the reference for all other backends. */
+	Scalar,
+
+	/** SSE2 (x86) or NEON (ARM) implementation. */
+	Vectorized,
+};
+
+/**
+ * @brief Whether the `TileRenderBackend::Vectorized` backend is supported by this build.
+ */
+bool IsVectorizedTileRenderBackendAvailable();
+
+/**
+ * @brief Returns the backend currently used by `RenderTile`.
+ */
+TileRenderBackend GetTileRenderBackend();
+
+/**
+ * @brief Selects the backend used by `RenderTile`.
+ *
+ * Falls back to `TileRenderBackend::Scalar` if the requested backend is not available.
+ */
+void SetTileRenderBackend(TileRenderBackend backend);
+
 /**
  * @brief Blit current world CEL to the given buffer
  * @param out Target buffer
@@ -7,8 +7,12 @@
 
 #include <array>
 #include <cstddef>
+#include <functional>
+#include <list>
+#include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "DiabloUI/art_draw.h"
 #include "DiabloUI/diabloui.h"
@@ -35,7 +39,10 @@ namespace {
 constexpr char32_t ZWSP = U'\u200B'; // Zero-width space
 
 using Font = const OwnedCelSpriteWithFrameHeight;
+/** Untranslated glyphs per font size and unicode row, shared by all text colors */
 std::unordered_map<uint32_t, std::optional<OwnedCelSpriteWithFrameHeight>> Fonts;
+/** Palette translations of the text colors, applied while blitting the glyphs */
+std::unordered_map<uint8_t, std::array<uint8_t, 256>> FontTranslations;
 
 std::unordered_map<uint32_t, std::array<uint8_t, 256>> FontKerns;
 std::array<int, 6> FontSizes = { 12, 24, 30, 42, 46, 22 };
@@ -166,9 +173,9 @@ std::array<uint8_t, 256> *LoadFontKerning(GameFontTables size, uint16_t row)
 	return kerning;
 }
 
-uint32_t GetFontId(GameFontTables size, text_color color, uint16_t row)
+uint32_t GetFontId(GameFontTables size, uint16_t row)
 {
-	return (color << 24) | (size << 16) | row;
+	return (size << 16) | row;
 }
 
 void GetFontPath(GameFontTables size, uint16_t row, char *out)
@@ -176,9 +183,9 @@ void GetFontPath(GameFontTables size, uint16_t row, char *out)
 	sprintf(out, "fonts\\%i-%02x.pcx", FontSizes[size], row);
 }
 
-const OwnedCelSpriteWithFrameHeight *LoadFont(GameFontTables size, text_color color, uint16_t row)
+const OwnedCelSpriteWithFrameHeight *LoadFont(GameFontTables size, uint16_t row)
 {
-	const uint32_t fontId = GetFontId(size, color, row);
+	const uint32_t fontId = GetFontId(size, row);
 
 	auto hotFont = Fonts.find(fontId);
 	if (hotFont != Fonts.end()) {
@@ -196,18 +203,34 @@ const OwnedCelSpriteWithFrameHeight *LoadFont(GameFontTables size, text_color co
 		return nullptr;
 	}
 
-	if (ColorTranslations[color] != nullptr) {
-		std::array<uint8_t, 256> colorMapping;
-		LoadFileInMem(ColorTranslations[color], colorMapping);
-		CelApplyTrans(font->sprite.MutableData(), colorMapping);
+	return &(*font);
+}
+
+/**
+ * @brief Returns the palette translation of a text color, or nullptr if the glyphs are drawn as is.
+ */
+uint8_t *LoadFontTranslation(text_color color)
+{
+	if (ColorTranslations[color] == nullptr)
+		return nullptr;
+
+	auto hotTranslation = FontTranslations.find(color);
+	if (hotTranslation != FontTranslations.end()) {
+		return hotTranslation->second.data();
 	}
 
-	return &(*font);
+	std::array<uint8_t, 256> &translation = FontTranslations[color];
+	LoadFileInMem(ColorTranslations[color], translation);
+	return translation.data();
 }
 
-void DrawFont(const Surface &out, Point position, const OwnedCelSpriteWithFrameHeight *font, int frame)
+void DrawFont(const Surface &out, Point position, const OwnedCelSpriteWithFrameHeight *font, int frame, uint8_t *translation)
 {
-	CelDrawTo(out, { position.x, static_cast<int>(position.y + font->frameHeight) }, CelSprite { font->sprite }, frame);
+	const Point glyphPosition { position.x, static_cast<int>(position.y + font->frameHeight) };
+	if (translation != nullptr)
+		CelDrawLightTo(out, glyphPosition, CelSprite { font->sprite }, frame, translation);
+	else
+		CelDrawTo(out, glyphPosition, CelSprite { font->sprite }, frame);
 }
 
 bool IsWhitespace(char32_t c)
@@ -341,13 +364,20 @@ int GetLineHeight(string_view fmt, DrawStringFormatArg *args, std::size_t argsLe
 	return LineHeights[fontIndex];
 }
 
-int DoDrawString(const Surface &out, string_view text, Rectangle rect, Point &characterPosition,
-    int spacing, int lineHeight, int lineWidth, int rightMargin, int bottomMargin,
-    UiFlags flags, GameFontTables size, text_color color)
+/**
+ * @brief Places the glyphs of a string, wrapping at the right margin and aligning each line as requested.
+ * @param placeGlyph Called with the position, unicode row and frame of every glyph
+ * @param startLine Called with the position before every line break and the value to return if stopping there,
+ * returns false to stop
+ * @return text.data() - remaining.data() for the point where placing stopped
+ */
+template <typename PlaceGlyph, typename StartLine>
+int LayOutString(string_view text, Rectangle rect, Point &characterPosition,
+    int spacing, int lineHeight, int lineWidth, int rightMargin,
+    UiFlags flags, GameFontTables size, PlaceGlyph &&placeGlyph, StartLine &&startLine)
 {
-	Font *font = nullptr;
 	std::array<uint8_t, 256> *kerning = nullptr;
-	uint32_t currentUnicodeRow = 0;
+	uint16_t currentUnicodeRow = 0;
 
 	char32_t next;
 	string_view remaining = text;
@@ -358,16 +388,15 @@ int DoDrawString(const Surface &out, string_view text, Rectangle rect, Point &ch
 		if (next == ZWSP)
 			continue;
 
-		const uint32_t unicodeRow = GetUnicodeRow(next);
-		if (unicodeRow != currentUnicodeRow || font == nullptr) {
+		const uint16_t unicodeRow = GetUnicodeRow(next);
+		if (unicodeRow != currentUnicodeRow || kerning == nullptr) {
 			kerning = LoadFontKerning(size, unicodeRow);
-			font = LoadFont(size, color, unicodeRow);
 			currentUnicodeRow = unicodeRow;
 		}
 
 		uint8_t frame = next & 0xFF;
 		if (next == '\n' || characterPosition.x > rightMargin) {
-			if (characterPosition.y + lineHeight >= bottomMargin)
+			if (!startLine(characterPosition, static_cast<int>(text.data() - remaining.data())))
 				break;
 			characterPosition.x = rect.position.x;
 			characterPosition.y += lineHeight;
@@ -387,36 +416,247 @@ int DoDrawString(const Surface &out, string_view text, Rectangle rect, Point &ch
 				continue;
 		}
 
-		DrawFont(out, characterPosition, font, frame);
+		placeGlyph(characterPosition, unicodeRow, frame);
 		characterPosition.x += (*kerning)[frame] + spacing;
 	}
 	return text.data() - remaining.data();
 }
 
-} // namespace
+/**
+ * @brief Draws glyphs of one font size, loading the glyph set whenever the unicode row changes.
+ */
+class GlyphDrawer {
+public:
+	GlyphDrawer(const Surface &out, GameFontTables size, text_color color)
+	    : out_(out)
+	    , size_(size)
+	    , translation_(LoadFontTranslation(color))
+	{
+	}
 
-void LoadSmallSelectionSpinner()
+	void operator()(Point position, uint16_t row, uint8_t frame)
+	{
+		if (font_ == nullptr || row != row_) {
+			font_ = LoadFont(size_, row);
+			row_ = row;
+		}
+		DrawFont(out_, position, font_, frame, translation_);
+	}
+
+private:
+	const Surface &out_;
+	GameFontTables size_;
+	uint8_t *translation_;
+	Font *font_ = nullptr;
+	uint16_t row_ = 0;
+};
+
+int DoDrawString(const Surface &out, string_view text, Rectangle rect, Point &characterPosition,
+    int spacing, int lineHeight, int lineWidth, int rightMargin, int bottomMargin,
+    UiFlags flags, GameFontTables size, text_color color)
 {
-	pSPentSpn2Cels = LoadCel("Data\\PentSpn2.CEL", 12);
+	return LayOutString(text, rect, characterPosition, spacing, lineHeight, lineWidth, rightMargin, flags, size,
+	    GlyphDrawer { out, size, color },
+	    [&](Point position, int /*result*/) { return position.y + lineHeight < bottomMargin; });
 }
 
-void UnloadFonts(GameFontTables size, text_color color)
+struct PlacedGlyph {
+	Displacement offset;
+	uint16_t row;
+	uint8_t frame;
+};
+
+struct TextLineBreak {
+	/** Index of the first glyph after the break */
+	std::size_t glyph;
+	/** Character position before the break */
+	Displacement offset;
+	/** DrawString result if drawing stops at this break */
+	int result;
+};
+
+/**
+ * @brief The glyph positions of a string drawn by DrawString, relative to the top left corner of the text box.
+ *
+ * Everything but the bottom margin is relative to the box, so a layout is valid wherever the box is placed.
+ * The line breaks are kept to stop at the bottom of the box or the surface like DoDrawString does.
+ */
+struct TextLayout {
+	std::size_t hash;
+	std::string text;
+	UiFlags flags;
+	int spacing;
+	Size size;
+	int lineHeight;
+
+	std::vector<PlacedGlyph> glyphs;
+	std::vector<TextLineBreak> lineBreaks;
+	/** Character position after the last glyph */
+	Displacement end;
+	int result;
+};
+
+/** Number of layouts kept, enough for every string of a busy screen */
+constexpr std::size_t MaxTextLayouts = 256;
+/** Cached layouts, the most recently drawn first */
+std::list<TextLayout> TextLayouts;
+std::unordered_map<std::size_t, std::list<TextLayout>::iterator> TextLayoutsByHash;
+
+std::size_t HashTextLayout(string_view text, Size size, UiFlags flags, int spacing, int lineHeight)
 {
-	uint32_t fontStyle = (color << 24) | (size << 16);
+	std::size_t hash = std::hash<string_view> {}(text);
+	for (int value : { size.width, size.height, static_cast<int>(flags), spacing, lineHeight })
+		hash = hash * 31 + static_cast<std::size_t>(value);
+	return hash;
+}
 
-	for (auto font = Fonts.begin(); font != Fonts.end();) {
-		if ((font->first & 0xFFFF0000) == fontStyle) {
-			font = Fonts.erase(font);
-		} else {
-			font++;
+int AdjustSpacingToFitHorizontally(int &lineWidth, int maxSpacing, int charactersInLine, int availableWidth)
+{
+	if (lineWidth <= availableWidth || charactersInLine < 2)
+		return maxSpacing;
+
+	const int overhang = lineWidth - availableWidth;
+	const int spacingRedux = (overhang + charactersInLine - 2) / (charactersInLine - 1);
+	lineWidth -= spacingRedux * (charactersInLine - 1);
+	return maxSpacing - spacingRedux;
+}
+
+void LayOutDrawString(TextLayout &layout, string_view text, GameFontTables size)
+{
+	const Rectangle rect { { 0, 0 }, layout.size };
+	const UiFlags flags = layout.flags;
+	int spacing = layout.spacing;
+	const int lineHeight = layout.lineHeight;
+
+	int charactersInLine = 0;
+	int lineWidth = 0;
+	if (HasAnyOf(flags, (UiFlags::AlignCenter | UiFlags::AlignRight | UiFlags::KerningFitSpacing)))
+		lineWidth = GetLineWidth(text, size, spacing, &charactersInLine);
+
+	int maxSpacing = spacing;
+	if (HasAnyOf(flags, UiFlags::KerningFitSpacing))
+		spacing = AdjustSpacingToFitHorizontally(lineWidth, maxSpacing, charactersInLine, rect.size.width);
+
+	Point characterPosition = rect.position;
+	if (HasAnyOf(flags, UiFlags::AlignCenter))
+		characterPosition.x += (rect.size.width - lineWidth) / 2;
+	else if (HasAnyOf(flags, UiFlags::AlignRight))
+		characterPosition.x += rect.size.width - lineWidth;
+
+	int rightMargin = rect.position.x + rect.size.width;
+
+	if (HasAnyOf(flags, UiFlags::VerticalCenter)) {
+		int textHeight = (std::count(text.cbegin(), text.cend(), '\n') + 1) * lineHeight;
+		characterPosition.y += (rect.size.height - textHeight) / 2;
+	}
+
+	characterPosition.y += BaseLineOffset[size];
+
+	layout.result = LayOutString(
+	    text, rect, characterPosition, spacing, lineHeight, lineWidth, rightMargin, flags, size,
+	    [&](Point position, uint16_t row, uint8_t frame) {
+		    layout.glyphs.push_back({ position - rect.position, row, frame });
+	    },
+	    [&](Point position, int result) {
+		    layout.lineBreaks.push_back({ layout.glyphs.size(), position - rect.position, result });
+		    return true;
+	    });
+	layout.end = characterPosition - rect.position;
+}
+
+const TextLayout &GetTextLayout(string_view text, Size size, UiFlags flags, int spacing, int lineHeight)
+{
+	const std::size_t hash = HashTextLayout(text, size, flags, spacing, lineHeight);
+	auto cached = TextLayoutsByHash.find(hash);
+	if (cached != TextLayoutsByHash.end()) {
+		TextLayout &layout = *cached->second;
+		if (string_view(layout.text) == text && layout.size.width == size.width && layout.size.height == size.height
+		    && layout.flags == flags && layout.spacing == spacing && layout.lineHeight == lineHeight) {
+			TextLayouts.splice(TextLayouts.begin(), TextLayouts, cached->second);
+			return layout;
 		}
+		TextLayouts.erase(cached->second);
+		TextLayoutsByHash.erase(cached);
+	}
+
+	if (TextLayouts.size() >= MaxTextLayouts) {
+		TextLayoutsByHash.erase(TextLayouts.back().hash);
+		TextLayouts.pop_back();
+	}
+
+	TextLayouts.emplace_front();
+	TextLayout &layout = TextLayouts.front();
+	layout.hash = hash;
+	layout.text = std::string(text);
+	layout.flags = flags;
+	layout.spacing = spacing;
+	layout.size = size;
+	layout.lineHeight = lineHeight;
+	LayOutDrawString(layout, text, GetSizeFromFlags(flags));
+	TextLayoutsByHash[hash] = TextLayouts.begin();
+	return layout;
+}
+
+} // namespace
+
+#ifdef BUILD_TESTING
+/**
+ * @brief Lays out and draws a string in one pass, like DrawString did before layouts were cached.
+ */
+uint32_t TestDrawStringUncached(const Surface &out, string_view text, const Rectangle &rect, UiFlags flags, int spacing, int lineHeight)
+{
+	GameFontTables size = GetSizeFromFlags(flags);
+	text_color color = GetColorFromFlags(flags);
+
+	int charactersInLine = 0;
+	int lineWidth = 0;
+	if (HasAnyOf(flags, (UiFlags::AlignCenter | UiFlags::AlignRight | UiFlags::KerningFitSpacing)))
+		lineWidth = GetLineWidth(text, size, spacing, &charactersInLine);
+
+	int maxSpacing = spacing;
+	if (HasAnyOf(flags, UiFlags::KerningFitSpacing))
+		spacing = AdjustSpacingToFitHorizontally(lineWidth, maxSpacing, charactersInLine, rect.size.width);
+
+	Point characterPosition = rect.position;
+	if (HasAnyOf(flags, UiFlags::AlignCenter))
+		characterPosition.x += (rect.size.width - lineWidth) / 2;
+	else if (HasAnyOf(flags, UiFlags::AlignRight))
+		characterPosition.x += rect.size.width - lineWidth;
+
+	int rightMargin = rect.position.x + rect.size.width;
+	const int bottomMargin = rect.size.height != 0 ? std::min(rect.position.y + rect.size.height, out.h()) : out.h();
+
+	if (lineHeight == -1)
+		lineHeight = GetLineHeight(text, size);
+
+	if (HasAnyOf(flags, UiFlags::VerticalCenter)) {
+		int textHeight = (std::count(text.cbegin(), text.cend(), '\n') + 1) * lineHeight;
+		characterPosition.y += (rect.size.height - textHeight) / 2;
 	}
+
+	characterPosition.y += BaseLineOffset[size];
+
+	return DoDrawString(out, text, rect, characterPosition, spacing, lineHeight, lineWidth, rightMargin, bottomMargin, flags, size, color);
+}
+#endif
+
+void LoadSmallSelectionSpinner()
+{
+	pSPentSpn2Cels = LoadCel("Data\\PentSpn2.CEL", 12);
+}
+
+void UnloadFonts(text_color color)
+{
+	FontTranslations.erase(color);
 }
 
 void UnloadFonts()
 {
 	Fonts.clear();
+	FontTranslations.clear();
 	FontKerns.clear();
+	TextLayouts.clear();
+	TextLayoutsByHash.clear();
 }
 
 int GetLineWidth(string_view text, GameFontTables size, int spacing, int *charactersInLine)
@@ -512,17 +752,6 @@ int GetLineHeight(string_view text, GameFontTables fontIndex)
 	return LineHeights[fontIndex];
 }
 
-int AdjustSpacingToFitHorizontally(int &lineWidth, int maxSpacing, int charactersInLine, int availableWidth)
-{
-	if (lineWidth <= availableWidth || charactersInLine < 2)
-		return maxSpacing;
-
-	const int overhang = lineWidth - availableWidth;
-	const int spacingRedux = (overhang + charactersInLine - 2) / (charactersInLine - 1);
-	lineWidth -= spacingRedux * (charactersInLine - 1);
-	return maxSpacing - spacingRedux;
-}
-
 std::string WordWrapString(string_view text, unsigned width, GameFontTables size, int spacing)
 {
 	std::string output;
@@ -613,40 +842,36 @@ uint32_t DrawString(const Surface &out, string_view text, const Rectangle &rect,
 	GameFontTables size = GetSizeFromFlags(flags);
 	text_color color = GetColorFromFlags(flags);
 
-	int charactersInLine = 0;
-	int lineWidth = 0;
-	if (HasAnyOf(flags, (UiFlags::AlignCenter | UiFlags::AlignRight | UiFlags::KerningFitSpacing)))
-		lineWidth = GetLineWidth(text, size, spacing, &charactersInLine);
-
-	int maxSpacing = spacing;
-	if (HasAnyOf(flags, UiFlags::KerningFitSpacing))
-		spacing = AdjustSpacingToFitHorizontally(lineWidth, maxSpacing, charactersInLine, rect.size.width);
-
-	Point characterPosition = rect.position;
-	if (HasAnyOf(flags, UiFlags::AlignCenter))
-		characterPosition.x += (rect.size.width - lineWidth) / 2;
-	else if (HasAnyOf(flags, UiFlags::AlignRight))
-		characterPosition.x += rect.size.width - lineWidth;
-
-	int rightMargin = rect.position.x + rect.size.width;
 	const int bottomMargin = rect.size.height != 0 ? std::min(rect.position.y + rect.size.height, out.h()) : out.h();
 
 	if (lineHeight == -1)
 		lineHeight = GetLineHeight(text, size);
 
-	if (HasAnyOf(flags, UiFlags::VerticalCenter)) {
-		int textHeight = (std::count(text.cbegin(), text.cend(), '\n') + 1) * lineHeight;
-		characterPosition.y += (rect.size.height - textHeight) / 2;
+	const TextLayout &layout = GetTextLayout(text, rect.size, flags, spacing, lineHeight);
+
+	std::size_t glyphsEnd = layout.glyphs.size();
+	Point characterPosition = rect.position + layout.end;
+	int bytesDrawn = layout.result;
+	for (const TextLineBreak &lineBreak : layout.lineBreaks) {
+		const Point breakPosition = rect.position + lineBreak.offset;
+		if (breakPosition.y + lineHeight >= bottomMargin) {
+			glyphsEnd = lineBreak.glyph;
+			characterPosition = breakPosition;
+			bytesDrawn = lineBreak.result;
+			break;
+		}
 	}
 
-	characterPosition.y += BaseLineOffset[size];
-
-	const int bytesDrawn = DoDrawString(out, text, rect, characterPosition, spacing, lineHeight, lineWidth, rightMargin, bottomMargin, flags, size, color);
+	GlyphDrawer drawGlyph { out, size, color };
+	for (std::size_t i = 0; i < glyphsEnd; i++) {
+		const PlacedGlyph &glyph = layout.glyphs[i];
+		drawGlyph(rect.position + glyph.offset, glyph.row, glyph.frame);
+	}
 
 	if (HasAnyOf(flags, UiFlags::PentaCursor)) {
 		CelDrawTo(out, characterPosition + Displacement { 0, lineHeight - BaseLineOffset[size] }, *pSPentSpn2Cels, PentSpn2Spin());
 	} else if (HasAnyOf(flags, UiFlags::TextCursor) && GetAnimationFrame(2, 500) != 0) {
-		DrawFont(out, characterPosition, LoadFont(size, color, 0), '|');
+		DrawFont(out, characterPosition, LoadFont(size, 0), '|', LoadFontTranslation(color));
 	}
 
 	return bytesDrawn;
@@ -685,6 +910,7 @@ void DrawStringWithColors(const Surface &out, string_view fmt, DrawStringFormatA
 
 	characterPosition.y += BaseLineOffset[size];
 
+	uint8_t *translation = LoadFontTranslation(color);
 	Font *font = nullptr;
 	std::array<uint8_t, 256> *kerning = nullptr;
 
@@ -718,7 +944,7 @@ void DrawStringWithColors(const Surface &out, string_view fmt, DrawStringFormatA
 		const uint32_t unicodeRow = GetUnicodeRow(next);
 		if (unicodeRow != currentUnicodeRow || font == nullptr) {
 			kerning = LoadFontKerning(size, unicodeRow);
-			font = LoadFont(size, color, unicodeRow);
+			font = LoadFont(size, unicodeRow);
 			currentUnicodeRow = unicodeRow;
 		}
 
@@ -746,7 +972,7 @@ void DrawStringWithColors(const Surface &out, string_view fmt, DrawStringFormatA
 			}
 		}
 
-		DrawFont(out, characterPosition, font, frame);
+		DrawFont(out, characterPosition, font, frame, translation);
 		characterPosition.x += (*kerning)[frame] + spacing;
 		prev = next;
 	}
@@ -754,7 +980,7 @@ void DrawStringWithColors(const Surface &out, string_view fmt, DrawStringFormatA
 	if (HasAnyOf(flags, UiFlags::PentaCursor)) {
 		CelDrawTo(out, characterPosition + Displacement { 0, lineHeight - BaseLineOffset[size] }, *pSPentSpn2Cels, PentSpn2Spin());
 	} else if (HasAnyOf(flags, UiFlags::TextCursor) && GetAnimationFrame(2, 500) != 0) {
-		DrawFont(out, characterPosition, LoadFont(size, color, 0), '|');
+		DrawFont(out, characterPosition, LoadFont(size, 0), '|', translation);
 	}
 }
 
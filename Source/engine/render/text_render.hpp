@@ -127,7 +127,10 @@ extern std::optional<OwnedCelSprite> pSPentSpn2Cels;
 
 void LoadSmallSelectionSpinner();
 
-void UnloadFonts(GameFontTables size, text_color color);
+/**
+ * @brief Frees the palette translation of a text color, the glyphs are shared with the other colors and stay loaded.
+ */
+void UnloadFonts(text_color color);
 
 /**
  * @brief Calculate pixel width of first line of text, respecting kerning
@@ -11,7 +11,9 @@
 #include "engine/random.hpp"
 #include "init.h"
 #include "lighting.h"
+#include "line_of_sight.h"
 #include "options.h"
+#include "path_field.h"
 
 namespace devilution {
 
@@ -375,6 +377,7 @@ void FindTransparencyValues(Point floor, uint8_t floorID)
 
 void FillSolidBlockTbls()
 {
+	InvalidateLineOfSight();
 	size_t tileCount;
 	auto pSBFile = LoadLevelSOLData(tileCount);
 
@@ -391,6 +394,9 @@ void FillSolidBlockTbls()
 
 void SetDungeonMicros()
 {
+	InvalidateVision();
+	InvalidatePathFields();
+	InvalidateLineOfSight();
 	MicroTileLen = 10;
 	int blocks = 10;
 
@@ -150,7 +150,7 @@ extern int setpc_h;
 extern std::unique_ptr<uint16_t[]> pSetPiece;
 /** Specifies whether a single player quest DUN has been loaded. */
 extern bool setloadflag;
-extern std::optional<OwnedCelSprite> pSpecialCels;
+extern DVL_API_FOR_TEST std::optional<OwnedCelSprite> pSpecialCels;
 /** Specifies the tile definitions of the active dungeon type; (e.g. levels/l1data/l1.til). */
 extern DVL_API_FOR_TEST std::unique_ptr<MegaTile[]> pMegaTiles;
 extern std::unique_ptr<uint16_t[]> pLevelPieces;
@@ -162,7 +162,7 @@ extern std::array<uint8_t, MAXTILES + 1> block_lvid;
 /**
  * List of light blocking dPieces
  */
-extern std::array<bool, MAXTILES + 1> nBlockTable;
+extern DVL_API_FOR_TEST std::array<bool, MAXTILES + 1> nBlockTable;
 /**
  * List of path blocking dPieces
  */
@@ -170,11 +170,11 @@ extern DVL_API_FOR_TEST std::array<bool, MAXTILES + 1> nSolidTable;
 /**
  * List of transparent dPieces
  */
-extern std::array<bool, MAXTILES + 1> nTransTable;
+extern DVL_API_FOR_TEST std::array<bool, MAXTILES + 1> nTransTable;
 /**
  * List of missile blocking dPieces
  */
-extern std::array<bool, MAXTILES + 1> nMissileTable;
+extern DVL_API_FOR_TEST std::array<bool, MAXTILES + 1> nMissileTable;
 extern std::array<bool, MAXTILES + 1> nTrapTable;
 /** Specifies the minimum X,Y-coordinates of the map. */
 extern Point dminPosition;
@@ -192,29 +192,29 @@ extern dungeon_type setlvltype;
 /** Specifies the player viewpoint X,Y-coordinates of the map. */
 extern DVL_API_FOR_TEST Point ViewPosition;
 extern ScrollStruct ScrollInfo;
-extern int MicroTileLen;
-extern char TransVal;
+extern DVL_API_FOR_TEST int MicroTileLen;
+extern DVL_API_FOR_TEST char TransVal;
 /** Specifies the active transparency indices. */
-extern bool TransList[256];
+extern DVL_API_FOR_TEST bool TransList[256];
 /** Contains the piece IDs of each tile on the map. */
 extern DVL_API_FOR_TEST int dPiece[MAXDUNX][MAXDUNY];
 /** Specifies the dungeon piece information for a given coordinate and block number. */
-extern MICROS dpiece_defs_map_2[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST MICROS dpiece_defs_map_2[MAXDUNX][MAXDUNY];
 /** Specifies the transparency at each coordinate of the map. */
 extern DVL_API_FOR_TEST int8_t dTransVal[MAXDUNX][MAXDUNY];
 extern DVL_API_FOR_TEST char dLight[MAXDUNX][MAXDUNY];
-extern char dPreLight[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST char dPreLight[MAXDUNX][MAXDUNY];
 /** Holds various information about dungeon tiles, @see DungeonFlag */
-extern DungeonFlag dFlags[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST DungeonFlag dFlags[MAXDUNX][MAXDUNY];
 
 /** Contains the player numbers (players array indices) of the map. */
-extern int8_t dPlayer[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST int8_t dPlayer[MAXDUNX][MAXDUNY];
 /**
  * Contains the NPC numbers of the map. The NPC number represents a
  * towner number (towners array index) in Tristram and a monster number
  * (monsters array index) in the dungeon.
  */
-extern int16_t dMonster[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST int16_t dMonster[MAXDUNX][MAXDUNY];
 /**
  * Contains the dead numbers (deads array indices) and dead direction of
  * the map, encoded as specified by the pseudo-code below.
@@ -229,7 +229,7 @@ extern DVL_API_FOR_TEST int8_t dObject[MAXDUNX][MAXDUNY];
  * (e.g. "levels/l1data/l1s.cel"). Note, the special tileset of Tristram (i.e.
  * "levels/towndata/towns.cel") contains trees rather than arches.
  */
-extern char dSpecial[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST char dSpecial[MAXDUNX][MAXDUNY];
 extern int themeCount;
 extern THEME_LOC themeLoc[MAXTHEMES];
 
@@ -132,6 +132,7 @@ void init_cleanup()
 		pfile_write_hero(/*writeGameData=*/false, /*clearTables=*/true);
 		sfile_write_stash();
 	}
+	pfile_wait_for_saves();
 
 	spawn_mpq = std::nullopt;
 	diabdat_mpq = std::nullopt;
@@ -144,6 +145,7 @@ void init_cleanup()
 	lang_mpq = std::nullopt;
 	font_mpq = std::nullopt;
 	devilutionx_mpq = std::nullopt;
+	InvalidateAssetIndex();
 
 	NetClose();
 }
@@ -157,6 +159,7 @@ void LoadCoreArchives()
 	devilutionx_mpq = LoadMPQ(paths, "devilutionx.mpq");
 #endif
 	font_mpq = LoadMPQ(paths, "fonts.mpq"); // Extra fonts
+	InvalidateAssetIndex();
 }
 
 void LoadLanguageArchive()
@@ -171,6 +174,7 @@ void LoadLanguageArchive()
 		auto paths = GetMPQSearchPaths();
 		lang_mpq = LoadMPQ(paths, langMpqName);
 	}
+	InvalidateAssetIndex();
 }
 
 void LoadGameArchives()
@@ -188,6 +192,7 @@ void LoadGameArchives()
 		if (spawn_mpq)
 			gbIsSpawn = true;
 	}
+	InvalidateAssetIndex();
 	SDL_RWops *handle = OpenAsset("ui_art\\title.pcx");
 	if (handle == nullptr) {
 		LogError("{}", SDL_GetError());
@@ -210,6 +215,7 @@ void LoadGameArchives()
 		gbBarbarian = true;
 	hfmusic_mpq = LoadMPQ(paths, "hfmusic.mpq");
 	hfvoice_mpq = LoadMPQ(paths, "hfvoice.mpq");
+	InvalidateAssetIndex();
 
 	if (gbIsHellfire && (!hfmonk_mpq || !hfmusic_mpq || !hfvoice_mpq)) {
 		UiErrorOkDialog(_("Some Hellfire MPQs are missing").c_str(), _("Not all Hellfire MPQs were found.\nPlease copy all the hf*.mpq files.").c_str());
@@ -5,6 +5,9 @@
  */
 
 #include <cstdint>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "DiabloUI/art_draw.h"
 #include "control.h"
@@ -13,6 +16,7 @@
 #include "engine/cel_sprite.hpp"
 #include "engine/load_cel.hpp"
 #include "engine/render/cel_render.hpp"
+#include "engine/render/text_render.hpp"
 #include "hwcursor.hpp"
 #include "init.h"
 #include "loadsave.h"
@@ -38,6 +42,32 @@ const int BarPos[3][2] = { { 53, 37 }, { 53, 421 }, { 53, 37 } };
 
 Art ArtCutsceneWidescreen;
 
+#ifdef _DEBUG
+struct LoadingStageTime {
+	const char *name;
+	double milliseconds;
+};
+
+/** Stages of loading the current level that have finished, in order. */
+std::vector<LoadingStageTime> LoadingStageTimes;
+
+void DrawLoadingStageTimes(const Surface &out, Point position)
+{
+	constexpr int LineHeight = 12;
+	for (const LoadingStageTime &stage : LoadingStageTimes) {
+		DrawString(out, fmt::format("{}: {:.1f} ms", stage.name, stage.milliseconds), position, UiFlags::ColorWhite);
+		position.y += LineHeight;
+	}
+
+	SDL_Rect rect = MakeSdlRect(
+	    out.region.x + position.x,
+	    out.region.y + position.y - LineHeight * static_cast<int>(LoadingStageTimes.size()),
+	    300,
+	    LineHeight * static_cast<int>(LoadingStageTimes.size()));
+	BltFast(&rect, &rect);
+}
+#endif
+
 void FreeInterface()
 {
 	sgpBackCel = std::nullopt;
@@ -166,6 +196,9 @@ void InitCutscene(interface_mode uMsg)
 	LoadPalette(palPath);
 
 	sgdwProgress = 0;
+#ifdef _DEBUG
+	LoadingStageTimes.clear();
+#endif
 }
 
 void DrawCutscene()
@@ -184,6 +217,9 @@ void DrawCutscene()
 	SDL_FillRect(out.surface, &rect, BarColor[progress_id]);
 
 	BltFast(&rect, &rect);
+#ifdef _DEBUG
+	DrawLoadingStageTimes(out, uiRectangle.position + Displacement { BarPos[0][0], 65 });
+#endif
 	RenderPresent();
 }
 
@@ -212,6 +248,13 @@ bool IncProgress()
 	return sgdwProgress >= 534;
 }
 
+void AddLoadingStageTime([[maybe_unused]] const char *name, [[maybe_unused]] std::chrono::steady_clock::duration time)
+{
+#ifdef _DEBUG
+	LoadingStageTimes.push_back({ name, std::chrono::duration<double, std::milli>(time).count() });
+#endif
+}
+
 void ShowProgress(interface_mode uMsg)
 {
 	WNDPROC saveProc;
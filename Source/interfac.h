@@ -5,6 +5,7 @@
  */
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 
 #include "utils/ui_fwd.h"
@@ -47,4 +48,33 @@ void interface_msg_pump();
 bool IncProgress();
 void ShowProgress(interface_mode uMsg);
 
+/**
+ * @brief Records how long a stage of loading the level took, debug builds list them on the progress screen.
+ */
+void AddLoadingStageTime(const char *name, std::chrono::steady_clock::duration time);
+
+/**
+ * @brief Records the time until the end of the scope as a stage of loading the level.
+ */
+class LoadingStage {
+public:
+	explicit LoadingStage(const char *name)
+	    : name_(name)
+	    , start_(std::chrono::steady_clock::now())
+	{
+	}
+
+	LoadingStage(const LoadingStage &) = delete;
+	LoadingStage &operator=(const LoadingStage &) = delete;
+
+	~LoadingStage()
+	{
+		AddLoadingStageTime(name_, std::chrono::steady_clock::now() - start_);
+	}
+
+private:
+	const char *name_;
+	std::chrono::steady_clock::time_point start_;
+};
+
 } // namespace devilution
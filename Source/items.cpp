@@ -2669,15 +2669,13 @@ void CalcPlrItemVals(Player &player, bool loadgfx)
 	int gfxNum = static_cast<int>(animWeaponId) | static_cast<int>(animArmorId);
 	if (player._pgfxnum != gfxNum && loadgfx) {
 		player._pgfxnum = gfxNum;
-		ResetPlayerGFX(player);
+		ChangePlayerGFX(player);
 		SetPlrAnims(player);
 		player.previewCelSprite = std::nullopt;
 		if (player._pmode == PM_STAND) {
-			LoadPlrGFX(player, player_graphic::Stand);
-			player.AnimInfo.ChangeAnimationData(player.AnimationData[static_cast<size_t>(player_graphic::Stand)].GetCelSpritesForDirection(player._pdir), player._pNFrames, 4);
+			player.AnimInfo.ChangeAnimationData(GetPlayerSprite(player, player_graphic::Stand, player._pdir), player._pNFrames, 4);
 		} else {
-			LoadPlrGFX(player, player_graphic::Walk);
-			player.AnimInfo.ChangeAnimationData(player.AnimationData[static_cast<size_t>(player_graphic::Walk)].GetCelSpritesForDirection(player._pdir), player._pWFrames, 1);
+			player.AnimInfo.ChangeAnimationData(GetPlayerSprite(player, player_graphic::Walk, player._pdir), player._pWFrames, 1);
 		}
 	} else {
 		player._pgfxnum = gfxNum;
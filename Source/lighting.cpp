@@ -6,9 +6,11 @@
 #include "lighting.h"
 
 #include <algorithm>
+#include <bitset>
 
 #include "automap.h"
 #include "diablo.h"
+#include "engine/dirty_region.hpp"
 #include "engine/load_file.hpp"
 #include "player.h"
 
@@ -452,10 +454,65 @@ namespace {
 uint8_t lightradius[16][128];
 bool dovision;
 uint8_t lightblock[64][16][16];
+/** Largest distance from its tile at which a light of the given radius can brighten the light map. */
+int lightreach[16];
+
+/** Area of the light map that each light was last applied to, empty if the light isn't applied. */
+Rectangle LitAreas[MAXLIGHTS];
+/** Set when dLight has to be rebuilt from dPreLight and all lights instead of updating only what changed. */
+bool RebuildLightMap = true;
 
 /** RadiusAdj maps from VisionCrawlTable index to lighting vision radius adjustment. */
 const BYTE RadiusAdj[23] = { 0, 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 4, 3, 2, 2, 2, 1, 1, 1, 0, 0, 0, 0 };
 
+/** Largest vision radius that ProcessVisionList handles with the precomputed rays. */
+constexpr int MaxVisionRayLength = 15;
+/** Border around VisionMap so that rays starting inside the dungeon never leave the map. */
+constexpr int VisionMapPadding = MaxVisionRayLength + 1;
+constexpr int VisionMapStride = MAXDUNY + 2 * VisionMapPadding;
+
+enum class VisionOpacity : uint8_t {
+	Open,
+	Blocking,
+	OutsideDungeon,
+};
+
+/** nBlockTable of the piece on every tile, with a border of OutsideDungeon. Indexed by GetVisionMapIndex. */
+VisionOpacity VisionMap[(MAXDUNX + 2 * VisionMapPadding) * VisionMapStride];
+/** Cleared when dPiece changes, VisionMap is then rebuilt by the next ProcessVisionList. */
+bool VisionMapValid;
+
+struct VisionStep {
+	/** Tile of the step relative to the origin of the vision. */
+	Displacement offset;
+	/** Offset of the tile in VisionMap. */
+	int mapOffset;
+	/** VisionMap offsets relative to the step of the two tiles that the step can be seen through. */
+	int adjacent1;
+	int adjacent2;
+};
+
+/** The steps of DoVision for each quadrant and each line of VisionCrawlTable. */
+VisionStep VisionRays[4][23][MaxVisionRayLength];
+bool VisionRaysInitialized;
+
+/** What a vision applied in the previous ProcessVisionList, used to skip visions that would change nothing. */
+struct VisionCache {
+	bool valid;
+	Point position;
+	int radius;
+	MapExplorationType doautomap;
+	bool visible;
+	/** Set when a tile was explored before it had any flags, applying the vision again would add it to the automap. */
+	bool automapDeferred;
+	std::bitset<256> transList;
+};
+
+/** Cache for each entry of VisionList. */
+VisionCache VisionCaches[MAXVISION];
+/** Areas that DoUnVision cleared since the last ProcessVisionList. */
+DirtyRegion UnVisionedArea;
+
 void RotateRadius(int *x, int *y, int *dx, int *dy, int *lx, int *ly, int *bx, int *by)
 {
 	*bx = 0;
@@ -497,28 +554,246 @@ char GetLight(Point position)
 	return dLight[position.x][position.y];
 }
 
-void DoUnLight(int nXPos, int nYPos, int nRadius)
+/**
+ * @brief Returns the part of the light map that DoLighting can change for the given light.
+ */
+Rectangle GetLitArea(const Light &light)
 {
-	nRadius++;
+	Point position = light.position.tile;
+	// Mirrors the adjustment for negative offsets in DoLighting
+	if (light.position.offset.deltaX < 0)
+		position.x--;
+	if (light.position.offset.deltaY < 0)
+		position.y--;
+
+	const int reach = lightreach[light._lradius];
+	const int minX = std::max(position.x - reach, 0);
+	const int minY = std::max(position.y - reach, 0);
+	const int maxX = std::min(position.x + reach + 1, MAXDUNX);
+	const int maxY = std::min(position.y + reach + 1, MAXDUNY);
+	if (minX >= maxX || minY >= maxY)
+		return {};
+	return { { minX, minY }, { maxX - minX, maxY - minY } };
+}
+
+bool Overlaps(const Rectangle &a, const DirtyRegion &region)
+{
+	for (const Rectangle &b : region.Rects()) {
+		if (a.position.x < b.position.x + b.size.width && b.position.x < a.position.x + a.size.width
+		    && a.position.y < b.position.y + b.size.height && b.position.y < a.position.y + a.size.height)
+			return true;
+	}
+	return false;
+}
+
+void ApplyLight(int lid)
+{
+	const Light &light = Lights[lid];
+	DoLighting(light.position.tile, light._lradius, lid);
+	LitAreas[lid] = GetLitArea(light);
+}
+
+/**
+ * @brief Resets the given area of the light map to the static lighting of the level.
+ */
+void UnLightArea(const Rectangle &area)
+{
+	for (int x = area.position.x; x < area.position.x + area.size.width; x++) {
+		memcpy(&dLight[x][area.position.y], &dPreLight[x][area.position.y], area.size.height);
+	}
+}
+
+void RebuildLighting()
+{
+	memcpy(dLight, dPreLight, sizeof(dLight));
+	for (int i = 0; i < ActiveLightCount; i++) {
+		const int lid = ActiveLights[i];
+		Lights[lid]._lunflag = false;
+		if (!Lights[lid]._ldel)
+			ApplyLight(lid);
+	}
+}
+
+/**
+ * @brief Restores the areas of lights that moved, changed or were removed, then reapplies the lights that touch them.
+ */
+void UpdateChangedLights()
+{
+	DirtyRegion dirty;
+	bool changed[MAXLIGHTS] = {};
+	for (int i = 0; i < ActiveLightCount; i++) {
+		const int lid = ActiveLights[i];
+		Light &light = Lights[lid];
+		if (!light._ldel && !light._lunflag && LitAreas[lid].size.width != 0)
+			continue;
+		changed[lid] = true;
+		dirty.Add(LitAreas[lid]);
+		light._lunflag = false;
+	}
+
+	for (const Rectangle &area : dirty.Rects())
+		UnLightArea(area);
+
+	for (int i = 0; i < ActiveLightCount; i++) {
+		const int lid = ActiveLights[i];
+		if (!Lights[lid]._ldel && (changed[lid] || Overlaps(LitAreas[lid], dirty)))
+			ApplyLight(lid);
+	}
+}
+
+int GetVisionMapIndex(Point position)
+{
+	return (position.x + VisionMapPadding) * VisionMapStride + position.y + VisionMapPadding;
+}
+
+/**
+ * @brief Flattens VisionCrawlTable into the steps taken by each ray of DoVision.
+ */
+void InitVisionRays()
+{
+	for (int v = 0; v < 4; v++) {
+		for (int j = 0; j < 23; j++) {
+			for (int k = 0; k < MaxVisionRayLength; k++) {
+				const int x = VisionCrawlTable[j][k * 2];
+				const int y = VisionCrawlTable[j][k * 2 + 1];
+				const bool diagonal = x > 0 && y > 0;
+				Displacement offset;
+				Displacement adjacent1 { 0, 0 };
+				Displacement adjacent2 { 0, 0 };
+				switch (v) {
+				case 0:
+					offset = { x, y };
+					if (diagonal) {
+						adjacent1 = { -1, 0 };
+						adjacent2 = { 0, -1 };
+					}
+					break;
+				case 1:
+					offset = { -x, -y };
+					if (diagonal) {
+						adjacent1 = { 0, 1 };
+						adjacent2 = { 1, 0 };
+					}
+					break;
+				case 2:
+					offset = { x, -y };
+					if (diagonal) {
+						adjacent1 = { -1, 0 };
+						adjacent2 = { 0, 1 };
+					}
+					break;
+				case 3:
+					offset = { -x, y };
+					if (diagonal) {
+						adjacent1 = { 0, -1 };
+						adjacent2 = { 1, 0 };
+					}
+					break;
+				}
+				VisionStep &step = VisionRays[v][j][k];
+				step.offset = offset;
+				step.mapOffset = offset.deltaX * VisionMapStride + offset.deltaY;
+				step.adjacent1 = adjacent1.deltaX * VisionMapStride + adjacent1.deltaY;
+				step.adjacent2 = adjacent2.deltaX * VisionMapStride + adjacent2.deltaY;
+			}
+		}
+	}
+	VisionRaysInitialized = true;
+}
 
-	int minX = nXPos - nRadius;
-	int maxX = nXPos + nRadius;
-	int minY = nYPos - nRadius;
-	int maxY = nYPos + nRadius;
+void BuildVisionMap()
+{
+	if (!VisionRaysInitialized)
+		InitVisionRays();
 
-	minX = std::max(minX, 0);
-	maxX = std::max(maxX, MAXDUNX);
-	minY = std::max(minY, 0);
-	maxY = std::max(maxY, MAXDUNY);
+	std::fill(std::begin(VisionMap), std::end(VisionMap), VisionOpacity::OutsideDungeon);
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			VisionMap[GetVisionMapIndex({ x, y })] = nBlockTable[dPiece[x][y]] ? VisionOpacity::Blocking : VisionOpacity::Open;
+		}
+	}
+	for (VisionCache &cache : VisionCaches)
+		cache.valid = false;
+	VisionMapValid = true;
+}
 
-	for (int y = minY; y < maxY; y++) {
-		for (int x = minX; x < maxX; x++) {
-			if (InDungeonBounds({ x, y }))
-				dLight[x][y] = dPreLight[x][y];
+void MarkVisionTile(Point tile, MapExplorationType doautomap, bool visible, VisionCache &cache)
+{
+	DungeonFlag &flags = dFlags[tile.x][tile.y];
+	if (doautomap != MAP_EXP_NONE) {
+		if (flags != DungeonFlag::None) {
+			SetAutomapView(tile, doautomap);
+		} else {
+			cache.automapDeferred = true;
+		}
+		flags |= DungeonFlag::Explored;
+	}
+	if (visible) {
+		flags |= DungeonFlag::Lit;
+	}
+	flags |= DungeonFlag::Visible;
+}
+
+/**
+ * @brief Same as DoVision but using VisionMap and VisionRays, also records the result in the cache.
+ *
+ * The position has to be inside the dungeon and the radius at most MaxVisionRayLength.
+ */
+void ApplyVision(Point position, int nRadius, MapExplorationType doautomap, bool visible, VisionCache &cache)
+{
+	cache.valid = true;
+	cache.position = position;
+	cache.radius = nRadius;
+	cache.doautomap = doautomap;
+	cache.visible = visible;
+	cache.automapDeferred = false;
+	cache.transList.reset();
+
+	MarkVisionTile(position, doautomap, visible, cache);
+
+	const VisionOpacity *origin = &VisionMap[GetVisionMapIndex(position)];
+	for (int v = 0; v < 4; v++) {
+		for (int j = 0; j < 23; j++) {
+			const int steps = std::min(nRadius - RadiusAdj[j], MaxVisionRayLength);
+			for (int k = 0; k < steps; k++) {
+				const VisionStep &step = VisionRays[v][j][k];
+				const VisionOpacity *crawl = origin + step.mapOffset;
+				if (*crawl == VisionOpacity::OutsideDungeon)
+					continue;
+				const bool blocker = *crawl == VisionOpacity::Blocking;
+				if (crawl[step.adjacent1] == VisionOpacity::Open || crawl[step.adjacent2] == VisionOpacity::Open) {
+					const Point tile = position + step.offset;
+					MarkVisionTile(tile, doautomap, visible, cache);
+					if (!blocker) {
+						int8_t nTrans = dTransVal[tile.x][tile.y];
+						if (nTrans != 0) {
+							TransList[nTrans] = true;
+							cache.transList.set(static_cast<uint8_t>(nTrans));
+						}
+					}
+				}
+				if (blocker)
+					break;
+			}
 		}
 	}
 }
 
+/**
+ * @brief Checks if applying the vision again would leave dFlags and the automap unchanged.
+ */
+bool CanReuseVision(const VisionCache &cache, const Light &vision, MapExplorationType doautomap)
+{
+	if (!cache.valid || cache.automapDeferred)
+		return false;
+	if (cache.position != vision.position.tile || cache.radius != vision._lradius || cache.doautomap != doautomap || cache.visible != vision._lflags)
+		return false;
+
+	const int reach = cache.radius;
+	const Rectangle area { cache.position - Displacement { reach, reach }, { 2 * reach + 1, 2 * reach + 1 } };
+	return !Overlaps(area, UnVisionedArea);
+}
+
 } // namespace
 
 void DoLighting(Point position, int nRadius, int lnum)
@@ -607,6 +882,7 @@ void DoUnVision(Point position, int nRadius)
 			dFlags[i][j] &= ~(DungeonFlag::Visible | DungeonFlag::Lit);
 		}
 	}
+	UnVisionedArea.Add({ { x1, y1 }, { x2 - x1, y2 - y1 } });
 }
 
 void DoVision(Point position, int nRadius, MapExplorationType doautomap, bool visible)
@@ -845,6 +1121,11 @@ void MakeLightTable()
 		*tbl++ = 0;
 	}
 
+	MakeLightRadiusTables();
+}
+
+void MakeLightRadiusTables()
+{
 	for (int j = 0; j < 16; j++) {
 		for (int i = 0; i < 128; i++) {
 			if (i > (j + 1) * 8) {
@@ -881,6 +1162,20 @@ void MakeLightTable()
 			}
 		}
 	}
+
+	// Tiles at block distance k, l are at most max(k, l) tiles away from the light.
+	// Values of LightsMax don't change the light map since it is never darker than that.
+	for (int r = 0; r < 16; r++) {
+		lightreach[r] = 0;
+		for (const auto &block : lightblock) {
+			for (int k = 0; k < 16; k++) {
+				for (int l = 0; l < 16; l++) {
+					if (block[k][l] < 128 && lightradius[r][block[k][l]] < LightsMax)
+						lightreach[r] = std::max({ lightreach[r], k, l });
+				}
+			}
+		}
+	}
 }
 
 #ifdef _DEBUG
@@ -899,6 +1194,7 @@ void ToggleLighting()
 			DoLighting(player.position.tile, player._pLightRad, -1);
 		}
 	}
+	RebuildLightMap = true;
 }
 #endif
 
@@ -907,12 +1203,19 @@ void InitLighting()
 	ActiveLightCount = 0;
 	UpdateLighting = false;
 	DisableLighting = false;
+	RebuildLightMap = true;
 
 	for (int i = 0; i < MAXLIGHTS; i++) {
 		ActiveLights[i] = i;
 	}
 }
 
+void InvalidateLighting()
+{
+	RebuildLightMap = true;
+	UpdateLighting = true;
+}
+
 int AddLight(Point position, int r)
 {
 	int lid;
@@ -931,6 +1234,7 @@ int AddLight(Point position, int r)
 		light.position.offset = { 0, 0 };
 		light._ldel = false;
 		light._lunflag = false;
+		LitAreas[lid] = {};
 		UpdateLighting = true;
 	}
 
@@ -1011,26 +1315,16 @@ void ProcessLightList()
 	}
 
 	if (UpdateLighting) {
-		for (int i = 0; i < ActiveLightCount; i++) {
-			Light &light = Lights[ActiveLights[i]];
-			if (light._ldel) {
-				DoUnLight(light.position.tile.x, light.position.tile.y, light._lradius);
-			}
-			if (light._lunflag) {
-				DoUnLight(light.position.old.x, light.position.old.y, light.oldRadius);
-				light._lunflag = false;
-			}
-		}
-		for (int i = 0; i < ActiveLightCount; i++) {
-			int j = ActiveLights[i];
-			Light &light = Lights[j];
-			if (!light._ldel) {
-				DoLighting(light.position.tile, light._lradius, j);
-			}
+		if (RebuildLightMap) {
+			RebuildLighting();
+			RebuildLightMap = false;
+		} else {
+			UpdateChangedLights();
 		}
 		int i = 0;
 		while (i < ActiveLightCount) {
 			if (Lights[ActiveLights[i]]._ldel) {
+				LitAreas[ActiveLights[i]] = {};
 				ActiveLightCount--;
 				std::swap(ActiveLights[ActiveLightCount], ActiveLights[i]);
 			} else {
@@ -1052,12 +1346,19 @@ void InitVision()
 	VisionCount = 0;
 	dovision = false;
 	VisionId = 1;
+	VisionMapValid = false;
+	UnVisionedArea.Clear();
 
 	for (int i = 0; i < TransVal; i++) {
 		TransList[i] = false;
 	}
 }
 
+void InvalidateVision()
+{
+	VisionMapValid = false;
+}
+
 int AddVision(Point position, int r, bool mine)
 {
 	if (VisionCount >= MAXVISION)
@@ -1070,6 +1371,7 @@ int AddVision(Point position, int r, bool mine)
 	vision._ldel = false;
 	vision._lunflag = false;
 	vision._lflags = mine;
+	VisionCaches[VisionCount].valid = false;
 
 	VisionId++;
 	VisionCount++;
@@ -1126,6 +1428,8 @@ void ProcessVisionList()
 	for (int i = 0; i < TransVal; i++) {
 		TransList[i] = false;
 	}
+	if (!VisionMapValid)
+		BuildVisionMap();
 	for (int i = 0; i < VisionCount; i++) {
 		auto &vision = VisionList[i];
 		if (vision._ldel)
@@ -1144,12 +1448,22 @@ void ProcessVisionList()
 				break;
 			}
 		}
-		DoVision(
-		    vision.position.tile,
-		    vision._lradius,
-		    doautomap,
-		    vision._lflags);
+		VisionCache &cache = VisionCaches[i];
+		if (CanReuseVision(cache, vision, doautomap)) {
+			for (int t = 0; t < 256; t++) {
+				if (cache.transList[t])
+					TransList[t] = true;
+			}
+			continue;
+		}
+		if (InDungeonBounds(vision.position.tile) && vision._lradius >= 0 && vision._lradius <= MaxVisionRayLength) {
+			ApplyVision(vision.position.tile, vision._lradius, doautomap, vision._lflags, cache);
+		} else {
+			DoVision(vision.position.tile, vision._lradius, doautomap, vision._lflags);
+			cache.valid = false;
+		}
 	}
+	UnVisionedArea.Clear();
 	bool delflag;
 	do {
 		delflag = false;
@@ -1161,6 +1475,7 @@ void ProcessVisionList()
 			VisionCount--;
 			if (VisionCount > 0 && i != VisionCount) {
 				vision = VisionList[VisionCount];
+				VisionCaches[i] = VisionCaches[VisionCount];
 			}
 			delflag = true;
 		}
@@ -39,12 +39,12 @@ struct Light {
 	bool _lflags;
 };
 
-extern Light VisionList[MAXVISION];
-extern int VisionCount;
+extern DVL_API_FOR_TEST Light VisionList[MAXVISION];
+extern DVL_API_FOR_TEST int VisionCount;
 extern int VisionId;
-extern Light Lights[MAXLIGHTS];
-extern uint8_t ActiveLights[MAXLIGHTS];
-extern int ActiveLightCount;
+extern DVL_API_FOR_TEST Light Lights[MAXLIGHTS];
+extern DVL_API_FOR_TEST uint8_t ActiveLights[MAXLIGHTS];
+extern DVL_API_FOR_TEST int ActiveLightCount;
 constexpr char LightsMax = 15;
 extern std::array<uint8_t, LIGHTSIZE> LightTables;
 extern DVL_API_FOR_TEST bool DisableLighting;
@@ -54,10 +54,20 @@ void DoLighting(Point position, int nRadius, int Lnum);
 void DoUnVision(Point position, int nRadius);
 void DoVision(Point position, int nRadius, MapExplorationType doautomap, bool visible);
 void MakeLightTable();
+/**
+ * @brief Builds the falloff tables used by DoLighting, they depend on the current level.
+ */
+void MakeLightRadiusTables();
 #ifdef _DEBUG
 void ToggleLighting();
 #endif
 void InitLighting();
+/**
+ * @brief Makes the next ProcessLightList rebuild the light map from dPreLight and all lights.
+ *
+ * Used after the light map or the lights were replaced, for example when loading a game.
+ */
+void InvalidateLighting();
 int AddLight(Point position, int r);
 void AddUnLight(int i);
 void ChangeLightRadius(int i, int r);
@@ -67,6 +77,12 @@ void ChangeLight(int i, Point position, int r);
 void ProcessLightList();
 void SavePreLighting();
 void InitVision();
+/**
+ * @brief Makes the next ProcessVisionList read the dungeon layout again and reapply every vision.
+ *
+ * Has to be called whenever dPiece changes or dFlags and the automap are replaced, for example when loading a level.
+ */
+void InvalidateVision();
 int AddVision(Point position, int r, bool mine);
 void ChangeVisionRadius(int id, int r);
 void ChangeVisionXY(int id, Point position);
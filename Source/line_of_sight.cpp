@@ -0,0 +1,83 @@
+/**
+ * @file line_of_sight.cpp
+ *
+ * Implementation of the checks whether a straight line between two tiles is unobstructed.
+ */
+#include "line_of_sight.h"
+
+#include <bitset>
+
+#include "gendung.h"
+#include "monster.h"
+#include "path.h"
+
+namespace devilution {
+
+namespace {
+
+/** One bit per tile, indexed by x * MAXDUNY + y like the dungeon arrays. */
+using TileBits = std::bitset<MAXDUNX * MAXDUNY>;
+
+/** Tiles whose piece is set in nMissileTable */
+TileBits MissileBlockingTiles;
+/** Tiles whose piece is set in nSolidTable */
+TileBits SolidTiles;
+bool TileBitsValid = false;
+
+void BuildTileBits()
+{
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			const int piece = dPiece[x][y];
+			MissileBlockingTiles[x * MAXDUNY + y] = nMissileTable[piece];
+			SolidTiles[x * MAXDUNY + y] = nSolidTable[piece];
+		}
+	}
+	TileBitsValid = true;
+}
+
+const TileBits &GetMissileBlockingTiles()
+{
+	if (!TileBitsValid)
+		BuildTileBits();
+	return MissileBlockingTiles;
+}
+
+const TileBits &GetSolidTiles()
+{
+	if (!TileBitsValid)
+		BuildTileBits();
+	return SolidTiles;
+}
+
+} // namespace
+
+void InvalidateLineOfSight()
+{
+	TileBitsValid = false;
+}
+
+bool LineClearMissile(Point startPoint, Point endPoint)
+{
+	const TileBits &blocking = GetMissileBlockingTiles();
+	return LineClear(
+	    [&blocking](Point position) {
+		    // PosOkMissile doesn't check the bounds, leave lines leaving the map to it
+		    if (!InDungeonBounds(position))
+			    return PosOkMissile(position);
+		    return !blocking[position.x * MAXDUNY + position.y];
+	    },
+	    startPoint, endPoint);
+}
+
+bool IsLineNotSolid(Point startPoint, Point endPoint)
+{
+	const TileBits &solid = GetSolidTiles();
+	return LineClear(
+	    [&solid](Point position) {
+		    return InDungeonBounds(position) && !solid[position.x * MAXDUNY + position.y];
+	    },
+	    startPoint, endPoint);
+}
+
+} // namespace devilution
@@ -0,0 +1,113 @@
+/**
+ * @file line_of_sight.h
+ *
+ * Interface of the checks whether a straight line between two tiles is unobstructed.
+ */
+#pragma once
+
+#include <cstdlib>
+#include <utility>
+
+#include "engine/point.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Walks the Bresenham line between the two points and checks the tiles along it.
+ *
+ * The tile the walk starts from is never checked. The line is always walked with increasing
+ * x or y, so depending on the direction the end point may or may not be checked either.
+ * @param clear Returns whether the line can pass through a tile
+ * @return Whether the walk reached the other end without hitting a blocked tile
+ */
+template <typename F>
+bool LineClear(const F &clear, Point startPoint, Point endPoint)
+{
+	Point position = startPoint;
+
+	int dx = endPoint.x - position.x;
+	int dy = endPoint.y - position.y;
+	if (std::abs(dx) > std::abs(dy)) {
+		if (dx < 0) {
+			std::swap(position, endPoint);
+			dx = -dx;
+			dy = -dy;
+		}
+		int d;
+		int yincD;
+		int dincD;
+		int dincH;
+		if (dy > 0) {
+			d = 2 * dy - dx;
+			dincD = 2 * dy;
+			dincH = 2 * (dy - dx);
+			yincD = 1;
+		} else {
+			d = 2 * dy + dx;
+			dincD = 2 * dy;
+			dincH = 2 * (dx + dy);
+			yincD = -1;
+		}
+		bool done = false;
+		while (!done && position != endPoint) {
+			if ((d <= 0) ^ (yincD < 0)) {
+				d += dincD;
+			} else {
+				d += dincH;
+				position.y += yincD;
+			}
+			position.x++;
+			done = position != startPoint && !clear(position);
+		}
+	} else {
+		if (dy < 0) {
+			std::swap(position, endPoint);
+			dy = -dy;
+			dx = -dx;
+		}
+		int d;
+		int xincD;
+		int dincD;
+		int dincH;
+		if (dx > 0) {
+			d = 2 * dx - dy;
+			dincD = 2 * dx;
+			dincH = 2 * (dx - dy);
+			xincD = 1;
+		} else {
+			d = 2 * dx + dy;
+			dincD = 2 * dx;
+			dincH = 2 * (dy + dx);
+			xincD = -1;
+		}
+		bool done = false;
+		while (!done && position != endPoint) {
+			if ((d <= 0) ^ (xincD < 0)) {
+				d += dincD;
+			} else {
+				d += dincH;
+				position.x += xincD;
+			}
+			position.y++;
+			done = position != startPoint && !clear(position);
+		}
+	}
+	return position == endPoint;
+}
+
+/**
+ * @brief Drops the packed maps of blocking tiles, has to be called whenever dPiece or the piece tables change.
+ */
+void InvalidateLineOfSight();
+
+/**
+ * @brief Same as LineClear(PosOkMissile, startPoint, endPoint), using a packed map of the tiles that block missiles.
+ */
+bool LineClearMissile(Point startPoint, Point endPoint);
+
+/**
+ * @brief Same as LineClear(IsTileNotSolid, startPoint, endPoint), using a packed map of the solid tiles.
+ */
+bool IsLineNotSolid(Point startPoint, Point endPoint);
+
+} // namespace devilution
@@ -24,9 +24,11 @@
 #include "init.h"
 #include "inv.h"
 #include "lighting.h"
+#include "line_of_sight.h"
 #include "menu.h"
 #include "missiles.h"
 #include "mpq/mpq_writer.hpp"
+#include "path_field.h"
 #include "pfile.h"
 #include "qol/stash.h"
 #include "stores.h"
@@ -211,10 +213,7 @@ public:
 
 	~SaveHelper()
 	{
-		const auto encodedLen = codec_get_encoded_len(m_cur_);
-		const char *const password = pfile_get_password();
-		codec_encode(m_buffer_.get(), m_cur_, encodedLen, password);
-		m_mpqWriter.WriteFile(m_szFileName_, m_buffer_.get(), encodedLen);
+		pfile_write_file(m_mpqWriter, m_szFileName_, std::move(m_buffer_), m_cur_);
 	}
 };
 
@@ -1634,13 +1633,8 @@ void SaveAdditionalMissiles()
 	file.WriteLE<uint32_t>(VersionAdditionalMissiles);
 	file.WriteLE<uint32_t>(missileCountAdditional);
 
-	if (missileCountAdditional > 0) {
-		auto it = Missiles.cbegin();
-		// std::list::const_iterator doesn't provide operator+() :/ using std::advance to get past the missiles we've already saved
-		std::advance(it, MaxMissilesForSaveGame);
-		for (; it != Missiles.cend(); it++) {
-			SaveMissile(&file, *it);
-		}
+	for (size_t i = MaxMissilesForSaveGame; i < Missiles.size(); i++) {
+		SaveMissile(&file, Missiles[i]);
 	}
 }
 
@@ -2126,9 +2120,15 @@ void LoadGame(bool firstflag)
 	AutomapZoomReset();
 	ResyncQuests();
 
-	if (leveltype != DTYPE_TOWN)
+	if (leveltype != DTYPE_TOWN) {
+		InvalidateLighting();
 		ProcessLightList();
+	}
 
+	InvalidateVision();
+	InvalidatePathFields();
+	InvalidateLineOfSight();
+	InvalidateGolemMonsters();
 	RedoPlayerVision();
 	ProcessVisionList();
 	// convert stray manashield missiles into pManaShield flag
@@ -2294,12 +2294,8 @@ void SaveGameData()
 		const size_t savedMissiles = std::min(Missiles.size(), MaxMissilesForSaveGame);
 		file.Skip<uint8_t>(savedMissiles);
 		// Write Missile Data
-		{
-			auto missilesEnd = Missiles.cbegin();
-			std::advance(missilesEnd, savedMissiles);
-			for (auto it = Missiles.cbegin(); it != missilesEnd; it++) {
-				SaveMissile(&file, *it);
-			}
+		for (size_t i = 0; i < savedMissiles; i++) {
+			SaveMissile(&file, Missiles[i]);
 		}
 		for (int objectId : ActiveObjects)
 			file.WriteLE(static_cast<int8_t>(objectId));
@@ -2540,11 +2536,15 @@ void LoadLevel()
 		}
 	}
 
+	InvalidateVision();
+	InvalidatePathFields();
+	InvalidateLineOfSight();
+	InvalidateGolemMonsters();
 	if (!gbSkipSync) {
 		AutomapZoomReset();
 		ResyncQuests();
 		RedoMissileFlags();
-		UpdateLighting = true;
+		InvalidateLighting();
 	}
 
 	for (Player &player : Players) {
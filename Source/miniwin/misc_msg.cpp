@@ -20,6 +20,7 @@
 #include "controls/touch/event_handlers.h"
 #endif
 #include "cursor.h"
+#include "dx.h"
 #include "engine/demomode.h"
 #include "engine/rectangle.hpp"
 #include "hwcursor.hpp"
@@ -640,12 +641,15 @@ bool FetchMessage_Real(tagMSG *lpMsg)
 			gbActive = false;
 			break;
 		case SDL_WINDOWEVENT_EXPOSED:
+			InvalidateOutputSurface();
 			lpMsg->message = DVL_WM_PAINT;
 			break;
 		case SDL_WINDOWEVENT_LEAVE:
 			lpMsg->message = DVL_WM_CAPTURECHANGED;
 			break;
 		case SDL_WINDOWEVENT_SIZE_CHANGED:
+			// The window surface is recreated with the new size
+			InvalidateOutputSurface();
 			ReinitializeHardwareCursor();
 			break;
 		case SDL_WINDOWEVENT_MOVED:
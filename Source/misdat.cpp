@@ -5,6 +5,9 @@
  */
 #include "misdat.h"
 
+#include <string>
+#include <vector>
+
 #include "engine/cel_header.hpp"
 #include "engine/load_file.hpp"
 #include "missiles.h"
@@ -248,6 +251,30 @@ void MissileFileData::LoadGFX()
 
 void InitMissileGFX(bool loadHellfireGraphics)
 {
+	const auto shouldLoad = [loadHellfireGraphics](size_t mi) {
+		const MissileFileData &missileData = MissileSpriteData[mi];
+		return (loadHellfireGraphics || mi <= MFILE_SCBSEXPD)
+		    && missileData.flags != MissileDataFlags::MonsterOwned
+		    && missileData.animData == nullptr
+		    && !missileData.name.empty();
+	};
+
+	// Read all the files on the worker threads first, LoadGFX then picks them up in order
+	std::vector<std::string> paths;
+	for (size_t mi = 0; MissileSpriteData[mi].animFAmt != 0; mi++) {
+		if (!shouldLoad(mi))
+			continue;
+		const MissileFileData &missileData = MissileSpriteData[mi];
+		FileNameGenerator pathGenerator({ "Missiles\\", missileData.name }, ".CL2");
+		if (missileData.animFAmt == 1) {
+			paths.emplace_back(pathGenerator());
+		} else {
+			for (size_t i = 0; i < missileData.animFAmt; i++)
+				paths.emplace_back(pathGenerator(i));
+		}
+	}
+	PreloadAssets(paths);
+
 	for (size_t mi = 0; MissileSpriteData[mi].animFAmt != 0; mi++) {
 		if (!loadHellfireGraphics && mi > MFILE_SCBSEXPD)
 			break;
@@ -26,7 +26,7 @@
 
 namespace devilution {
 
-std::list<Missile> Missiles;
+PooledList<Missile> Missiles;
 bool MissilePreFlag;
 
 namespace {
@@ -1184,6 +1184,7 @@ void AddBerserk(Missile &missile, const AddMissileParameter &parameter)
 		auto &monster = Monsters[abs(dMonster[targetMonsterPosition->x][targetMonsterPosition->y]) - 1];
 		int slvl = GetSpellLevel(missile._misource, SPL_BERSERK);
 		monster._mFlags |= MFLAG_BERSERK | MFLAG_GOLEM;
+		InvalidateGolemMonsters();
 		monster.mMinDamage = (GenerateRnd(10) + 120) * monster.mMinDamage / 100 + slvl;
 		monster.mMaxDamage = (GenerateRnd(10) + 120) * monster.mMaxDamage / 100 + slvl;
 		monster.mMinDamage2 = (GenerateRnd(10) + 120) * monster.mMinDamage2 / 100 + slvl;
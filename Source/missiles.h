@@ -6,7 +6,6 @@
 #pragma once
 
 #include <cstdint>
-#include <list>
 
 #include "engine.h"
 #include "engine/point.hpp"
@@ -14,6 +13,7 @@
 #include "misdat.h"
 #include "monster.h"
 #include "spelldat.h"
+#include "utils/pooled_list.hpp"
 
 namespace devilution {
 
@@ -134,7 +134,7 @@ struct Missile {
 	}
 };
 
-extern std::list<Missile> Missiles;
+extern PooledList<Missile> Missiles;
 extern bool MissilePreFlag;
 
 void GetDamageAmt(int i, int *mind, int *maxd);
@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <string>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -26,6 +28,7 @@
 #include "missiles.h"
 #include "movie.h"
 #include "options.h"
+#include "path_field.h"
 #include "spelldat.h"
 #include "storm/storm_net.hpp"
 #include "themes.h"
@@ -65,6 +68,28 @@ int totalmonsters;
 int monstimgtot;
 int uniquetrans;
 
+/** Active monsters flagged with MFLAG_GOLEM, in the order they appear in ActiveMonsters */
+std::vector<int> GolemMonsters;
+/** Value of ActiveMonsterCount when GolemMonsters was built, -1 if it needs to be rebuilt */
+int GolemMonstersActiveCount = -1;
+
+/**
+ * @brief Returns the golems and berserked monsters, the only monsters that ordinary monsters attack.
+ */
+const std::vector<int> &GetGolemMonsters()
+{
+	if (GolemMonstersActiveCount == ActiveMonsterCount)
+		return GolemMonsters;
+
+	GolemMonsters.clear();
+	for (int i = 0; i < ActiveMonsterCount; i++) {
+		if ((Monsters[ActiveMonsters[i]]._mFlags & MFLAG_GOLEM) != 0)
+			GolemMonsters.push_back(ActiveMonsters[i]);
+	}
+	GolemMonstersActiveCount = ActiveMonsterCount;
+	return GolemMonsters;
+}
+
 constexpr std::array<_monster_id, 12> SkeletonTypes {
 	MT_WSKELAX,
 	MT_TSKELAX,
@@ -698,6 +723,7 @@ void DeleteMonster(int i)
 
 	ActiveMonsterCount--;
 	std::swap(ActiveMonsters[i], ActiveMonsters[ActiveMonsterCount]); // This ensures alive monsters are before ActiveMonsterCount in the array and any deleted monster after
+	InvalidateGolemMonsters();
 }
 
 void NewMonsterAnim(Monster &monster, MonsterGraphic graphic, Direction md, AnimationDistributionFlags flags = AnimationDistributionFlags::None, int numSkippedFrames = 0, int distributeFramesBeforeFrame = 0)
@@ -729,77 +755,6 @@ bool IsRanged(Monster &monster)
 	return IsAnyOf(monster._mAi, AI_SKELBOW, AI_GOATBOW, AI_SUCC, AI_LAZHELP);
 }
 
-void UpdateEnemy(Monster &monster)
-{
-	Point target;
-	int menemy = -1;
-	int bestDist = -1;
-	bool bestsameroom = false;
-	const auto &position = monster.position.tile;
-	if ((monster._mFlags & MFLAG_BERSERK) != 0 || (monster._mFlags & MFLAG_GOLEM) == 0) {
-		for (int pnum = 0; pnum < MAX_PLRS; pnum++) {
-			Player &player = Players[pnum];
-			if (!player.plractive || currlevel != player.plrlevel || player._pLvlChanging
-			    || (((player._pHitPoints >> 6) == 0) && gbIsMultiplayer))
-				continue;
-			bool sameroom = (dTransVal[position.x][position.y] == dTransVal[player.position.tile.x][player.position.tile.y]);
-			int dist = position.WalkingDistance(player.position.tile);
-			if ((sameroom && !bestsameroom)
-			    || ((sameroom || !bestsameroom) && dist < bestDist)
-			    || (menemy == -1)) {
-				monster._mFlags &= ~MFLAG_TARGETS_MONSTER;
-				menemy = pnum;
-				target = player.position.future;
-				bestDist = dist;
-				bestsameroom = sameroom;
-			}
-		}
-	}
-	for (int j = 0; j < ActiveMonsterCount; j++) {
-		int mi = ActiveMonsters[j];
-		auto &otherMonster = Monsters[mi];
-		if (&otherMonster == &monster)
-			continue;
-		if ((otherMonster._mhitpoints >> 6) <= 0)
-			continue;
-		if (otherMonster.position.tile == GolemHoldingCell)
-			continue;
-		if (M_Talker(otherMonster) && otherMonster.mtalkmsg != TEXT_NONE)
-			continue;
-		bool isBerserked = (monster._mFlags & MFLAG_BERSERK) != 0 || (otherMonster._mFlags & MFLAG_BERSERK) != 0;
-		if ((monster._mFlags & MFLAG_GOLEM) != 0 && (otherMonster._mFlags & MFLAG_GOLEM) != 0 && !isBerserked) // prevent golems from fighting each other
-			continue;
-
-		int dist = otherMonster.position.tile.WalkingDistance(position);
-		if (((monster._mFlags & MFLAG_GOLEM) == 0
-		        && (monster._mFlags & MFLAG_BERSERK) == 0
-		        && dist >= 2
-		        && !IsRanged(monster))
-		    || ((monster._mFlags & MFLAG_GOLEM) == 0
-		        && (monster._mFlags & MFLAG_BERSERK) == 0
-		        && (otherMonster._mFlags & MFLAG_GOLEM) == 0)) {
-			continue;
-		}
-		bool sameroom = dTransVal[position.x][position.y] == dTransVal[otherMonster.position.tile.x][otherMonster.position.tile.y];
-		if ((sameroom && !bestsameroom)
-		    || ((sameroom || !bestsameroom) && dist < bestDist)
-		    || (menemy == -1)) {
-			monster._mFlags |= MFLAG_TARGETS_MONSTER;
-			menemy = mi;
-			target = otherMonster.position.future;
-			bestDist = dist;
-			bestsameroom = sameroom;
-		}
-	}
-	if (menemy != -1) {
-		monster._mFlags &= ~MFLAG_NO_ENEMY;
-		monster._menemy = menemy;
-		monster.enemyPosition = target;
-	} else {
-		monster._mFlags |= MFLAG_NO_ENEMY;
-	}
-}
-
 /**
  * @brief Make the AI wait a bit before thinking again
  * @param len
@@ -1790,11 +1745,6 @@ void SpawnSkeleton(Point position, Direction dir)
 		StartSpecialStand(Monsters[skel], dir);
 }
 
-bool IsLineNotSolid(Point startPoint, Point endPoint)
-{
-	return LineClear(IsTileNotSolid, startPoint, endPoint);
-}
-
 void FollowTheLeader(Monster &monster)
 {
 	if (monster.leader == 0)
@@ -1948,7 +1898,16 @@ bool AiPlanWalk(int i)
 	assert(i >= 0 && i < MAXMONSTERS);
 	auto &monster = Monsters[i];
 
-	if (FindPath([&monster](Point position) { return IsTileAccessible(monster, position); }, monster.position.tile, monster.enemyPosition, path) == 0) {
+	const auto posOk = [&monster](Point position) { return IsTileAccessible(monster, position); };
+	if (UsePathFields() && (monster._mFlags & MFLAG_TARGETS_MONSTER) == 0 && monster.enemyPosition == Players[monster._menemy].position.future) {
+		const int8_t step = FindPathFieldStep(posOk, monster._menemy, (monster._mFlags & MFLAG_CAN_OPEN_DOOR) != 0, monster.position.tile, monster.enemyPosition);
+		if (step == 0)
+			return false;
+		RandomWalk(i, plr2monst[step]);
+		return true;
+	}
+
+	if (FindPath(posOk, monster.position.tile, monster.enemyPosition, path) == 0) {
 		return false;
 	}
 
@@ -3599,6 +3558,7 @@ void InitLevelMonsters()
 	for (int i = 0; i < MAXMONSTERS; i++) {
 		ActiveMonsters[i] = i;
 	}
+	InvalidateGolemMonsters();
 
 	uniquetrans = 0;
 }
@@ -3701,10 +3661,20 @@ void InitMonsterGFX(int monst)
 		return monsterData.Frames[i] != 0;
 	};
 
+	const FileNameWithCharAffixGenerator pathGenerator({ "Monsters\\", monsterData.GraphicType }, ".CL2", &animletter[0]);
+	std::vector<std::string> paths;
+	for (size_t i = 0; i < numAnims; i++) {
+		if (hasAnim(i))
+			paths.emplace_back(pathGenerator(i));
+	}
+	if (monsterData.has_trans)
+		paths.emplace_back(monsterData.TransFile);
+	PreloadAssets(paths);
+
 	std::array<uint32_t, MaxAnims> animOffsets;
 	monster.animData = MultiFileLoader<MaxAnims> {}(
 	    numAnims,
-	    FileNameWithCharAffixGenerator({ "Monsters\\", monsterData.GraphicType }, ".CL2", &animletter[0]),
+	    pathGenerator,
 	    &animOffsets[0],
 	    hasAnim);
 
@@ -3935,11 +3905,94 @@ void AddDoppelganger(Monster &monster)
 	}
 }
 
+void InvalidateGolemMonsters()
+{
+	GolemMonstersActiveCount = -1;
+}
+
 bool M_Talker(const Monster &monster)
 {
 	return IsAnyOf(monster._mAi, AI_LAZARUS, AI_WARLORD, AI_GARBUD, AI_ZHAR, AI_SNOTSPIL, AI_LACHDAN, AI_LAZHELP);
 }
 
+void UpdateEnemy(Monster &monster)
+{
+	Point target;
+	int menemy = -1;
+	int bestDist = -1;
+	bool bestsameroom = false;
+	const auto &position = monster.position.tile;
+	if ((monster._mFlags & MFLAG_BERSERK) != 0 || (monster._mFlags & MFLAG_GOLEM) == 0) {
+		for (int pnum = 0; pnum < MAX_PLRS; pnum++) {
+			Player &player = Players[pnum];
+			if (!player.plractive || currlevel != player.plrlevel || player._pLvlChanging
+			    || (((player._pHitPoints >> 6) == 0) && gbIsMultiplayer))
+				continue;
+			bool sameroom = (dTransVal[position.x][position.y] == dTransVal[player.position.tile.x][player.position.tile.y]);
+			int dist = position.WalkingDistance(player.position.tile);
+			if ((sameroom && !bestsameroom)
+			    || ((sameroom || !bestsameroom) && dist < bestDist)
+			    || (menemy == -1)) {
+				monster._mFlags &= ~MFLAG_TARGETS_MONSTER;
+				menemy = pnum;
+				target = player.position.future;
+				bestDist = dist;
+				bestsameroom = sameroom;
+			}
+		}
+	}
+	const auto considerMonster = [&](int mi) {
+		auto &otherMonster = Monsters[mi];
+		if (&otherMonster == &monster)
+			return;
+		if ((otherMonster._mhitpoints >> 6) <= 0)
+			return;
+		if (otherMonster.position.tile == GolemHoldingCell)
+			return;
+		if (M_Talker(otherMonster) && otherMonster.mtalkmsg != TEXT_NONE)
+			return;
+		bool isBerserked = (monster._mFlags & MFLAG_BERSERK) != 0 || (otherMonster._mFlags & MFLAG_BERSERK) != 0;
+		if ((monster._mFlags & MFLAG_GOLEM) != 0 && (otherMonster._mFlags & MFLAG_GOLEM) != 0 && !isBerserked) // prevent golems from fighting each other
+			return;
+
+		int dist = otherMonster.position.tile.WalkingDistance(position);
+		if (((monster._mFlags & MFLAG_GOLEM) == 0
+		        && (monster._mFlags & MFLAG_BERSERK) == 0
+		        && dist >= 2
+		        && !IsRanged(monster))
+		    || ((monster._mFlags & MFLAG_GOLEM) == 0
+		        && (monster._mFlags & MFLAG_BERSERK) == 0
+		        && (otherMonster._mFlags & MFLAG_GOLEM) == 0)) {
+			return;
+		}
+		bool sameroom = dTransVal[position.x][position.y] == dTransVal[otherMonster.position.tile.x][otherMonster.position.tile.y];
+		if ((sameroom && !bestsameroom)
+		    || ((sameroom || !bestsameroom) && dist < bestDist)
+		    || (menemy == -1)) {
+			monster._mFlags |= MFLAG_TARGETS_MONSTER;
+			menemy = mi;
+			target = otherMonster.position.future;
+			bestDist = dist;
+			bestsameroom = sameroom;
+		}
+	};
+	if ((monster._mFlags & (MFLAG_GOLEM | MFLAG_BERSERK)) != 0) {
+		for (int j = 0; j < ActiveMonsterCount; j++)
+			considerMonster(ActiveMonsters[j]);
+	} else {
+		// Ordinary monsters only ever attack golems and berserked monsters, checking them in the same order keeps ties resolved the same way
+		for (int mi : GetGolemMonsters())
+			considerMonster(mi);
+	}
+	if (menemy != -1) {
+		monster._mFlags &= ~MFLAG_NO_ENEMY;
+		monster._menemy = menemy;
+		monster.enemyPosition = target;
+	} else {
+		monster._mFlags |= MFLAG_NO_ENEMY;
+	}
+}
+
 void M_StartStand(Monster &monster, Direction md)
 {
 	ClearMVars(monster);
@@ -4426,85 +4479,6 @@ bool PosOkMissile(Point position)
 	return !nMissileTable[dPiece[position.x][position.y]];
 }
 
-bool LineClearMissile(Point startPoint, Point endPoint)
-{
-	return LineClear(PosOkMissile, startPoint, endPoint);
-}
-
-bool LineClear(const std::function<bool(Point)> &clear, Point startPoint, Point endPoint)
-{
-	Point position = startPoint;
-
-	int dx = endPoint.x - position.x;
-	int dy = endPoint.y - position.y;
-	if (abs(dx) > abs(dy)) {
-		if (dx < 0) {
-			std::swap(position, endPoint);
-			dx = -dx;
-			dy = -dy;
-		}
-		int d;
-		int yincD;
-		int dincD;
-		int dincH;
-		if (dy > 0) {
-			d = 2 * dy - dx;
-			dincD = 2 * dy;
-			dincH = 2 * (dy - dx);
-			yincD = 1;
-		} else {
-			d = 2 * dy + dx;
-			dincD = 2 * dy;
-			dincH = 2 * (dx + dy);
-			yincD = -1;
-		}
-		bool done = false;
-		while (!done && position != endPoint) {
-			if ((d <= 0) ^ (yincD < 0)) {
-				d += dincD;
-			} else {
-				d += dincH;
-				position.y += yincD;
-			}
-			position.x++;
-			done = position != startPoint && !clear(position);
-		}
-	} else {
-		if (dy < 0) {
-			std::swap(position, endPoint);
-			dy = -dy;
-			dx = -dx;
-		}
-		int d;
-		int xincD;
-		int dincD;
-		int dincH;
-		if (dx > 0) {
-			d = 2 * dx - dy;
-			dincD = 2 * dx;
-			dincH = 2 * (dx - dy);
-			xincD = 1;
-		} else {
-			d = 2 * dx + dy;
-			dincD = 2 * dx;
-			dincH = 2 * (dy + dx);
-			xincD = -1;
-		}
-		bool done = false;
-		while (!done && position != endPoint) {
-			if ((d <= 0) ^ (xincD < 0)) {
-				d += dincD;
-			} else {
-				d += dincH;
-				position.x += xincD;
-			}
-			position.y++;
-			done = position != startPoint && !clear(position);
-		}
-	}
-	return position == endPoint;
-}
-
 void SyncMonsterAnim(Monster &monster)
 {
 	monster.MType = &LevelMonsterTypes[monster._mMTidx];
@@ -4909,6 +4883,7 @@ void SpawnGolem(int i, Point position, Missile &missile)
 	golem.mMinDamage = 2 * (missile._mispllvl + 4);
 	golem.mMaxDamage = 2 * (missile._mispllvl + 8);
 	golem._mFlags |= MFLAG_GOLEM;
+	InvalidateGolemMonsters();
 	StartSpecialStand(golem, Direction::South);
 	UpdateEnemy(golem);
 	if (i == MyPlayerId) {
@@ -14,11 +14,13 @@
 #include "engine/animationinfo.h"
 #include "engine/cel_sprite.hpp"
 #include "engine/point.hpp"
+#include "line_of_sight.h"
 #include "miniwin/miniwin.h"
 #include "monstdat.h"
 #include "sound.h"
 #include "spelldat.h"
 #include "textdat.h"
+#include "utils/attributes.h"
 #include "utils/stdcompat/optional.hpp"
 
 namespace devilution {
@@ -266,9 +268,9 @@ struct Monster { // note: missing field _mAFNum
 
 extern CMonster LevelMonsterTypes[MAX_LVLMTYPES];
 extern int LevelMonsterTypeCount;
-extern Monster Monsters[MAXMONSTERS];
-extern int ActiveMonsters[MAXMONSTERS];
-extern int ActiveMonsterCount;
+extern DVL_API_FOR_TEST Monster Monsters[MAXMONSTERS];
+extern DVL_API_FOR_TEST int ActiveMonsters[MAXMONSTERS];
+extern DVL_API_FOR_TEST int ActiveMonsterCount;
 extern int MonsterKillCounts[MAXMONSTERS];
 extern bool sgbSaveSoundOn;
 
@@ -282,7 +284,18 @@ void InitMonsters();
 void SetMapMonsters(const uint16_t *dunData, Point startPosition);
 int AddMonster(Point position, Direction dir, int mtype, bool inMap);
 void AddDoppelganger(Monster &monster);
+
+/**
+ * @brief Must be called after MFLAG_GOLEM is set on a monster or ActiveMonsters is reordered without going through DeleteMonster.
+ */
+void InvalidateGolemMonsters();
+
 bool M_Talker(const Monster &monster);
+
+/**
+ * @brief Picks the closest player or monster that the monster should attack, preferring targets in the same room.
+ */
+void UpdateEnemy(Monster &monster);
 void M_StartStand(Monster &monster, Direction md);
 void M_ClearSquares(int i);
 void M_GetKnockback(int i);
@@ -299,8 +312,6 @@ void ProcessMonsters();
 void FreeMonsters();
 bool DirOK(int i, Direction mdir);
 bool PosOkMissile(Point position);
-bool LineClearMissile(Point startPoint, Point endPoint);
-bool LineClear(const std::function<bool(Point)> &clear, Point startPoint, Point endPoint);
 void SyncMonsterAnim(Monster &monster);
 void M_FallenFear(Point position);
 void PrintMonstHistory(int mt);
@@ -98,10 +98,6 @@ static SizeType MpqFileRwRead(struct SDL_RWops *context, void *ptr, SizeType siz
 
 	auto *out = static_cast<uint8_t *>(ptr);
 
-	if (data.blockData == nullptr) {
-		data.blockData = std::unique_ptr<uint8_t[]> { new uint8_t[data.blockSize] };
-	}
-
 	uint32_t blockNumber = data.position / data.blockSize;
 	while (remainingSize > 0) {
 		if (data.position == data.size) {
@@ -109,8 +105,26 @@ static SizeType MpqFileRwRead(struct SDL_RWops *context, void *ptr, SizeType siz
 		}
 
 		const uint32_t currentBlockSize = blockNumber + 1 == data.numBlocks ? data.lastBlockSize : data.blockSize;
+		const uint32_t blockPosition = data.position - blockNumber * data.blockSize;
+
+		if (!data.blockRead && blockPosition == 0 && remainingSize >= currentBlockSize) {
+			// The whole block is wanted, so decompress it straight into the caller's buffer.
+			const int32_t error = data.mpqArchive->ReadBlock(data.fileNumber, blockNumber, out, currentBlockSize);
+			if (error != 0) {
+				SDL_SetError("MpqFileRwRead ReadBlock: %s", MpqArchive::ErrorMessage(error));
+				return 0;
+			}
+			out += currentBlockSize;
+			data.position += currentBlockSize;
+			remainingSize -= currentBlockSize;
+			++blockNumber;
+			continue;
+		}
 
 		if (!data.blockRead) {
+			if (data.blockData == nullptr) {
+				data.blockData = std::unique_ptr<uint8_t[]> { new uint8_t[data.blockSize] };
+			}
 			const int32_t error = data.mpqArchive->ReadBlock(data.fileNumber, blockNumber, data.blockData.get(), currentBlockSize);
 			if (error != 0) {
 				SDL_SetError("MpqFileRwRead ReadBlock: %s", MpqArchive::ErrorMessage(error));
@@ -119,7 +133,6 @@ static SizeType MpqFileRwRead(struct SDL_RWops *context, void *ptr, SizeType siz
 			data.blockRead = true;
 		}
 
-		const uint32_t blockPosition = data.position - blockNumber * data.blockSize;
 		const uint32_t remainingBlockSize = currentBlockSize - blockPosition;
 
 		if (remainingSize < remainingBlockSize) {
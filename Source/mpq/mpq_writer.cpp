@@ -1,5 +1,6 @@
 #include "mpq/mpq_writer.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -163,6 +164,7 @@ bool MpqWriter::Close(bool clearTables)
 	if (modified_ && !(stream_.Seekp(0, std::ios::beg) && WriteHeaderAndTables()))
 		result = false;
 	stream_.Close();
+	compressionPool_ = nullptr;
 	if (modified_ && result && size_ != 0) {
 		LogVerbose("ResizeFile(\"{}\", {})", name_, size_);
 		result = ResizeFile(name_.c_str(), size_);
@@ -378,58 +380,56 @@ bool MpqWriter::WriteFileContents(const char *filename, const byte *fileData, si
 	block->unpackedSize = fileSize;
 	block->flags = MpqBlockEntry::FlagExists | MpqBlockEntry::CompressPkZip;
 
-	// We populate the table of sector offsets while we write the data.
-	// We can't pre-populate it because we don't know the compressed sector sizes yet.
-	// First offset is the start of the first sector, last offset is the end of the last sector.
-	std::unique_ptr<uint32_t[]> offsetTable { new uint32_t[numSectors + 1] };
+	// The file is assembled in memory and written at once: the table of sector offsets
+	// (first offset is the start of the first sector, last offset is the end of the last sector)
+	// followed by the sectors. Each sector is compressed in place in its own `BlockSize` slot
+	// and then moved down to directly follow the previous one.
+	// Compressed sectors are never larger than the input, so the buffer is large enough.
+	std::unique_ptr<byte[]> buffer { new byte[offsetTableByteSize + fileSize] };
+	byte *sectors = &buffer[offsetTableByteSize];
+	if (fileSize != 0)
+		memcpy(sectors, fileData, fileSize);
+	std::unique_ptr<uint32_t[]> sectorSizes { new uint32_t[numSectors] };
+	const auto compressSector = [&](uint32_t sector) {
+		const uint32_t len = std::min<uint32_t>(fileSize - sector * BlockSize, BlockSize);
+		sectorSizes[sector] = PkwareCompress(&sectors[sector * BlockSize], len);
+	};
+
+	TaskPool *pool = numSectors > 1 ? CompressionPool() : nullptr;
+	if (pool != nullptr) {
+		for (uint32_t sector = 0; sector < numSectors; sector++)
+			pool->Submit([&compressSector, sector]() { compressSector(sector); });
+		pool->Wait();
+	} else {
+		for (uint32_t sector = 0; sector < numSectors; sector++)
+			compressSector(sector);
+	}
 
-#ifdef CAN_SEEKP_BEYOND_EOF
-	if (!stream_.Seekp(block->offset + offsetTableByteSize, std::ios::beg))
-		return false;
-#else
+	uint32_t destSize = offsetTableByteSize;
+	for (uint32_t sector = 0; sector <= numSectors; sector++) {
+		const uint32_t offset = SDL_SwapLE32(destSize);
+		memcpy(&buffer[sector * sizeof(uint32_t)], &offset, sizeof(offset));
+		if (sector == numSectors)
+			break;
+		memmove(&buffer[destSize], &sectors[sector * BlockSize], sectorSizes[sector]);
+		destSize += sectorSizes[sector];
+	}
+
+#ifndef CAN_SEEKP_BEYOND_EOF
 	// Ensure we do not Seekp beyond EOF by filling the missing space.
 	std::streampos stream_end;
 	if (!stream_.Seekp(0, std::ios::end) || !stream_.Tellp(&stream_end))
 		return false;
 	const std::uintmax_t cur_size = stream_end - streamBegin_;
-	if (cur_size < block->offset + offsetTableByteSize) {
-		if (cur_size < block->offset) {
-			std::unique_ptr<char[]> filler { new char[block->offset - cur_size] };
-			if (!stream_.Write(filler.get(), block->offset - cur_size))
-				return false;
-		}
-		if (!stream_.Write(reinterpret_cast<const char *>(offsetTable.get()), offsetTableByteSize))
-			return false;
-	} else {
-		if (!stream_.Seekp(block->offset + offsetTableByteSize, std::ios::beg))
+	if (cur_size < block->offset) {
+		std::unique_ptr<char[]> filler { new char[block->offset - cur_size] };
+		if (!stream_.Write(filler.get(), block->offset - cur_size))
 			return false;
 	}
 #endif
-
-	uint32_t destSize = offsetTableByteSize;
-	byte mpqBuf[BlockSize];
-	size_t curSector = 0;
-	while (true) {
-		uint32_t len = std::min<uint32_t>(fileSize, BlockSize);
-		memcpy(mpqBuf, fileData, len);
-		fileData += len;
-		len = PkwareCompress(mpqBuf, len);
-		if (!stream_.Write(reinterpret_cast<const char *>(&mpqBuf[0]), len))
-			return false;
-		offsetTable[curSector++] = SDL_SwapLE32(destSize);
-		destSize += len; // compressed length
-		if (fileSize <= BlockSize)
-			break;
-
-		fileSize -= BlockSize;
-	}
-
-	offsetTable[numSectors] = SDL_SwapLE32(destSize);
 	if (!stream_.Seekp(block->offset, std::ios::beg))
 		return false;
-	if (!stream_.Write(reinterpret_cast<const char *>(offsetTable.get()), offsetTableByteSize))
-		return false;
-	if (!stream_.Seekp(destSize - offsetTableByteSize, std::ios::cur))
+	if (!stream_.Write(reinterpret_cast<const char *>(buffer.get()), destSize))
 		return false;
 
 	if (destSize < block->packedSize) {
@@ -533,6 +533,18 @@ void MpqWriter::RenameFile(const char *name, const char *newName) // NOLINT(bugp
 	modified_ = true;
 }
 
+TaskPool *MpqWriter::CompressionPool()
+{
+	if (compressionPool_ == nullptr) {
+		const int numCpus = SDL_GetCPUCount();
+		if (numCpus <= 1)
+			return nullptr;
+		// The calling thread also compresses sectors while it waits.
+		compressionPool_ = std::make_unique<TaskPool>(numCpus - 1);
+	}
+	return compressionPool_.get();
+}
+
 bool MpqWriter::HasFile(const char *name) const
 {
 	return FetchHandle(name) != HashEntryNotFound;
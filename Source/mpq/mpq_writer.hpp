@@ -6,10 +6,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 
 #include "mpq/mpq_common.hpp"
 #include "utils/logged_fstream.hpp"
 #include "utils/stdcompat/cstddef.hpp"
+#include "utils/task_pool.hpp"
 
 namespace devilution {
 class MpqWriter {
@@ -39,6 +41,9 @@ private:
 	MpqBlockEntry *AddFile(const char *filename, MpqBlockEntry *block, uint32_t blockIndex);
 	bool WriteFileContents(const char *filename, const byte *fileData, size_t fileSize, MpqBlockEntry *block);
 
+	// Returns the worker threads used for compressing sectors, or nullptr if there is only one CPU.
+	TaskPool *CompressionPool();
+
 	// Returns an unused entry in the block entry table.
 	MpqBlockEntry *NewBlock(uint32_t *blockIndex = nullptr);
 
@@ -61,6 +66,7 @@ private:
 	bool exists_;
 	MpqHashEntry *hashTable_;
 	MpqBlockEntry *blockTable_;
+	std::unique_ptr<TaskPool> compressionPool_;
 
 // Amiga cannot Seekp beyond EOF.
 // See https://github.com/bebbo/libnix/issues/30
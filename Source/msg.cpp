@@ -2305,6 +2305,7 @@ void DeltaLoadLevel()
 				if (monster.MType->mtype == MT_GOLEM) {
 					GolumAi(i);
 					monster._mFlags |= (MFLAG_TARGETS_MONSTER | MFLAG_GOLEM);
+					InvalidateGolemMonsters();
 				} else {
 					M_StartStand(monster, monster._mdir);
 				}
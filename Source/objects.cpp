@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <climits>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "DiabloUI/ui_flags.hpp"
 #include "automap.h"
@@ -23,10 +25,12 @@
 #include "inv.h"
 #include "inv_iterators.hpp"
 #include "lighting.h"
+#include "line_of_sight.h"
 #include "minitext.h"
 #include "missiles.h"
 #include "monster.h"
 #include "options.h"
+#include "path_field.h"
 #include "setmaps.h"
 #include "stores.h"
 #include "themes.h"
@@ -848,6 +852,7 @@ void AddCryptBook(_object_id ot, int v2, int ox, int oy)
 	AvailableObjects[0] = AvailableObjects[MAXOBJECTS - 1 - ActiveObjectCount];
 	ActiveObjects[ActiveObjectCount] = oi;
 	dObject[ox][oy] = oi + 1;
+	InvalidatePathFields();
 	Object &object = Objects[oi];
 	SetupObject(object, { ox, oy }, ot);
 	AddCryptObject(object, v2);
@@ -1053,6 +1058,7 @@ void DeleteObject(int oi, int i)
 	int ox = Objects[oi].position.x;
 	int oy = Objects[oi].position.y;
 	dObject[ox][oy] = 0;
+	InvalidatePathFields();
 	AvailableObjects[-ActiveObjectCount + MAXOBJECTS] = oi;
 	ActiveObjectCount--;
 	if (pcursobj == oi) // Unselect object if this was highlighted by player
@@ -1095,9 +1101,21 @@ void AddChest(int i, int t)
 	Objects[i]._oVar2 = GenerateRnd(8);
 }
 
+/**
+ * @brief Changes whether an object blocks movement after it has been placed.
+ */
+void SetObjectSolid(Object &object, bool solid)
+{
+	object._oSolidFlag = solid;
+	InvalidatePathFields();
+}
+
 void ObjSetMicro(Point position, int pn)
 {
 	dPiece[position.x][position.y] = pn;
+	InvalidateVision();
+	InvalidatePathFields();
+	InvalidateLineOfSight();
 	pn--;
 
 	int blocks = leveltype != DTYPE_HELL ? 10 : 16;
@@ -1158,6 +1176,7 @@ void InitializeMicroDoor(Object &door)
 void AddSarc(int i)
 {
 	dObject[Objects[i].position.x][Objects[i].position.y - 1] = -(i + 1);
+	InvalidatePathFields();
 	Objects[i]._oVar1 = GenerateRnd(10);
 	Objects[i]._oRndSeed = AdvanceRndSeed();
 	if (Objects[i]._oVar1 >= 8)
@@ -1269,6 +1288,7 @@ void AddPurifyingFountain(int i)
 	dObject[ox][oy - 1] = -(i + 1);
 	dObject[ox - 1][oy] = -(i + 1);
 	dObject[ox - 1][oy - 1] = -(i + 1);
+	InvalidatePathFields();
 	Objects[i]._oRndSeed = AdvanceRndSeed();
 }
 
@@ -1299,6 +1319,7 @@ void AddMurkyFountain(int i)
 	dObject[ox][oy - 1] = -(i + 1);
 	dObject[ox - 1][oy] = -(i + 1);
 	dObject[ox - 1][oy - 1] = -(i + 1);
+	InvalidatePathFields();
 	Objects[i]._oRndSeed = AdvanceRndSeed();
 }
 
@@ -1409,6 +1430,7 @@ void AddMushPatch()
 		dObject[x + 1][y + 1] = -(i + 1);
 		dObject[x + 2][y + 1] = -(i + 1);
 		dObject[x + 1][y + 2] = -(i + 1);
+		InvalidatePathFields();
 		AddObject(OBJ_MUSHPATCH, { x + 2, y + 2 });
 	}
 }
@@ -4124,7 +4146,7 @@ void BreakCrux(Object &crux)
 	crux._oAnimFlag = 1;
 	crux._oAnimFrame = 1;
 	crux._oAnimDelay = 1;
-	crux._oSolidFlag = true;
+	SetObjectSolid(crux, true);
 	crux._oMissFlag = true;
 	crux._oBreak = -1;
 	crux._oSelFlag = 0;
@@ -4160,7 +4182,7 @@ void BreakBarrel(int pnum, Object &barrel, int dam, bool forcebreak, bool sendms
 	barrel._oAnimFlag = 1;
 	barrel._oAnimFrame = 1;
 	barrel._oAnimDelay = 1;
-	barrel._oSolidFlag = false;
+	SetObjectSolid(barrel, false);
 	barrel._oMissFlag = true;
 	barrel._oBreak = -1;
 	barrel._oSelFlag = 0;
@@ -4420,15 +4442,21 @@ void LoadLevelObjects(bool filesLoaded[65])
 		}
 	}
 
+	std::vector<std::string> paths;
+	for (int i = OFILE_L1BRAZ; i <= OFILE_L5BOOKS; i++) {
+		if (filesLoaded[i])
+			paths.push_back(fmt::format("Objects\\{}.CEL", ObjMasterLoadList[i]));
+	}
+	PreloadAssets(paths);
+
+	size_t pathIndex = 0;
 	for (int i = OFILE_L1BRAZ; i <= OFILE_L5BOOKS; i++) {
 		if (!filesLoaded[i]) {
 			continue;
 		}
 
 		ObjFileList[numobjfiles] = static_cast<object_graphic_id>(i);
-		char filestr[32];
-		sprintf(filestr, "Objects\\%s.CEL", ObjMasterLoadList[i]);
-		pObjCels[numobjfiles] = LoadFileInMem(filestr);
+		pObjCels[numobjfiles] = LoadFileInMem(paths[pathIndex++].c_str());
 		numobjfiles++;
 	}
 }
@@ -4739,6 +4767,7 @@ void AddObject(_object_id objType, Point objPos)
 	AvailableObjects[0] = AvailableObjects[MAXOBJECTS - 1 - ActiveObjectCount];
 	ActiveObjects[ActiveObjectCount] = oi;
 	dObject[objPos.x][objPos.y] = oi + 1;
+	InvalidatePathFields();
 	Object &object = Objects[oi];
 	SetupObject(object, objPos, objType);
 	switch (objType) {
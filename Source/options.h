@@ -489,6 +489,8 @@ struct GraphicsOptions : OptionCategoryBase {
 	OptionEntryBoolean showHealthValues;
 	/** @brief Display current/max mana values on mana globe. */
 	OptionEntryBoolean showManaValues;
+	/** @brief Number of threads used to render the dungeon, 1 renders everything on the main thread. */
+	OptionEntryInt<int> renderThreads;
 };
 
 struct GameplayOptions : OptionCategoryBase {
@@ -543,6 +545,8 @@ struct GameplayOptions : OptionCategoryBase {
 	OptionEntryBoolean disableCripplingShrines;
 	/** @brief Spell hotkeys instantly cast the spell. */
 	OptionEntryBoolean quickCast;
+	/** @brief Monsters chasing a player follow a shared distance map instead of searching their own path. */
+	OptionEntryBoolean monsterPathFields;
 	/** @brief Number of Healing potions to pick up automatically */
 	OptionEntryInt<int> numHealPotionPickup;
 	/** @brief Number of Full Healing potions to pick up automatically */
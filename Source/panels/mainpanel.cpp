@@ -108,8 +108,8 @@ void LoadMainPanel()
 		DrawButtonText(talkSurface, _("voice"), { { 0, 33 }, { TalkButton.w(), 0 } }, UiFlags::ColorButtonpushed);
 	}
 
-	UnloadFonts(GameFont12, ColorButtonface);
-	UnloadFonts(GameFont12, ColorButtonpushed);
+	UnloadFonts(ColorButtonface);
+	UnloadFonts(ColorButtonpushed);
 
 	PanelButton.Unload();
 	PanelButtonGrime.Unload();
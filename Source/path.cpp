@@ -14,22 +14,51 @@ namespace devilution {
 
 namespace {
 
-/** A linked list of the A* frontier, sorted by distance */
-PATHNODE *path_2_nodes;
+constexpr size_t MAXPATHNODES = 300;
+
+/** Notes visisted by the path finding algorithm. */
+PATHNODE path_nodes[MAXPATHNODES];
+/** the number of in-use nodes in path_nodes */
+uint32_t gdwCurNodes;
+
+/** Number of slots in NodeIndex, a power of two well above MAXPATHNODES to keep the probe sequences short. */
+constexpr size_t NodeIndexSize = 1024;
+/** Hash table (with linear probing) from a position to the index of its node in path_nodes, -1 for empty slots. */
+int16_t NodeIndex[NodeIndexSize];
+
+size_t GetNodeIndexSlot(Point position)
+{
+	return (static_cast<unsigned>(position.x) * 113U + static_cast<unsigned>(position.y)) & (NodeIndexSize - 1);
+}
+
 /**
- * @brief return a node for a position on the frontier, or NULL if not found
+ * @brief return the node for a position on the frontier or already visited, or NULL if not found
  */
-PATHNODE *GetNode1(Point targetPosition)
+PATHNODE *GetNode(Point targetPosition)
 {
-	PATHNODE *result = path_2_nodes->NextNode;
-	while (result != nullptr) {
-		if (result->position == targetPosition)
-			return result;
-		result = result->NextNode;
+	for (size_t slot = GetNodeIndexSlot(targetPosition);; slot = (slot + 1) & (NodeIndexSize - 1)) {
+		const int16_t index = NodeIndex[slot];
+		if (index < 0)
+			return nullptr;
+		if (path_nodes[index].position == targetPosition)
+			return &path_nodes[index];
 	}
-	return nullptr;
 }
 
+/**
+ * @brief make a node available to GetNode
+ */
+void AddNodeToIndex(const PATHNODE *node)
+{
+	size_t slot = GetNodeIndexSlot(node->position);
+	while (NodeIndex[slot] >= 0)
+		slot = (slot + 1) & (NodeIndexSize - 1);
+	NodeIndex[slot] = static_cast<int16_t>(node - path_nodes);
+}
+
+/** A linked list of the A* frontier, sorted by distance */
+PATHNODE *path_2_nodes;
+
 /**
  * @brief insert pPath into the frontier (keeping the frontier sorted by total distance)
  */
@@ -51,44 +80,6 @@ void NextNode(PATHNODE *pPath)
 	current->NextNode = pPath;
 }
 
-/** A linked list of all visited nodes */
-PATHNODE *pnode_ptr;
-/**
- * @brief return a node for this position if it was visited, or NULL if not found
- */
-PATHNODE *GetNode2(Point targetPosition)
-{
-	PATHNODE *result = pnode_ptr->NextNode;
-	while (result != nullptr) {
-		if (result->position == targetPosition)
-			return result;
-		result = result->NextNode;
-	}
-	return nullptr;
-}
-
-/**
- * @brief get the next node on the A* frontier to explore (estimated to be closest to the goal), mark it as visited, and return it
- */
-PATHNODE *GetNextPath()
-{
-	PATHNODE *result = path_2_nodes->NextNode;
-	if (result == nullptr) {
-		return result;
-	}
-
-	path_2_nodes->NextNode = result->NextNode;
-	result->NextNode = pnode_ptr->NextNode;
-	pnode_ptr->NextNode = result;
-	return result;
-}
-
-constexpr size_t MAXPATHNODES = 300;
-
-/** Notes visisted by the path finding algorithm. */
-PATHNODE path_nodes[MAXPATHNODES];
-/** the number of in-use nodes in path_nodes */
-uint32_t gdwCurNodes;
 /**
  * @brief zero one of the preallocated nodes and return a pointer to it, or NULL if none are available
  */
@@ -166,23 +157,6 @@ void SetCoords(PATHNODE *pPath)
 	}
 }
 
-/**
- * Returns a number representing the direction from a starting tile to a neighbouring tile.
- *
- * Used in the pathfinding code, each step direction is assigned a number like this:
- *       dx
- *     -1 0 1
- *     +-----
- *   -1|5 1 6
- * dy 0|2 0 3
- *    1|8 4 7
- */
-int8_t GetPathDirection(Point startPosition, Point destinationPosition)
-{
-	constexpr int8_t PathDirections[9] = { 5, 1, 6, 2, 0, 3, 8, 4, 7 };
-	return PathDirections[3 * (destinationPosition.y - startPosition.y) + 4 + destinationPosition.x - startPosition.x];
-}
-
 /**
  * @brief heuristic, estimated cost from startPosition to destinationPosition.
  */
@@ -192,22 +166,50 @@ int GetHeuristicCost(Point startPosition, Point destinationPosition)
 	return 2 * startPosition.ManhattanDistance(destinationPosition);
 }
 
-/**
- * @brief add a step from pPath to destination, return 1 if successful, and update the frontier/visited nodes accordingly
- *
- * @param pPath pointer to the current path node
- * @param candidatePosition expected to be a neighbour of the current path node position
- * @param destinationPosition where we hope to end up
- * @return true if step successfully added, false if we ran out of nodes to use
- */
-bool ParentPath(PATHNODE *pPath, Point candidatePosition, Point destinationPosition)
+} // namespace
+
+namespace detail {
+
+void StartPathSearch(Point startPosition, Point destinationPosition)
+{
+	// clear all nodes, create the root node for the frontier linked list
+	memset(NodeIndex, -1, sizeof(NodeIndex));
+	gdwCurNodes = 0;
+	path_2_nodes = NewStep();
+	// The visited nodes used to be kept in a list with a root node as well, keep using up a node for it so searches
+	// run out of nodes at the same point.
+	NewStep();
+	gdwCurPathStep = 0;
+	PATHNODE *pathStart = NewStep();
+	pathStart->g = 0;
+	pathStart->h = GetHeuristicCost(startPosition, destinationPosition);
+	pathStart->f = pathStart->h + pathStart->g;
+	pathStart->position = startPosition;
+	path_2_nodes->NextNode = pathStart;
+	AddNodeToIndex(pathStart);
+}
+
+PATHNODE *TakeNextPathNode()
+{
+	PATHNODE *result = path_2_nodes->NextNode;
+	if (result == nullptr) {
+		return result;
+	}
+
+	path_2_nodes->NextNode = result->NextNode;
+	result->NextNode = nullptr;
+	result->visited = true;
+	return result;
+}
+
+bool AddPathStep(PATHNODE *pPath, Point candidatePosition, Point destinationPosition)
 {
 	int nextG = pPath->g + CheckEqual(pPath->position, candidatePosition);
 
+	PATHNODE *dxdy = GetNode(candidatePosition);
 	// 3 cases to consider
 	// case 1: (dx,dy) is already on the frontier
-	PATHNODE *dxdy = GetNode1(candidatePosition);
-	if (dxdy != nullptr) {
+	if (dxdy != nullptr && !dxdy->visited) {
 		int i;
 		for (i = 0; i < 8; i++) {
 			if (pPath->Child[i] == nullptr)
@@ -224,7 +226,6 @@ bool ParentPath(PATHNODE *pPath, Point candidatePosition, Point destinationPosit
 		}
 	} else {
 		// case 2: (dx,dy) was already visited
-		dxdy = GetNode2(candidatePosition);
 		if (dxdy != nullptr) {
 			int i;
 			for (i = 0; i < 8; i++) {
@@ -250,6 +251,7 @@ bool ParentPath(PATHNODE *pPath, Point candidatePosition, Point destinationPosit
 			dxdy->h = GetHeuristicCost(candidatePosition, destinationPosition);
 			dxdy->f = nextG + dxdy->h;
 			dxdy->position = candidatePosition;
+			AddNodeToIndex(dxdy);
 			// add it to the frontier
 			NextNode(dxdy);
 
@@ -264,26 +266,32 @@ bool ParentPath(PATHNODE *pPath, Point candidatePosition, Point destinationPosit
 	return true;
 }
 
-/**
- * @brief perform a single step of A* bread-first search by trying to step in every possible direction from pPath with goal (x,y). Check each step with PosOk
- *
- * @return false if we ran out of preallocated nodes to use, else true
- */
-bool GetPath(const std::function<bool(Point)> &posOk, PATHNODE *pPath, Point destination)
+int ReconstructPath(const PATHNODE *destinationNode, int8_t path[MAX_PATH_LENGTH])
 {
-	for (auto dir : PathDirs) {
-		Point tile = pPath->position + dir;
-		bool ok = posOk(tile);
-		if ((ok && path_solid_pieces(pPath->position, tile)) || (!ok && tile == destination)) {
-			if (!ParentPath(pPath, tile, destination))
-				return false;
-		}
-	}
+	/**
+	 * for reconstructing the path after the A* search is done. The longest
+	 * possible path is actually 24 steps, even though we can fit 25
+	 */
+	static int8_t pnodeVals[MAX_PATH_LENGTH];
 
-	return true;
+	const PATHNODE *current = destinationNode;
+	int pathLength = 0;
+	while (current->Parent != nullptr) {
+		if (pathLength >= MAX_PATH_LENGTH)
+			break;
+		pnodeVals[pathLength++] = GetPathDirection(current->Parent->position, current->position);
+		current = current->Parent;
+	}
+	if (pathLength != MAX_PATH_LENGTH) {
+		int i;
+		for (i = 0; i < pathLength; i++)
+			path[i] = pnodeVals[pathLength - i - 1];
+		return i;
+	}
+	return 0;
 }
 
-} // namespace
+} // namespace detail
 
 bool IsTileNotSolid(Point position)
 {
@@ -342,50 +350,13 @@ bool IsTileOccupied(Point position)
 
 int FindPath(const std::function<bool(Point)> &posOk, Point startPosition, Point destinationPosition, int8_t path[MAX_PATH_LENGTH])
 {
-	/**
-	 * for reconstructing the path after the A* search is done. The longest
-	 * possible path is actually 24 steps, even though we can fit 25
-	 */
-	static int8_t pnodeVals[MAX_PATH_LENGTH];
+	return FindPath<std::function<bool(Point)>>(posOk, startPosition, destinationPosition, path);
+}
 
-	// clear all nodes, create root nodes for the visited/frontier linked lists
-	gdwCurNodes = 0;
-	path_2_nodes = NewStep();
-	pnode_ptr = NewStep();
-	gdwCurPathStep = 0;
-	PATHNODE *pathStart = NewStep();
-	pathStart->g = 0;
-	pathStart->h = GetHeuristicCost(startPosition, destinationPosition);
-	pathStart->f = pathStart->h + pathStart->g;
-	pathStart->position = startPosition;
-	path_2_nodes->NextNode = pathStart;
-	// A* search until we find (dx,dy) or fail
-	PATHNODE *nextNode;
-	while ((nextNode = GetNextPath()) != nullptr) {
-		// reached the end, success!
-		if (nextNode->position == destinationPosition) {
-			PATHNODE *current = nextNode;
-			int pathLength = 0;
-			while (current->Parent != nullptr) {
-				if (pathLength >= MAX_PATH_LENGTH)
-					break;
-				pnodeVals[pathLength++] = GetPathDirection(current->Parent->position, current->position);
-				current = current->Parent;
-			}
-			if (pathLength != MAX_PATH_LENGTH) {
-				int i;
-				for (i = 0; i < pathLength; i++)
-					path[i] = pnodeVals[pathLength - i - 1];
-				return i;
-			}
-			return 0;
-		}
-		// ran out of nodes, abort!
-		if (!GetPath(posOk, nextNode, destinationPosition))
-			return 0;
-	}
-	// frontier is empty, no path!
-	return 0;
+int8_t GetPathDirection(Point startPosition, Point destinationPosition)
+{
+	constexpr int8_t PathDirections[9] = { 5, 1, 6, 2, 0, 3, 8, 4, 7 };
+	return PathDirections[3 * (destinationPosition.y - startPosition.y) + 4 + destinationPosition.x - startPosition.x];
 }
 
 bool path_solid_pieces(Point startPosition, Point destinationPosition)
@@ -25,6 +25,8 @@ struct PATHNODE {
 	struct PATHNODE *Parent;
 	struct PATHNODE *Child[8];
 	struct PATHNODE *NextNode;
+	/** Set once the node was taken off the frontier. */
+	bool visited;
 };
 
 bool IsTileNotSolid(Point position);
@@ -41,10 +43,17 @@ bool IsTileWalkable(Point position, bool ignoreDoors = false);
 bool IsTileOccupied(Point position);
 
 /**
- * @brief Find the shortest path from startPosition to destinationPosition, using PosOk(Point) to check that each step is a valid position.
- * Store the step directions (corresponds to an index in PathDirs) in path, which must have room for 24 steps
+ * Returns a number representing the direction from a starting tile to a neighbouring tile.
+ *
+ * Used in the pathfinding code, each step direction is assigned a number like this:
+ *       dx
+ *     -1 0 1
+ *     +-----
+ *   -1|5 1 6
+ * dy 0|2 0 3
+ *    1|8 4 7
  */
-int FindPath(const std::function<bool(Point)> &posOk, Point startPosition, Point destinationPosition, int8_t path[MAX_PATH_LENGTH]);
+int8_t GetPathDirection(Point startPosition, Point destinationPosition);
 
 /**
  * @brief check if stepping from a given position to a neighbouring tile cuts a corner.
@@ -72,6 +81,64 @@ const Displacement PathDirs[8] = {
 	// clang-format on
 };
 
+namespace detail {
+
+/**
+ * @brief Clears the nodes of the previous search and puts the start position on the frontier.
+ */
+void StartPathSearch(Point startPosition, Point destinationPosition);
+
+/**
+ * @brief Takes the node estimated to be closest to the destination off the frontier, or returns NULL if the frontier is empty.
+ */
+PATHNODE *TakeNextPathNode();
+
+/**
+ * @brief Adds a step from pPath to a neighbouring position and updates the frontier/visited nodes accordingly.
+ *
+ * @return false if we ran out of nodes to use
+ */
+bool AddPathStep(PATHNODE *pPath, Point candidatePosition, Point destinationPosition);
+
+/**
+ * @brief Stores the steps leading to destinationNode in path and returns their number, 0 if the path is too long.
+ */
+int ReconstructPath(const PATHNODE *destinationNode, int8_t path[MAX_PATH_LENGTH]);
+
+} // namespace detail
+
+/**
+ * @brief Find the shortest path from startPosition to destinationPosition, using PosOk(Point) to check that each step is a valid position.
+ * Store the step directions (corresponds to an index in PathDirs) in path, which must have room for 24 steps
+ */
+template <typename PosOk>
+int FindPath(const PosOk &posOk, Point startPosition, Point destinationPosition, int8_t path[MAX_PATH_LENGTH])
+{
+	detail::StartPathSearch(startPosition, destinationPosition);
+	// A* search until we find (dx,dy) or fail
+	PATHNODE *nextNode;
+	while ((nextNode = detail::TakeNextPathNode()) != nullptr) {
+		// reached the end, success!
+		if (nextNode->position == destinationPosition)
+			return detail::ReconstructPath(nextNode, path);
+
+		// try to step in every possible direction, checking each step with posOk
+		for (Displacement dir : PathDirs) {
+			const Point tile = nextNode->position + dir;
+			const bool ok = posOk(tile);
+			if ((ok && path_solid_pieces(nextNode->position, tile)) || (!ok && tile == destinationPosition)) {
+				// ran out of nodes, abort!
+				if (!detail::AddPathStep(nextNode, tile, destinationPosition))
+					return 0;
+			}
+		}
+	}
+	// frontier is empty, no path!
+	return 0;
+}
+
+int FindPath(const std::function<bool(Point)> &posOk, Point startPosition, Point destinationPosition, int8_t path[MAX_PATH_LENGTH]);
+
 /**
  * @brief Searches for the closest position that passes the check in expanding "rings".
  *
@@ -0,0 +1,95 @@
+/**
+ * @file path_field.cpp
+ *
+ * Implementation of the cached distance maps that monsters use to chase players.
+ */
+#include "path_field.h"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "multi.h"
+#include "options.h"
+#include "player.h"
+
+namespace devilution {
+
+namespace {
+
+struct PathField {
+	bool valid;
+	/** Position of the player the field was built for. */
+	Point target;
+	uint8_t distances[MAXDUNX][MAXDUNY];
+};
+
+/** The distance maps of each player, for monsters that can't and that can open doors. */
+PathField PathFields[MAX_PLRS][2];
+
+/** Tiles waiting to be expanded, by their distance. Kept between builds to reuse the allocations. */
+std::array<std::vector<Point>, MaxPathFieldDistance + 1> PathFieldQueue;
+
+/**
+ * @brief Dijkstra search from the target over the walkable tiles, using the same step costs and corner rules as FindPath.
+ */
+void BuildPathField(PathField &field, Point target, bool canOpenDoors)
+{
+	memset(field.distances, PathFieldUnreachable, sizeof(field.distances));
+	field.target = target;
+	field.valid = true;
+	if (!InDungeonBounds(target))
+		return;
+
+	field.distances[target.x][target.y] = 0;
+	PathFieldQueue[0].push_back(target);
+	for (int distance = 0; distance <= MaxPathFieldDistance; distance++) {
+		std::vector<Point> &tiles = PathFieldQueue[distance];
+		for (Point tile : tiles) {
+			// Skip tiles that were reached by a shorter way after being queued
+			if (field.distances[tile.x][tile.y] != distance)
+				continue;
+			for (Displacement dir : PathDirs) {
+				const Point next = tile + dir;
+				const int nextDistance = distance + (dir.deltaX == 0 || dir.deltaY == 0 ? 2 : 3);
+				if (nextDistance > MaxPathFieldDistance || !InDungeonBounds(next) || nextDistance >= field.distances[next.x][next.y])
+					continue;
+				if (!IsTileWalkable(next, canOpenDoors) || !path_solid_pieces(tile, next))
+					continue;
+				field.distances[next.x][next.y] = static_cast<uint8_t>(nextDistance);
+				PathFieldQueue[nextDistance].push_back(next);
+			}
+		}
+		tiles.clear();
+	}
+}
+
+} // namespace
+
+bool UsePathFields()
+{
+	return !gbIsMultiplayer && *sgOptions.Gameplay.monsterPathFields;
+}
+
+void InvalidatePathFields()
+{
+	for (auto &playerFields : PathFields) {
+		for (PathField &field : playerFields)
+			field.valid = false;
+	}
+}
+
+namespace detail {
+
+const uint8_t (&GetPathField(size_t playerId, bool canOpenDoors))[MAXDUNX][MAXDUNY]
+{
+	PathField &field = PathFields[playerId][canOpenDoors ? 1 : 0];
+	const Point target = Players[playerId].position.future;
+	if (!field.valid || field.target != target)
+		BuildPathField(field, target, canOpenDoors);
+	return field.distances;
+}
+
+} // namespace detail
+
+} // namespace devilution
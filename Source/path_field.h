@@ -0,0 +1,83 @@
+/**
+ * @file path_field.h
+ *
+ * Interface of the cached distance maps that monsters use to chase players.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "engine/point.hpp"
+#include "gendung.h"
+#include "path.h"
+
+namespace devilution {
+
+/** Distance of unreachable tiles in a path field. */
+constexpr uint8_t PathFieldUnreachable = UINT8_MAX;
+/** Tiles farther away from the player than this are treated as unreachable, it's the cost of MAX_PATH_LENGTH diagonal steps. */
+constexpr uint8_t MaxPathFieldDistance = 3 * MAX_PATH_LENGTH;
+
+/**
+ * @brief Whether monsters chasing a player step along the cached distance map instead of searching a path with FindPath.
+ *
+ * Only used in single player, the routes can differ from the ones FindPath would pick.
+ */
+bool UsePathFields();
+
+/**
+ * @brief Drops the distance maps, has to be called whenever the walkable tiles of the level change.
+ */
+void InvalidatePathFields();
+
+namespace detail {
+
+/**
+ * @brief Returns the distance map towards a player, rebuilding it if the player moved or the level changed.
+ *
+ * Distances are in the units of FindPath (2 per straight step, 3 per diagonal one).
+ */
+const uint8_t (&GetPathField(size_t playerId, bool canOpenDoors))[MAXDUNX][MAXDUNY];
+
+} // namespace detail
+
+/**
+ * @brief Returns the first step towards a player using the distance map from the player's future position.
+ *
+ * The first neighbour that is closest to the player and passes posOk is taken. Similar to the limit of FindPath this
+ * fails for positions farther than MaxPathFieldDistance from the player.
+ *
+ * @param posOk Checks that a tile can be stepped on right now, in addition to the walkable tiles of the distance map
+ * @param playerId Player that is being chased
+ * @param canOpenDoors Whether closed doors count as walkable
+ * @param startPosition Current tile of the monster
+ * @param destinationPosition The future position of the player, it can be stepped on even if posOk fails
+ * @return the step direction (as returned by GetPathDirection) or 0 if there is no way to get closer
+ */
+template <typename PosOk>
+int8_t FindPathFieldStep(const PosOk &posOk, size_t playerId, bool canOpenDoors, Point startPosition, Point destinationPosition)
+{
+	if (!InDungeonBounds(startPosition))
+		return 0;
+
+	const auto &field = detail::GetPathField(playerId, canOpenDoors);
+	uint8_t bestDistance = field[startPosition.x][startPosition.y];
+	if (bestDistance == PathFieldUnreachable)
+		return 0;
+
+	int8_t bestStep = 0;
+	for (Displacement dir : PathDirs) {
+		const Point tile = startPosition + dir;
+		if (!InDungeonBounds(tile) || field[tile.x][tile.y] >= bestDistance)
+			continue;
+		const bool ok = posOk(tile);
+		if ((ok && path_solid_pieces(startPosition, tile)) || (!ok && tile == destinationPosition)) {
+			bestDistance = field[tile.x][tile.y];
+			bestStep = GetPathDirection(startPosition, tile);
+		}
+	}
+	return bestStep;
+}
+
+} // namespace devilution
@@ -5,7 +5,10 @@
  */
 #include "pfile.h"
 
+#include <atomic>
+#include <functional>
 #include <string>
+#include <unordered_set>
 
 #include "codec.h"
 #include "engine.h"
@@ -19,6 +22,8 @@
 #include "utils/file_util.h"
 #include "utils/language.h"
 #include "utils/paths.h"
+#include "utils/stdcompat/shared_ptr_array.hpp"
+#include "utils/task_queue.hpp"
 #include "utils/utf8.hpp"
 
 namespace devilution {
@@ -35,6 +40,120 @@ namespace {
 MpqWriter SaveWriter;
 MpqWriter StashWriter;
 
+/**
+ * Encodes, compresses and writes save files in the background.
+ * While tasks are queued, `SaveWriter` and `StashWriter` must only be used from queued tasks.
+ */
+std::unique_ptr<TaskQueue> SaveQueue;
+
+/** Untranslated message of the first save task that failed, reported on the game thread. */
+std::atomic<const char *> SaveError { nullptr };
+
+void ReportSaveError()
+{
+	const char *error = SaveError.load();
+	if (error != nullptr)
+		app_fatal("%s", _(error).c_str());
+}
+
+void QueueSaveTask(std::function<void()> task)
+{
+	ReportSaveError();
+	if (SaveQueue == nullptr)
+		SaveQueue = std::make_unique<TaskQueue>();
+	SaveQueue->Submit([task = std::move(task)]() {
+		// The archive is in an unknown state after a failure, so skip everything until the error is reported.
+		if (SaveError.load() == nullptr)
+			task();
+	});
+}
+
+void SetSaveError(const char *error)
+{
+	const char *expected = nullptr;
+	SaveError.compare_exchange_strong(expected, error);
+}
+
+/**
+ * @brief Opens a copy of the given archive for writing.
+ *
+ * The archive itself stays intact if the game is interrupted while writing,
+ * it is only replaced by the copy in `CloseArchiveCopy`. Copying reads and writes
+ * the whole archive, so queued writes of the save archive share one copy, see `QueueOpenSaveWriter`.
+ */
+bool OpenArchiveCopy(MpqWriter &writer, const std::string &path)
+{
+	const std::string tempPath = path + ".tmp";
+	if (FileExists(path.c_str())) {
+		if (!CopyFileOverwrite(path.c_str(), tempPath.c_str()))
+			return false;
+	} else if (FileExists(tempPath.c_str())) {
+		RemoveFile(tempPath);
+	}
+	return writer.Open(tempPath.c_str());
+}
+
+/**
+ * @brief Finishes writing the copy of the archive and atomically replaces the archive with it.
+ */
+bool CloseArchiveCopy(MpqWriter &writer, const std::string &path, bool clearTables)
+{
+	if (!writer.Close(clearTables))
+		return false;
+	return MoveFileOverwrite((path + ".tmp").c_str(), path.c_str());
+}
+
+/** Save archive whose copy is open in `SaveWriter`, only used from queued tasks. */
+std::string SaveWriterPath;
+
+/** Writers of the save archive that have been queued and not closed yet. */
+std::atomic<int> QueuedSaveWriters { 0 };
+
+/**
+ * @brief Queues opening a copy of the save archive unless the copy of the previous writer is still open.
+ */
+void QueueOpenSaveWriter(const std::string &path, const char *error)
+{
+	QueuedSaveWriters++;
+	QueueSaveTask([path, error]() {
+		if (SaveWriterPath == path)
+			return;
+		if (!SaveWriterPath.empty()) {
+			const std::string previousPath = std::move(SaveWriterPath);
+			SaveWriterPath.clear();
+			if (!CloseArchiveCopy(SaveWriter, previousPath, /*clearTables=*/true)) {
+				SetSaveError(N_("Failed to write player archive."));
+				return;
+			}
+		}
+		if (!OpenArchiveCopy(SaveWriter, path)) {
+			SetSaveError(error);
+			return;
+		}
+		SaveWriterPath = path;
+	});
+}
+
+/**
+ * @brief Queues replacing the save archive with its copy, unless another writer has been queued since.
+ *
+ * The last writer of a batch of queued saves closes the copy, so a level change that saves the level
+ * and the hero copies and replaces the archive once.
+ */
+void QueueCloseSaveWriter(bool clearTables, const char *error)
+{
+	QueueSaveTask([clearTables, error]() {
+		if (--QueuedSaveWriters > 0)
+			return;
+		if (SaveWriterPath.empty())
+			return;
+		const std::string path = std::move(SaveWriterPath);
+		SaveWriterPath.clear();
+		if (!CloseArchiveCopy(SaveWriter, path, clearTables))
+			SetSaveError(error);
+	});
+}
+
 /** List of character names for the character selection screen. */
 char hero_names[MAX_CHARACTERS][PLR_NAME_LEN];
 
@@ -86,14 +205,14 @@ std::string GetStashSavePath()
 	return path;
 }
 
-bool GetPermSaveNames(uint8_t dwIndex, char *szPerm)
+bool GetPermSaveNames(uint8_t numberOfLevels, uint8_t dwIndex, char *szPerm)
 {
 	const char *fmt;
 
-	if (dwIndex < giNumberOfLevels)
+	if (dwIndex < numberOfLevels)
 		fmt = "perml%02d";
-	else if (dwIndex < giNumberOfLevels * 2) {
-		dwIndex -= giNumberOfLevels;
+	else if (dwIndex < numberOfLevels * 2) {
+		dwIndex -= numberOfLevels;
 		fmt = "perms%02d";
 	} else
 		return false;
@@ -102,14 +221,14 @@ bool GetPermSaveNames(uint8_t dwIndex, char *szPerm)
 	return true;
 }
 
-bool GetTempSaveNames(uint8_t dwIndex, char *szTemp)
+bool GetTempSaveNames(uint8_t numberOfLevels, uint8_t dwIndex, char *szTemp)
 {
 	const char *fmt;
 
-	if (dwIndex < giNumberOfLevels)
+	if (dwIndex < numberOfLevels)
 		fmt = "templ%02d";
-	else if (dwIndex < giNumberOfLevels * 2) {
-		dwIndex -= giNumberOfLevels;
+	else if (dwIndex < numberOfLevels * 2) {
+		dwIndex -= numberOfLevels;
 		fmt = "temps%02d";
 	} else
 		return false;
@@ -118,14 +237,79 @@ bool GetTempSaveNames(uint8_t dwIndex, char *szTemp)
 	return true;
 }
 
-void RenameTempToPerm()
+/**
+ * @brief Level files in the save archive at `SaveFilesPath` once every queued task has run.
+ *
+ * Kept by the game thread as it queues writes, so checking which levels have been saved
+ * doesn't have to wait for the save queue. `SaveFilesPath` is empty until the archive has been read.
+ */
+std::unordered_set<std::string> SaveFiles;
+std::string SaveFilesPath;
+/** The level names depend on giNumberOfLevels, so `SaveFiles` is read again when it changes */
+int SaveFilesNumberOfLevels;
+
+/**
+ * @brief Reads the level files of the given save archive into `SaveFiles` unless they are known already.
+ */
+void LoadSaveFiles(const std::string &path)
+{
+	if (SaveFilesPath == path && SaveFilesNumberOfLevels == giNumberOfLevels)
+		return;
+
+	pfile_wait_for_saves();
+	SaveFiles.clear();
+	std::int32_t error;
+	std::optional<MpqArchive> archive = MpqArchive::Open(path.c_str(), error);
+	if (archive) {
+		char szName[MAX_PATH];
+		uint32_t fileNumber;
+		for (uint8_t i = 0; GetTempSaveNames(giNumberOfLevels, i, szName); i++) {
+			if (archive->GetFileNumber(MpqArchive::CalculateFileHash(szName), fileNumber))
+				SaveFiles.emplace(szName);
+		}
+		for (uint8_t i = 0; GetPermSaveNames(giNumberOfLevels, i, szName); i++) {
+			if (archive->GetFileNumber(MpqArchive::CalculateFileHash(szName), fileNumber))
+				SaveFiles.emplace(szName);
+		}
+	}
+	SaveFilesPath = path;
+	SaveFilesNumberOfLevels = giNumberOfLevels;
+}
+
+bool HasSaveFile(const char *name)
+{
+	LoadSaveFiles(GetSavePath(gSaveNumber));
+	return SaveFiles.count(name) != 0;
+}
+
+/**
+ * @brief Renames the temporary level files to permanent ones in `SaveFiles`, like `RenameTempToPerm` does in the archive.
+ */
+void RenameTempToPermInSaveFiles()
+{
+	char szTemp[MAX_PATH];
+	char szPerm[MAX_PATH];
+
+	for (uint8_t i = 0; GetTempSaveNames(giNumberOfLevels, i, szTemp); i++) {
+		if (SaveFiles.erase(szTemp) == 0)
+			continue;
+		GetPermSaveNames(giNumberOfLevels, i, szPerm);
+		SaveFiles.emplace(szPerm);
+	}
+}
+
+/**
+ * @brief Renames the temporary level files to permanent ones, must run on the save queue.
+ * @param numberOfLevels giNumberOfLevels at the time the task was queued
+ */
+void RenameTempToPerm(uint8_t numberOfLevels)
 {
 	char szTemp[MAX_PATH];
 	char szPerm[MAX_PATH];
 
 	uint32_t dwIndex = 0;
-	while (GetTempSaveNames(dwIndex, szTemp)) {
-		[[maybe_unused]] bool result = GetPermSaveNames(dwIndex, szPerm); // DO NOT PUT DIRECTLY INTO ASSERT!
+	while (GetTempSaveNames(numberOfLevels, dwIndex, szTemp)) {
+		[[maybe_unused]] bool result = GetPermSaveNames(numberOfLevels, dwIndex, szPerm); // DO NOT PUT DIRECTLY INTO ASSERT!
 		assert(result);
 		dwIndex++;
 		if (SaveWriter.HasFile(szTemp)) {
@@ -134,7 +318,7 @@ void RenameTempToPerm()
 			SaveWriter.RenameFile(szTemp, szPerm);
 		}
 	}
-	assert(!GetPermSaveNames(dwIndex, szPerm));
+	assert(!GetPermSaveNames(numberOfLevels, dwIndex, szPerm));
 }
 
 bool ReadHero(MpqArchive &archive, PlayerPack *pPack)
@@ -160,13 +344,7 @@ void EncodeHero(const PlayerPack *pack)
 	std::unique_ptr<byte[]> packed { new byte[packedLen] };
 
 	memcpy(packed.get(), pack, sizeof(*pack));
-	codec_encode(packed.get(), sizeof(*pack), packedLen, pfile_get_password());
-	SaveWriter.WriteFile("hero", packed.get(), packedLen);
-}
-
-bool OpenArchive(uint32_t saveNum)
-{
-	return SaveWriter.Open(GetSavePath(saveNum).c_str());
+	pfile_write_file(SaveWriter, "hero", std::move(packed), sizeof(*pack));
 }
 
 void Game2UiPlayer(const Player &player, _uiheroinfo *heroinfo, bool bHasSaveFile)
@@ -229,7 +407,7 @@ bool CompareSaves(const std::string &actualSavePath, const std::string &referenc
 	possibleFileNamesToCheck.emplace_back("game");
 	possibleFileNamesToCheck.emplace_back("additionalMissiles");
 	char szPerm[MAX_PATH];
-	for (int i = 0; GetPermSaveNames(i, szPerm); i++) {
+	for (int i = 0; GetPermSaveNames(giNumberOfLevels, i, szPerm); i++) {
 		possibleFileNamesToCheck.emplace_back(szPerm);
 	}
 
@@ -262,12 +440,14 @@ bool CompareSaves(const std::string &actualSavePath, const std::string &referenc
 
 std::optional<MpqArchive> OpenSaveArchive(uint32_t saveNum)
 {
+	pfile_wait_for_saves();
 	std::int32_t error;
 	return MpqArchive::Open(GetSavePath(saveNum).c_str(), error);
 }
 
 std::optional<MpqArchive> OpenStashArchive()
 {
+	pfile_wait_for_saves();
 	std::int32_t error;
 	return MpqArchive::Open(GetStashSavePath().c_str(), error);
 }
@@ -299,16 +479,17 @@ const char *pfile_get_password()
 }
 
 PFileScopedArchiveWriter::PFileScopedArchiveWriter(bool clearTables)
-    : save_num_(gSaveNumber)
+    : path_(GetSavePath(gSaveNumber))
     , clear_tables_(clearTables)
 {
-	if (!OpenArchive(save_num_))
-		app_fatal("%s", _("Failed to open player archive for writing.").c_str());
+	// SaveFiles has to describe the archive being written so the writes can be added to it
+	LoadSaveFiles(path_);
+	QueueOpenSaveWriter(path_, N_("Failed to open player archive for writing."));
 }
 
 PFileScopedArchiveWriter::~PFileScopedArchiveWriter()
 {
-	SaveWriter.Close(clear_tables_);
+	QueueCloseSaveWriter(clear_tables_, N_("Failed to write player archive."));
 }
 
 MpqWriter &CurrentSaveArchive()
@@ -321,12 +502,32 @@ MpqWriter &StashArchive()
 	return StashWriter;
 }
 
+void pfile_write_file(MpqWriter &archive, const char *name, std::unique_ptr<byte[]> data, size_t size)
+{
+	if (&archive == &SaveWriter)
+		SaveFiles.emplace(name);
+	const ArraySharedPtr<byte> buffer { data.release(), std::default_delete<byte[]>() };
+	QueueSaveTask([&archive, name = std::string(name), buffer, size, password = pfile_get_password()]() {
+		const size_t encodedLen = codec_get_encoded_len(size);
+		codec_encode(buffer.get(), size, encodedLen, password);
+		archive.WriteFile(name.c_str(), buffer.get(), encodedLen);
+	});
+}
+
+void pfile_wait_for_saves()
+{
+	if (SaveQueue != nullptr)
+		SaveQueue->Wait();
+	ReportSaveError();
+}
+
 void pfile_write_hero(bool writeGameData, bool clearTables)
 {
 	PFileScopedArchiveWriter scopedWriter(clearTables);
 	if (writeGameData) {
 		SaveGameData();
-		RenameTempToPerm();
+		QueueSaveTask([numberOfLevels = giNumberOfLevels]() { RenameTempToPerm(numberOfLevels); });
+		RenameTempToPermInSaveFiles();
 	}
 	PlayerPack pkplr;
 	Player &myPlayer = *MyPlayer;
@@ -359,6 +560,7 @@ HeroCompareResult pfile_compare_hero_demo(int demo)
 	pfile_write_hero(true, true);
 	std::string actualSavePath = GetSavePath(gSaveNumber);
 	savePrefix.clear();
+	pfile_wait_for_saves();
 
 	bool compareResult = CompareSaves(actualSavePath, referenceSavePath);
 	return compareResult ? HeroCompareResult::Same : HeroCompareResult::Difference;
@@ -369,12 +571,18 @@ void sfile_write_stash()
 	if (!Stash.dirty)
 		return;
 
-	if (!StashWriter.Open(GetStashSavePath().c_str()))
-		app_fatal("%s", _("Failed to open stash archive for writing.").c_str());
+	const std::string path = GetStashSavePath();
+	QueueSaveTask([path]() {
+		if (!OpenArchiveCopy(StashWriter, path))
+			SetSaveError(N_("Failed to open stash archive for writing."));
+	});
 
 	SaveStash();
 
-	StashWriter.Close();
+	QueueSaveTask([path]() {
+		if (!CloseArchiveCopy(StashWriter, path, /*clearTables=*/true))
+			SetSaveError(N_("Failed to write stash archive."));
+	});
 
 	Stash.dirty = false;
 }
@@ -439,7 +647,10 @@ bool pfile_ui_save_create(_uiheroinfo *heroinfo)
 	uint32_t saveNum = heroinfo->saveNumber;
 	if (saveNum >= MAX_CHARACTERS)
 		return false;
-	if (!OpenArchive(saveNum))
+	pfile_wait_for_saves();
+	SaveFilesPath.clear();
+	const std::string path = GetSavePath(saveNum);
+	if (!OpenArchiveCopy(SaveWriter, path))
 		return false;
 	heroinfo->saveNumber = saveNum;
 
@@ -459,12 +670,18 @@ bool pfile_ui_save_create(_uiheroinfo *heroinfo)
 		SaveHeroItems(player);
 	}
 
-	SaveWriter.Close();
+	QueueSaveTask([path]() {
+		if (!CloseArchiveCopy(SaveWriter, path, /*clearTables=*/true))
+			SetSaveError(N_("Failed to write player archive."));
+	});
+	pfile_wait_for_saves();
 	return true;
 }
 
 bool pfile_delete_save(_uiheroinfo *heroInfo)
 {
+	pfile_wait_for_saves();
+	SaveFilesPath.clear();
 	uint32_t saveNum = heroInfo->saveNumber;
 	if (saveNum < MAX_CHARACTERS) {
 		hero_names[saveNum][0] = '\0';
@@ -505,13 +722,7 @@ bool LevelFileExists()
 
 	GetPermLevelNames(szName);
 
-	uint32_t saveNum = gSaveNumber;
-	if (!OpenArchive(saveNum))
-		app_fatal("%s", _("Unable to read to save file archive").c_str());
-
-	bool hasFile = SaveWriter.HasFile(szName);
-	SaveWriter.Close();
-	return hasFile;
+	return HasSaveFile(szName);
 }
 
 void GetTempLevelNames(char *szTemp)
@@ -524,14 +735,8 @@ void GetTempLevelNames(char *szTemp)
 
 void GetPermLevelNames(char *szPerm)
 {
-	uint32_t saveNum = gSaveNumber;
 	GetTempLevelNames(szPerm);
-	if (!OpenArchive(saveNum))
-		app_fatal("%s", _("Unable to read to save file archive").c_str());
-
-	bool hasFile = SaveWriter.HasFile(szPerm);
-	SaveWriter.Close();
-	if (!hasFile) {
+	if (!HasSaveFile(szPerm)) {
 		if (setlevel)
 			sprintf(szPerm, "perms%02d", setlvlnum);
 		else
@@ -544,11 +749,19 @@ void pfile_remove_temp_files()
 	if (gbIsMultiplayer)
 		return;
 
-	uint32_t saveNum = gSaveNumber;
-	if (!OpenArchive(saveNum))
-		app_fatal("%s", _("Unable to write to save file archive").c_str());
-	SaveWriter.RemoveHashEntries(GetTempSaveNames);
-	SaveWriter.Close();
+	const std::string path = GetSavePath(gSaveNumber);
+	LoadSaveFiles(path);
+	QueueOpenSaveWriter(path, N_("Unable to write to save file archive"));
+	QueueSaveTask([numberOfLevels = giNumberOfLevels]() {
+		char szTemp[MAX_PATH];
+		for (uint8_t i = 0; GetTempSaveNames(numberOfLevels, i, szTemp); i++)
+			SaveWriter.RemoveHashEntry(szTemp);
+	});
+	QueueCloseSaveWriter(/*clearTables=*/true, N_("Unable to write to save file archive"));
+
+	char szTemp[MAX_PATH];
+	for (uint8_t i = 0; GetTempSaveNames(giNumberOfLevels, i, szTemp); i++)
+		SaveFiles.erase(szTemp);
 }
 
 void pfile_update(bool forceSave)
@@ -5,6 +5,9 @@
  */
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include "DiabloUI/diabloui.h"
 #include "mpq/mpq_writer.hpp"
 #include "player.h"
@@ -24,7 +27,7 @@ public:
 	~PFileScopedArchiveWriter();
 
 private:
-	int save_num_;
+	std::string path_;
 	bool clear_tables_;
 };
 
@@ -39,6 +42,18 @@ enum class HeroCompareResult {
 
 MpqWriter &CurrentSaveArchive();
 MpqWriter &StashArchive();
+/**
+ * @brief Queues a save file to be encoded and written to the archive in the background.
+ * @param archive Archive that is open for writing once the queued tasks before this one have run
+ * @param name Name of the file in the archive
+ * @param data Unencoded contents, allocated with room for `codec_get_encoded_len(size)` bytes
+ * @param size Size of the unencoded contents
+ */
+void pfile_write_file(MpqWriter &archive, const char *name, std::unique_ptr<byte[]> data, size_t size);
+/**
+ * @brief Blocks until every queued save has been written to disk.
+ */
+void pfile_wait_for_saves();
 std::optional<MpqArchive> OpenSaveArchive(uint32_t saveNum);
 std::optional<MpqArchive> OpenStashArchive();
 const char *pfile_get_password();
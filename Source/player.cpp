@@ -5,6 +5,10 @@
  */
 #include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "control.h"
 #include "controls/plrctrls.h"
@@ -33,6 +37,8 @@
 #include "towners.h"
 #include "utils/language.h"
 #include "utils/log.hpp"
+#include "utils/sdl_mutex.h"
+#include "utils/task_pool.hpp"
 #include "utils/utf8.hpp"
 
 namespace devilution {
@@ -364,6 +370,15 @@ void StartWalk(int pnum, Displacement vel, Direction dir, bool pmWillBeCalled)
 	StartWalkAnimation(player, dir, pmWillBeCalled);
 }
 
+void SetPlayerSprites(const byte *data, std::array<std::optional<CelSprite>, 8> &anim, int width)
+{
+	const byte *directionFrames[8];
+	CelGetDirectionFrames(data, directionFrames);
+	for (size_t i = 0; i < 8; i++) {
+		anim[i].emplace(directionFrames[i], width);
+	}
+}
+
 void SetPlayerGPtrs(const char *path, std::unique_ptr<byte[]> &data, std::array<std::optional<CelSprite>, 8> &anim, int width)
 {
 	data = nullptr;
@@ -371,10 +386,276 @@ void SetPlayerGPtrs(const char *path, std::unique_ptr<byte[]> &data, std::array<
 	if (data == nullptr && gbQuietMode)
 		return;
 
-	const byte *directionFrames[8];
-	CelGetDirectionFrames(data.get(), directionFrames);
-	for (size_t i = 0; i < 8; i++) {
-		anim[i].emplace(directionFrames[i], width);
+	SetPlayerSprites(data.get(), anim, width);
+}
+
+/**
+ * @brief Determines the CL2 file of a player graphic for the current state of the player.
+ * @param path Buffer of at least 256 characters that receives the path
+ * @param width Receives the frame width of the graphic
+ * @return false if the player has no such graphic in the current state
+ */
+bool GetPlrGFXPath(const Player &player, player_graphic graphic, char *path, int &width)
+{
+	char prefix[16];
+	const char *szCel;
+
+	HeroClass c = player._pClass;
+	if (c == HeroClass::Bard && !hfbard_mpq) {
+		c = HeroClass::Rogue;
+	} else if (c == HeroClass::Barbarian && !hfbarb_mpq) {
+		c = HeroClass::Warrior;
+	}
+
+	auto animWeaponId = static_cast<PlayerWeaponGraphic>(player._pgfxnum & 0xF);
+	width = 96;
+	bool useUnarmedAnimationInTown = false;
+
+	const char *cs = ClassPathTbl[static_cast<std::size_t>(c)];
+
+	switch (graphic) {
+	case player_graphic::Stand:
+		szCel = "AS";
+		if (leveltype == DTYPE_TOWN)
+			szCel = "ST";
+		if (c == HeroClass::Monk)
+			width = 112;
+		break;
+	case player_graphic::Walk:
+		szCel = "AW";
+		if (leveltype == DTYPE_TOWN)
+			szCel = "WL";
+		if (c == HeroClass::Monk)
+			width = 112;
+		break;
+	case player_graphic::Attack:
+		if (leveltype == DTYPE_TOWN)
+			return false;
+		szCel = "AT";
+		if (c == HeroClass::Monk)
+			width = 130;
+		else if (animWeaponId != PlayerWeaponGraphic::Bow || !(c == HeroClass::Warrior || c == HeroClass::Barbarian))
+			width = 128;
+		break;
+	case player_graphic::Hit:
+		if (leveltype == DTYPE_TOWN)
+			return false;
+		szCel = "HT";
+		if (c == HeroClass::Monk)
+			width = 98;
+		break;
+	case player_graphic::Lightning:
+		szCel = "LM";
+		useUnarmedAnimationInTown = true;
+		if (c == HeroClass::Monk)
+			width = 114;
+		else if (c == HeroClass::Sorcerer)
+			width = 128;
+		break;
+	case player_graphic::Fire:
+		szCel = "FM";
+		useUnarmedAnimationInTown = true;
+		if (c == HeroClass::Monk)
+			width = 114;
+		else if (c == HeroClass::Sorcerer)
+			width = 128;
+		break;
+	case player_graphic::Magic:
+		szCel = "QM";
+		useUnarmedAnimationInTown = true;
+		if (c == HeroClass::Monk)
+			width = 114;
+		else if (c == HeroClass::Sorcerer)
+			width = 128;
+		break;
+	case player_graphic::Death:
+		if (animWeaponId != PlayerWeaponGraphic::Unarmed)
+			return false;
+		szCel = "DT";
+		width = (c == HeroClass::Monk) ? 160 : 128;
+		break;
+	case player_graphic::Block:
+		if (leveltype == DTYPE_TOWN)
+			return false;
+		if (!player._pBlockFlag)
+			return false;
+		szCel = "BL";
+		if (c == HeroClass::Monk)
+			width = 98;
+		break;
+	default:
+		app_fatal("PLR:2");
+	}
+
+	if (leveltype == DTYPE_TOWN && useUnarmedAnimationInTown) {
+		// If the hero doesn't hold the weapon in town then we should use the unarmed animation for casting
+		switch (animWeaponId) {
+		case PlayerWeaponGraphic::Mace:
+		case PlayerWeaponGraphic::Sword:
+			animWeaponId = PlayerWeaponGraphic::Unarmed;
+			break;
+		case PlayerWeaponGraphic::SwordShield:
+		case PlayerWeaponGraphic::MaceShield:
+			animWeaponId = PlayerWeaponGraphic::UnarmedShield;
+			break;
+		}
+	}
+
+	sprintf(prefix, "%c%c%c", CharChar[static_cast<std::size_t>(c)], ArmourChar[player._pgfxnum >> 4], WepChar[static_cast<std::size_t>(animWeaponId)]);
+	sprintf(path, R"(PlrGFX\%s\%s\%s%s.CL2)", cs, prefix, prefix, szCel);
+	return true;
+}
+
+/** A player graphic that is read on PlayerGFXPool. */
+struct PlayerGFXLoad {
+	int playerId;
+	player_graphic graphic;
+	std::string path;
+	/** Set by the worker, nullptr if the file could not be read */
+	std::unique_ptr<byte[]> data;
+	bool done = false;
+};
+
+std::unique_ptr<TaskPool> PlayerGFXPool;
+/** Graphics that are being or have been read in the background and were not handed to their player yet */
+std::vector<std::unique_ptr<PlayerGFXLoad>> PlayerGFXLoads;
+SdlMutex PlayerGFXMutex;
+/** Number of times a graphic of the previous set was shown instead of stopping the game to load the new one */
+uint32_t PlayerGFXStallsAvoided;
+
+TaskPool *GetPlayerGFXPool()
+{
+	if (PlayerGFXPool == nullptr) {
+		if (SDL_GetCPUCount() <= 1)
+			return nullptr;
+		// Reading from the archives doesn't benefit from more workers
+		PlayerGFXPool = std::make_unique<TaskPool>(1);
+	}
+	return PlayerGFXPool.get();
+}
+
+int GetPlayerId(const Player &player)
+{
+	return static_cast<int>(&player - &Players[0]);
+}
+
+void ReadPlayerGFX(PlayerGFXLoad &load)
+{
+	std::unique_ptr<byte[]> data;
+	SDL_RWops *handle = OpenAsset(load.path.c_str(), /*threadsafe=*/true);
+	if (handle != nullptr) {
+		// A failed size query returns -1, which must not turn into a huge allocation
+		const Sint64 size = SDL_RWsize(handle);
+		if (size > 0) {
+			data = std::unique_ptr<byte[]> { new byte[size] };
+			if (SDL_RWread(handle, data.get(), static_cast<std::size_t>(size), 1) != 1)
+				data = nullptr;
+		}
+		SDL_RWclose(handle);
+	}
+
+	const std::lock_guard<SdlMutex> lock(PlayerGFXMutex);
+	load.data = std::move(data);
+	load.done = true;
+}
+
+/**
+ * @brief Starts reading a graphic of the current set of the player in the background.
+ * @return false if the player has no such graphic or it can't be read in the background
+ */
+bool RequestPlrGFX(const Player &player, player_graphic graphic)
+{
+	TaskPool *pool = GetPlayerGFXPool();
+	if (pool == nullptr)
+		return false;
+
+	char path[256];
+	int width;
+	if (!GetPlrGFXPath(player, graphic, path, width))
+		return false;
+
+	const int playerId = GetPlayerId(player);
+	const std::lock_guard<SdlMutex> lock(PlayerGFXMutex);
+	for (auto &load : PlayerGFXLoads) {
+		if (load->playerId == playerId && load->graphic == graphic && load->path == path)
+			return true;
+	}
+	auto load = std::make_unique<PlayerGFXLoad>();
+	load->playerId = playerId;
+	load->graphic = graphic;
+	load->path = path;
+	PlayerGFXLoad *target = load.get();
+	PlayerGFXLoads.push_back(std::move(load));
+	pool->Submit([target]() { ReadPlayerGFX(*target); });
+	return true;
+}
+
+bool IsPlrGFXLoading(const Player &player, player_graphic graphic)
+{
+	const int playerId = GetPlayerId(player);
+	const std::lock_guard<SdlMutex> lock(PlayerGFXMutex);
+	return std::any_of(PlayerGFXLoads.begin(), PlayerGFXLoads.end(), [&](const auto &load) {
+		return load->playerId == playerId && load->graphic == graphic;
+	});
+}
+
+bool ShowsPlrSprites(const Player &player, const PlayerAnimationData &animationData)
+{
+	for (const std::optional<CelSprite> &celSprite : animationData.CelSpritesForDirections) {
+		if (celSprite && (player.AnimInfo.celSprite == celSprite || player.previewCelSprite == celSprite))
+			return true;
+	}
+	return false;
+}
+
+void ReplacePlrSprite(std::optional<CelSprite> &sprite, const PlayerAnimationData &from, const PlayerAnimationData &to)
+{
+	for (size_t i = 0; i < from.CelSpritesForDirections.size(); i++) {
+		if (sprite && from.CelSpritesForDirections[i] == sprite) {
+			sprite = to.CelSpritesForDirections[i];
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Points the sprites the player is drawn with from one graphic to the same direction of another one.
+ */
+void ReplacePlrSprites(Player &player, const PlayerAnimationData &from, const PlayerAnimationData &to)
+{
+	ReplacePlrSprite(player.AnimInfo.celSprite, from, to);
+	ReplacePlrSprite(player.previewCelSprite, from, to);
+}
+
+void InstallPlrGFX(PlayerGFXLoad &load)
+{
+	Player &player = Players[load.playerId];
+	PlayerAnimationData &animationData = player.AnimationData[static_cast<size_t>(load.graphic)];
+	char path[256];
+	int width;
+	// Drop graphics of a set the player no longer uses
+	if (load.data == nullptr || animationData.RawData != nullptr || !GetPlrGFXPath(player, load.graphic, path, width) || load.path != path)
+		return;
+
+	animationData.RawData = std::move(load.data);
+	SetPlayerSprites(animationData.RawData.get(), animationData.CelSpritesForDirections, width);
+	ReplacePlrSprites(player, player.PreviousAnimationData[static_cast<size_t>(load.graphic)], animationData);
+}
+
+/**
+ * @brief Frees the graphics of the previous set once the player doesn't wait for any other graphic.
+ */
+void ReleasePreviousPlrGFX(Player &player)
+{
+	for (size_t i = 0; i < player.PreviousAnimationData.size(); i++) {
+		PlayerAnimationData &previous = player.PreviousAnimationData[i];
+		if (previous.RawData == nullptr)
+			continue;
+		// The graphic could not be read in the background
+		if (ShowsPlrSprites(player, previous))
+			LoadPlrGFX(player, static_cast<player_graphic>(i));
+		ReplacePlrSprites(player, previous, player.AnimationData[i]);
+		previous = {};
 	}
 }
 
@@ -2200,8 +2481,7 @@ void Player::UpdatePreviewCelSprite(_cmd_id cmdId, Point point, uint16_t wParam1
 	if (!graphic)
 		return;
 
-	LoadPlrGFX(*this, *graphic);
-	std::optional<CelSprite> celSprites = AnimationData[static_cast<size_t>(*graphic)].GetCelSpritesForDirection(dir);
+	std::optional<CelSprite> celSprites = GetPlayerSprite(*this, *graphic, dir);
 	if (celSprites && previewCelSprite != celSprites) {
 		previewCelSprite = celSprites;
 		progressToNextGameTickWhenPreviewWasSet = gfProgressToNextGameTick;
@@ -2214,114 +2494,11 @@ void LoadPlrGFX(Player &player, player_graphic graphic)
 	if (animationData.RawData != nullptr)
 		return;
 
-	char prefix[16];
-	char pszName[256];
-	const char *szCel;
-
-	HeroClass c = player._pClass;
-	if (c == HeroClass::Bard && !hfbard_mpq) {
-		c = HeroClass::Rogue;
-	} else if (c == HeroClass::Barbarian && !hfbarb_mpq) {
-		c = HeroClass::Warrior;
-	}
-
-	auto animWeaponId = static_cast<PlayerWeaponGraphic>(player._pgfxnum & 0xF);
-	int animationWidth = 96;
-	bool useUnarmedAnimationInTown = false;
-
-	const char *cs = ClassPathTbl[static_cast<std::size_t>(c)];
-
-	switch (graphic) {
-	case player_graphic::Stand:
-		szCel = "AS";
-		if (leveltype == DTYPE_TOWN)
-			szCel = "ST";
-		if (c == HeroClass::Monk)
-			animationWidth = 112;
-		break;
-	case player_graphic::Walk:
-		szCel = "AW";
-		if (leveltype == DTYPE_TOWN)
-			szCel = "WL";
-		if (c == HeroClass::Monk)
-			animationWidth = 112;
-		break;
-	case player_graphic::Attack:
-		if (leveltype == DTYPE_TOWN)
-			return;
-		szCel = "AT";
-		if (c == HeroClass::Monk)
-			animationWidth = 130;
-		else if (animWeaponId != PlayerWeaponGraphic::Bow || !(c == HeroClass::Warrior || c == HeroClass::Barbarian))
-			animationWidth = 128;
-		break;
-	case player_graphic::Hit:
-		if (leveltype == DTYPE_TOWN)
-			return;
-		szCel = "HT";
-		if (c == HeroClass::Monk)
-			animationWidth = 98;
-		break;
-	case player_graphic::Lightning:
-		szCel = "LM";
-		useUnarmedAnimationInTown = true;
-		if (c == HeroClass::Monk)
-			animationWidth = 114;
-		else if (c == HeroClass::Sorcerer)
-			animationWidth = 128;
-		break;
-	case player_graphic::Fire:
-		szCel = "FM";
-		useUnarmedAnimationInTown = true;
-		if (c == HeroClass::Monk)
-			animationWidth = 114;
-		else if (c == HeroClass::Sorcerer)
-			animationWidth = 128;
-		break;
-	case player_graphic::Magic:
-		szCel = "QM";
-		useUnarmedAnimationInTown = true;
-		if (c == HeroClass::Monk)
-			animationWidth = 114;
-		else if (c == HeroClass::Sorcerer)
-			animationWidth = 128;
-		break;
-	case player_graphic::Death:
-		if (animWeaponId != PlayerWeaponGraphic::Unarmed)
-			return;
-		szCel = "DT";
-		animationWidth = (c == HeroClass::Monk) ? 160 : 128;
-		break;
-	case player_graphic::Block:
-		if (leveltype == DTYPE_TOWN)
-			return;
-		if (!player._pBlockFlag)
-			return;
-		szCel = "BL";
-		if (c == HeroClass::Monk)
-			animationWidth = 98;
-		break;
-	default:
-		app_fatal("PLR:2");
-	}
-
-	if (leveltype == DTYPE_TOWN && useUnarmedAnimationInTown) {
-		// If the hero doesn't hold the weapon in town then we should use the unarmed animation for casting
-		switch (animWeaponId) {
-		case PlayerWeaponGraphic::Mace:
-		case PlayerWeaponGraphic::Sword:
-			animWeaponId = PlayerWeaponGraphic::Unarmed;
-			break;
-		case PlayerWeaponGraphic::SwordShield:
-		case PlayerWeaponGraphic::MaceShield:
-			animWeaponId = PlayerWeaponGraphic::UnarmedShield;
-			break;
-		}
-	}
-
-	sprintf(prefix, "%c%c%c", CharChar[static_cast<std::size_t>(c)], ArmourChar[player._pgfxnum >> 4], WepChar[static_cast<std::size_t>(animWeaponId)]);
-	sprintf(pszName, R"(PlrGFX\%s\%s\%s%s.CL2)", cs, prefix, prefix, szCel);
-	SetPlayerGPtrs(pszName, animationData.RawData, animationData.CelSpritesForDirections, animationWidth);
+	char path[256];
+	int width;
+	if (!GetPlrGFXPath(player, graphic, path, width))
+		return;
+	SetPlayerGPtrs(path, animationData.RawData, animationData.CelSpritesForDirections, width);
 }
 
 void InitPlayerGFX(Player &player)
@@ -2350,13 +2527,90 @@ void ResetPlayerGFX(Player &player)
 			celSprite = std::nullopt;
 		animData.RawData = nullptr;
 	}
+	player.PreviousAnimationData = {};
 }
 
-void NewPlrAnim(Player &player, player_graphic graphic, Direction dir, int numberOfFrames, int delayLen, AnimationDistributionFlags flags /*= AnimationDistributionFlags::None*/, int numSkippedFrames /*= 0*/, int distributeFramesBeforeFrame /*= 0*/)
+void ChangePlayerGFX(Player &player)
+{
+	if (GetPlayerGFXPool() == nullptr) {
+		ResetPlayerGFX(player);
+		return;
+	}
+
+	for (size_t i = 0; i < player.AnimationData.size(); i++) {
+		PlayerAnimationData &animationData = player.AnimationData[i];
+		PlayerAnimationData &previous = player.PreviousAnimationData[i];
+		if (animationData.RawData == nullptr && previous.RawData == nullptr)
+			continue;
+		if (animationData.RawData != nullptr) {
+			// Changed again before the last change finished loading, keep the newest graphic
+			ReplacePlrSprites(player, previous, animationData);
+			previous = std::move(animationData);
+			animationData = {};
+		}
+		RequestPlrGFX(player, static_cast<player_graphic>(i));
+	}
+}
+
+std::optional<CelSprite> GetPlayerSprite(Player &player, player_graphic graphic, Direction dir)
 {
+	const auto index = static_cast<size_t>(graphic);
+	const PlayerAnimationData &previous = player.PreviousAnimationData[index];
+	if (player.AnimationData[index].RawData == nullptr && previous.RawData != nullptr && IsPlrGFXLoading(player, graphic)) {
+		PlayerGFXStallsAvoided++;
+		return previous.GetCelSpritesForDirection(dir);
+	}
+
 	LoadPlrGFX(player, graphic);
+	return player.AnimationData[index].GetCelSpritesForDirection(dir);
+}
+
+void ProcessPlayerGFXLoads()
+{
+	std::vector<std::unique_ptr<PlayerGFXLoad>> finished;
+	std::array<bool, MAX_PLRS> loading {};
+	{
+		const std::lock_guard<SdlMutex> lock(PlayerGFXMutex);
+		for (auto &load : PlayerGFXLoads) {
+			if (load->done)
+				finished.push_back(std::move(load));
+			else
+				loading[load->playerId] = true;
+		}
+		PlayerGFXLoads.erase(std::remove(PlayerGFXLoads.begin(), PlayerGFXLoads.end(), nullptr), PlayerGFXLoads.end());
+	}
+
+	for (auto &load : finished)
+		InstallPlrGFX(*load);
+	for (int i = 0; i < MAX_PLRS; i++) {
+		if (!loading[i])
+			ReleasePreviousPlrGFX(Players[i]);
+	}
+}
+
+void ClearPlayerGFXLoads()
+{
+	if (PlayerGFXPool != nullptr)
+		PlayerGFXPool->Wait();
+	const std::lock_guard<SdlMutex> lock(PlayerGFXMutex);
+	PlayerGFXLoads.clear();
+}
 
-	std::optional<CelSprite> celSprite = player.AnimationData[static_cast<size_t>(graphic)].GetCelSpritesForDirection(dir);
+bool IsShowingPreviousPlayerGFX(const Player &player)
+{
+	return std::any_of(player.PreviousAnimationData.begin(), player.PreviousAnimationData.end(), [&](const PlayerAnimationData &previous) {
+		return previous.RawData != nullptr && ShowsPlrSprites(player, previous);
+	});
+}
+
+uint32_t GetPlayerGFXStallsAvoided()
+{
+	return PlayerGFXStallsAvoided;
+}
+
+void NewPlrAnim(Player &player, player_graphic graphic, Direction dir, int numberOfFrames, int delayLen, AnimationDistributionFlags flags /*= AnimationDistributionFlags::None*/, int numSkippedFrames /*= 0*/, int distributeFramesBeforeFrame /*= 0*/)
+{
+	std::optional<CelSprite> celSprite = GetPlayerSprite(player, graphic, dir);
 
 	float previewShownGameTickFragments = 0.F;
 	if (celSprite == player.previewCelSprite && !player.IsWalking())
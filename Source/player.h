@@ -301,6 +301,10 @@ struct Player {
 	 * @brief Contains Data (Sprites) for the different Animations
 	 */
 	std::array<PlayerAnimationData, enum_size<player_graphic>::value> AnimationData;
+	/**
+	 * @brief Graphics of the previous _pgfxnum, shown while the ones in AnimationData are read in the background
+	 */
+	std::array<PlayerAnimationData, enum_size<player_graphic>::value> PreviousAnimationData;
 	int _pNFrames;
 	int _pWFrames;
 	int _pAFrames;
@@ -718,6 +722,41 @@ void LoadPlrGFX(Player &player, player_graphic graphic);
 void InitPlayerGFX(Player &player);
 void ResetPlayerGFX(Player &player);
 
+/**
+ * @brief Switches the player to the graphics of the current _pgfxnum, reading them in the background.
+ *
+ * Until a graphic has been read the player is drawn with the same graphic of the previous set.
+ * Falls back to ResetPlayerGFX on single core systems.
+ */
+void ChangePlayerGFX(Player &player);
+
+/**
+ * @brief Returns the sprite of a player graphic, loading it unless the previous set can be shown while it is read.
+ */
+std::optional<CelSprite> GetPlayerSprite(Player &player, player_graphic graphic, Direction dir);
+
+/**
+ * @brief Hands the graphics that were read in the background to their players.
+ *
+ * Called once per game tick, so that the sprites of a player only change between frames.
+ */
+void ProcessPlayerGFXLoads();
+
+/**
+ * @brief Waits for the graphics that are read in the background and drops them.
+ */
+void ClearPlayerGFXLoads();
+
+/**
+ * @brief Returns whether the player is drawn with a graphic of the previous set.
+ */
+bool IsShowingPreviousPlayerGFX(const Player &player);
+
+/**
+ * @brief Returns how often a graphic of the previous set was shown instead of loading the new one on the spot.
+ */
+uint32_t GetPlayerGFXStallsAvoided();
+
 /**
  * @brief Sets the new Player Animation with all relevant information for rendering
  * @param graphic What player animation should be displayed
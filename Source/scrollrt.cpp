@@ -4,6 +4,8 @@
  * Implementation of functionality for rendering the dungeons, monsters and calling other render routines.
  */
 
+#include <limits>
+
 #include "DiabloUI/ui_flags.hpp"
 #include "automap.h"
 #include "controls/plrctrls.h"
@@ -12,6 +14,8 @@
 #include "dead.h"
 #include "doom.h"
 #include "dx.h"
+#include "engine/benchmark.hpp"
+#include "engine/dirty_region.hpp"
 #include "engine/render/cel_render.hpp"
 #include "engine/render/cl2_render.hpp"
 #include "engine/render/dun_render.hpp"
@@ -35,10 +39,13 @@
 #include "qol/stash.h"
 #include "qol/xpbar.h"
 #include "stores.h"
+#include "tile_store.h"
 #include "towners.h"
 #include "utils/display.h"
 #include "utils/endian.hpp"
 #include "utils/log.hpp"
+#include "utils/sdl_geometry.h"
+#include "utils/task_pool.hpp"
 
 #ifdef _DEBUG
 #include "debug.h"
@@ -49,7 +56,7 @@ namespace devilution {
 /**
  * Specifies the current light entry.
  */
-int LightTableIndex;
+DVL_RENDER_THREAD_LOCAL int LightTableIndex;
 
 /**
  * Specifies the current MIN block of the level CEL file, as used during rendering of the level tiles.
@@ -57,24 +64,24 @@ int LightTableIndex;
  * frameNum  := block & 0x0FFF
  * frameType := block & 0x7000 >> 12
  */
-uint32_t level_cel_block;
+DVL_RENDER_THREAD_LOCAL uint32_t level_cel_block;
 bool AutoMapShowItems;
 /**
  * Specifies the type of arches to render.
  */
-char arch_draw_type;
+DVL_RENDER_THREAD_LOCAL char arch_draw_type;
 /**
  * Specifies whether transparency is active for the current CEL file being decoded.
  */
-bool cel_transparency_active;
+DVL_RENDER_THREAD_LOCAL bool cel_transparency_active;
 /**
  * Specifies whether foliage (tile has extra content that overlaps previous tile) being rendered.
  */
-bool cel_foliage_active = false;
+DVL_RENDER_THREAD_LOCAL bool cel_foliage_active = false;
 /**
  * Specifies the current dungeon piece ID of the level, as used during rendering of the level tiles.
  */
-int level_piece_id;
+DVL_RENDER_THREAD_LOCAL int level_piece_id;
 
 // DevilutionX extension.
 extern void DrawControllerModifierHints(const Surface &out);
@@ -200,7 +207,66 @@ uint32_t sgdwCursWdt;
 BYTE sgSaveBack[8192];
 uint32_t sgdwCursHgtOld;
 
-bool dRendered[MAXDUNX][MAXDUNY];
+DVL_RENDER_THREAD_LOCAL bool dRendered[MAXDUNX][MAXDUNY];
+
+/** How far above the bottom of its tile the content of a tile row can reach, enough for the tallest sprites */
+constexpr int TileContentAbove = 10 * TILE_HEIGHT;
+/** How far below the bottom of its tile the content of a tile row can reach, walking units and missiles are offset by up to a tile */
+constexpr int TileContentBelow = 2 * TILE_HEIGHT;
+
+/**
+ * @brief Updates of state outside of the back buffer, collected by a render band and applied once all bands are done.
+ */
+struct DeferredRenderUpdates {
+	std::vector<std::pair<Point, bool>> deadPlayerFlags;
+	/** Item id and label position */
+	std::vector<std::pair<int, Point>> itemLabels;
+#ifdef _DEBUG
+	std::vector<std::pair<int, Point>> debugCoords;
+#endif
+};
+
+/**
+ * @brief A horizontal slice of the viewport that is rendered on its own.
+ *
+ * A band draws the tile rows whose content can reach it, clipped to its own part of the back buffer,
+ * so the result is the same as rendering the whole viewport at once. Every tile row is owned by exactly
+ * one band, which is the only one to update state outside of the back buffer for that row
+ * (item labels, dead player flags, debug info).
+ */
+struct RenderBand {
+	/** Offset of the band from the top of the viewport. */
+	int offsetY = 0;
+	/** Height of the band, 0 when the whole viewport is rendered at once. */
+	int height = 0;
+	/** Rows with their tile bottom in [ownedTop, ownedBottom) of the viewport are owned by this band. */
+	int ownedTop = std::numeric_limits<int>::min();
+	int ownedBottom = std::numeric_limits<int>::max();
+	/** Whether the row being drawn is owned by this band. */
+	bool ownsRow = true;
+	/** When set, the updates of owned rows are collected here instead of being applied right away. */
+	DeferredRenderUpdates *deferred = nullptr;
+};
+
+DVL_RENDER_THREAD_LOCAL RenderBand CurrentRenderBand;
+
+#ifndef DISABLE_RENDER_THREADS
+std::unique_ptr<TaskPool> RenderTaskPool;
+#endif
+
+/**
+ * @brief Starts drawing a row of tiles in the current band.
+ * @param targetBufferY Bottom of the row's tiles in the band's buffer
+ * @return Whether the row has to be drawn, false if none of its content can reach the band and another band owns it
+ */
+bool BeginRenderRow(int targetBufferY)
+{
+	const int viewportY = targetBufferY + CurrentRenderBand.offsetY;
+	CurrentRenderBand.ownsRow = viewportY >= CurrentRenderBand.ownedTop && viewportY < CurrentRenderBand.ownedBottom;
+	if (CurrentRenderBand.ownsRow || CurrentRenderBand.height == 0)
+		return true;
+	return targetBufferY > -TileContentBelow && targetBufferY < CurrentRenderBand.height + TileContentAbove;
+}
 
 int frameend;
 int framerate;
@@ -528,6 +594,9 @@ void DrawPlayer(const Surface &out, int pnum, Point tilePosition, Point targetBu
 	Point spriteBufferPosition = targetBufferPosition - Displacement { CalculateWidth2(sprite ? sprite->Width() : 96), 0 };
 
 	const uint32_t frames = LoadLE32(sprite->Data());
+	// The previous set that is shown while a new one is read can have fewer frames
+	if (nCel >= static_cast<int>(frames) && frames > 0 && frames <= 50 && IsShowingPreviousPlayerGFX(player))
+		nCel = static_cast<int>(frames) - 1;
 	if (nCel < 0 || frames > 50 || nCel >= static_cast<int>(frames)) {
 		const char *szMode = "unknown action";
 		if (player._pmode <= PM_QUIT)
@@ -578,16 +647,27 @@ void DrawPlayer(const Surface &out, int pnum, Point tilePosition, Point targetBu
  */
 void DrawDeadPlayer(const Surface &out, Point tilePosition, Point targetBufferPosition)
 {
-	dFlags[tilePosition.x][tilePosition.y] &= ~DungeonFlag::DeadPlayer;
+	bool containsDeadPlayer = false;
 
 	for (int i = 0; i < MAX_PLRS; i++) {
 		Player &player = Players[i];
 		if (player.plractive && player._pHitPoints == 0 && player.plrlevel == (BYTE)currlevel && player.position.tile == tilePosition) {
-			dFlags[tilePosition.x][tilePosition.y] |= DungeonFlag::DeadPlayer;
+			containsDeadPlayer = true;
 			const Point playerRenderPosition { targetBufferPosition + player.position.offset };
 			DrawPlayer(out, i, tilePosition, playerRenderPosition);
 		}
 	}
+
+	if (!CurrentRenderBand.ownsRow)
+		return;
+	if (CurrentRenderBand.deferred != nullptr) {
+		CurrentRenderBand.deferred->deadPlayerFlags.emplace_back(tilePosition, containsDeadPlayer);
+		return;
+	}
+	if (containsDeadPlayer)
+		dFlags[tilePosition.x][tilePosition.y] |= DungeonFlag::DeadPlayer;
+	else
+		dFlags[tilePosition.x][tilePosition.y] &= ~DungeonFlag::DeadPlayer;
 }
 
 /**
@@ -654,10 +734,11 @@ static void DrawDungeon(const Surface & /*out*/, Point /*tilePosition*/, Point /
  */
 void DrawCell(const Surface &out, Point tilePosition, Point targetBufferPosition)
 {
+	const TileRenderData &tile = GetTileRenderData(tilePosition);
 	MICROS *pMap = &dpiece_defs_map_2[tilePosition.x][tilePosition.y];
-	level_piece_id = dPiece[tilePosition.x][tilePosition.y];
-	cel_transparency_active = nTransTable[level_piece_id] && TransList[dTransVal[tilePosition.x][tilePosition.y]];
-	cel_foliage_active = !nSolidTable[level_piece_id];
+	level_piece_id = tile.piece;
+	cel_transparency_active = HasAnyOf(tile.flags, TileRenderFlag::Transparent) && TransList[tile.transVal];
+	cel_foliage_active = !HasAnyOf(tile.flags, TileRenderFlag::Solid);
 	for (int i = 0; i < (MicroTileLen / 2); i++) {
 		level_cel_block = pMap->mt[2 * i];
 		if (level_cel_block != 0) {
@@ -682,16 +763,17 @@ void DrawCell(const Surface &out, Point tilePosition, Point targetBufferPosition
  */
 void DrawFloor(const Surface &out, Point tilePosition, Point targetBufferPosition)
 {
+	const TileRenderData &tile = GetTileRenderData(tilePosition);
 	cel_transparency_active = false;
-	LightTableIndex = dLight[tilePosition.x][tilePosition.y];
+	LightTableIndex = tile.light;
 
 	arch_draw_type = 1; // Left
-	level_cel_block = dpiece_defs_map_2[tilePosition.x][tilePosition.y].mt[0];
+	level_cel_block = tile.floor[0];
 	if (level_cel_block != 0) {
 		RenderTile(out, targetBufferPosition);
 	}
 	arch_draw_type = 2; // Right
-	level_cel_block = dpiece_defs_map_2[tilePosition.x][tilePosition.y].mt[1];
+	level_cel_block = tile.floor[1];
 	if (level_cel_block != 0) {
 		RenderTile(out, targetBufferPosition + Displacement { TILE_WIDTH / 2, 0 });
 	}
@@ -734,8 +816,13 @@ void DrawItem(const Surface &out, Point tilePosition, Point targetBufferPosition
 		CelBlitOutlineTo(out, GetOutlineColor(item, false), position, *cel, nCel);
 	}
 	CelClippedDrawLightTo(out, position, *cel, nCel);
-	if (item.AnimInfo.CurrentFrame == item.AnimInfo.NumberOfFrames - 1 || item._iCurs == ICURS_MAGIC_ROCK)
-		AddItemToLabelQueue(bItem - 1, px, targetBufferPosition.y);
+	if (CurrentRenderBand.ownsRow && (item.AnimInfo.CurrentFrame == item.AnimInfo.NumberOfFrames - 1 || item._iCurs == ICURS_MAGIC_ROCK)) {
+		const int labelY = targetBufferPosition.y + CurrentRenderBand.offsetY;
+		if (CurrentRenderBand.deferred != nullptr)
+			CurrentRenderBand.deferred->itemLabels.emplace_back(bItem - 1, Point { px, labelY });
+		else
+			AddItemToLabelQueue(bItem - 1, px, labelY);
+	}
 }
 
 /**
@@ -833,12 +920,13 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 		return;
 	dRendered[tilePosition.x][tilePosition.y] = true;
 
-	LightTableIndex = dLight[tilePosition.x][tilePosition.y];
+	const TileRenderData &tile = GetTileRenderData(tilePosition);
+	LightTableIndex = tile.light;
 
 	DrawCell(out, tilePosition, targetBufferPosition);
 
-	int8_t bDead = dCorpse[tilePosition.x][tilePosition.y];
-	int8_t bMap = dTransVal[tilePosition.x][tilePosition.y];
+	int8_t bDead = tile.corpse;
+	int8_t bMap = tile.transVal;
 
 #ifdef _DEBUG
 	if (DebugVision && IsTileLit(tilePosition)) {
@@ -876,10 +964,10 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 	if (TileContainsDeadPlayer(tilePosition)) {
 		DrawDeadPlayer(out, tilePosition, targetBufferPosition);
 	}
-	if (dPlayer[tilePosition.x][tilePosition.y] > 0) {
+	if (HasAnyOf(tile.flags, TileRenderFlag::Player)) {
 		DrawPlayerHelper(out, tilePosition, targetBufferPosition);
 	}
-	if (dMonster[tilePosition.x][tilePosition.y] > 0) {
+	if (HasAnyOf(tile.flags, TileRenderFlag::Monster)) {
 		DrawMonsterHelper(out, tilePosition, targetBufferPosition);
 	}
 	DrawMissile(out, tilePosition, targetBufferPosition, false);
@@ -887,7 +975,7 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 	DrawItem(out, tilePosition, targetBufferPosition, false);
 
 	if (leveltype != DTYPE_TOWN) {
-		char bArch = dSpecial[tilePosition.x][tilePosition.y];
+		char bArch = tile.special;
 		if (bArch != 0) {
 			cel_transparency_active = TransList[bMap];
 #ifdef _DEBUG
@@ -906,8 +994,8 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 		// Tree leaves should always cover player when entering or leaving the tile,
 		// So delay the rendering until after the next row is being drawn.
 		// This could probably have been better solved by sprites in screen space.
-		if (tilePosition.x > 0 && tilePosition.y > 0 && targetBufferPosition.y > TILE_HEIGHT) {
-			char bArch = dSpecial[tilePosition.x - 1][tilePosition.y - 1];
+		if (tilePosition.x > 0 && tilePosition.y > 0 && targetBufferPosition.y + CurrentRenderBand.offsetY > TILE_HEIGHT) {
+			char bArch = GetTileRenderData(tilePosition + Direction::North).special;
 			if (bArch != 0) {
 				CelDrawTo(out, targetBufferPosition + Displacement { 0, -TILE_HEIGHT }, *pSpecialCels, bArch - 1);
 			}
@@ -926,24 +1014,27 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 void DrawFloor(const Surface &out, Point tilePosition, Point targetBufferPosition, int rows, int columns)
 {
 	for (int i = 0; i < rows; i++) {
-		for (int j = 0; j < columns; j++) {
-			if (InDungeonBounds(tilePosition)) {
-				level_piece_id = dPiece[tilePosition.x][tilePosition.y];
-				if (level_piece_id != 0) {
-					if (!nSolidTable[level_piece_id])
-						DrawFloor(out, tilePosition, targetBufferPosition);
+		if (BeginRenderRow(targetBufferPosition.y)) {
+			for (int j = 0; j < columns; j++) {
+				if (InDungeonBounds(tilePosition)) {
+					const TileRenderData &tile = GetTileRenderData(tilePosition);
+					level_piece_id = tile.piece;
+					if (level_piece_id != 0) {
+						if (!HasAnyOf(tile.flags, TileRenderFlag::Solid))
+							DrawFloor(out, tilePosition, targetBufferPosition);
+					} else {
+						world_draw_black_tile(out, targetBufferPosition.x, targetBufferPosition.y);
+					}
 				} else {
 					world_draw_black_tile(out, targetBufferPosition.x, targetBufferPosition.y);
 				}
-			} else {
-				world_draw_black_tile(out, targetBufferPosition.x, targetBufferPosition.y);
+				tilePosition += Direction::East;
+				targetBufferPosition.x += TILE_WIDTH;
 			}
-			tilePosition += Direction::East;
-			targetBufferPosition.x += TILE_WIDTH;
+			// Return to start of row
+			tilePosition += Displacement(Direction::West) * columns;
+			targetBufferPosition.x -= columns * TILE_WIDTH;
 		}
-		// Return to start of row
-		tilePosition += Displacement(Direction::West) * columns;
-		targetBufferPosition.x -= columns * TILE_WIDTH;
 
 		// Jump to next row
 		targetBufferPosition.y += TILE_HEIGHT / 2;
@@ -959,8 +1050,17 @@ void DrawFloor(const Surface &out, Point tilePosition, Point targetBufferPositio
 	}
 }
 
-#define IsWall(x, y) (dPiece[x][y] == 0 || nSolidTable[dPiece[x][y]] || dSpecial[x][y] != 0)
-#define IsWalkable(x, y) (dPiece[x][y] != 0 && IsTileNotSolid({ x, y }))
+bool IsWall(int x, int y)
+{
+	const TileRenderData &tile = GetTileRenderData({ x, y });
+	return tile.piece == 0 || HasAnyOf(tile.flags, TileRenderFlag::Solid) || tile.special != 0;
+}
+
+bool IsWalkable(int x, int y)
+{
+	const TileRenderData &tile = GetTileRenderData({ x, y });
+	return tile.piece != 0 && !HasAnyOf(tile.flags, TileRenderFlag::Solid);
+}
 
 /**
  * @brief Render a row of tile
@@ -977,32 +1077,40 @@ void DrawTileContent(const Surface &out, Point tilePosition, Point targetBufferP
 	memset(dRendered, 0, sizeof(dRendered));
 
 	for (int i = 0; i < rows; i++) {
-		for (int j = 0; j < columns; j++) {
-			if (InDungeonBounds(tilePosition)) {
+		if (BeginRenderRow(targetBufferPosition.y)) {
+			for (int j = 0; j < columns; j++) {
+				if (InDungeonBounds(tilePosition)) {
 #ifdef _DEBUG
-				DebugCoordsMap[tilePosition.x + tilePosition.y * MAXDUNX] = targetBufferPosition;
+					if (CurrentRenderBand.ownsRow) {
+						const Point viewportPosition = targetBufferPosition + Displacement { 0, CurrentRenderBand.offsetY };
+						if (CurrentRenderBand.deferred != nullptr)
+							CurrentRenderBand.deferred->debugCoords.emplace_back(tilePosition.x + tilePosition.y * MAXDUNX, viewportPosition);
+						else
+							DebugCoordsMap[tilePosition.x + tilePosition.y * MAXDUNX] = viewportPosition;
+					}
 #endif
-				if (tilePosition.x + 1 < MAXDUNX && tilePosition.y - 1 >= 0 && targetBufferPosition.x + TILE_WIDTH <= gnScreenWidth) {
-					// Render objects behind walls first to prevent sprites, that are moving
-					// between tiles, from poking through the walls as they exceed the tile bounds.
-					// A proper fix for this would probably be to layout the sceen and render by
-					// sprite screen position rather than tile position.
-					if (IsWall(tilePosition.x, tilePosition.y) && (IsWall(tilePosition.x + 1, tilePosition.y) || (tilePosition.x > 0 && IsWall(tilePosition.x - 1, tilePosition.y)))) { // Part of a wall aligned on the x-axis
-						if (IsWalkable(tilePosition.x + 1, tilePosition.y - 1) && IsWalkable(tilePosition.x, tilePosition.y - 1)) {                                                     // Has walkable area behind it
-							DrawDungeon(out, tilePosition + Direction::East, { targetBufferPosition.x + TILE_WIDTH, targetBufferPosition.y });
+					if (tilePosition.x + 1 < MAXDUNX && tilePosition.y - 1 >= 0 && targetBufferPosition.x + TILE_WIDTH <= gnScreenWidth) {
+						// Render objects behind walls first to prevent sprites, that are moving
+						// between tiles, from poking through the walls as they exceed the tile bounds.
+						// A proper fix for this would probably be to layout the sceen and render by
+						// sprite screen position rather than tile position.
+						if (IsWall(tilePosition.x, tilePosition.y) && (IsWall(tilePosition.x + 1, tilePosition.y) || (tilePosition.x > 0 && IsWall(tilePosition.x - 1, tilePosition.y)))) { // Part of a wall aligned on the x-axis
+							if (IsWalkable(tilePosition.x + 1, tilePosition.y - 1) && IsWalkable(tilePosition.x, tilePosition.y - 1)) {                                                     // Has walkable area behind it
+								DrawDungeon(out, tilePosition + Direction::East, { targetBufferPosition.x + TILE_WIDTH, targetBufferPosition.y });
+							}
 						}
 					}
+					if (GetTileRenderData(tilePosition).piece != 0) {
+						DrawDungeon(out, tilePosition, targetBufferPosition);
+					}
 				}
-				if (dPiece[tilePosition.x][tilePosition.y] != 0) {
-					DrawDungeon(out, tilePosition, targetBufferPosition);
-				}
+				tilePosition += Direction::East;
+				targetBufferPosition.x += TILE_WIDTH;
 			}
-			tilePosition += Direction::East;
-			targetBufferPosition.x += TILE_WIDTH;
+			// Return to start of row
+			tilePosition += Displacement(Direction::West) * columns;
+			targetBufferPosition.x -= columns * TILE_WIDTH;
 		}
-		// Return to start of row
-		tilePosition += Displacement(Direction::West) * columns;
-		targetBufferPosition.x -= columns * TILE_WIDTH;
 
 		// Jump to next row
 		targetBufferPosition.y += TILE_HEIGHT / 2;
@@ -1073,6 +1181,132 @@ void Zoom(const Surface &out)
 	}
 }
 
+#ifndef DISABLE_RENDER_THREADS
+/**
+ * @brief Starts or stops render worker threads to match the Render Threads option and the number of CPU cores.
+ */
+void UpdateRenderTaskPool()
+{
+	const unsigned numWorkers = std::max(std::min(*sgOptions.Graphics.renderThreads, SDL_GetCPUCount()), 1) - 1;
+	const unsigned currentWorkers = RenderTaskPool != nullptr ? RenderTaskPool->NumWorkers() : 0;
+	if (numWorkers == currentWorkers)
+		return;
+
+	RenderTaskPool = nullptr;
+	if (numWorkers > 0)
+		RenderTaskPool = std::make_unique<TaskPool>(numWorkers);
+}
+
+/**
+ * @brief Applies the updates collected by a render band.
+ */
+void ApplyDeferredRenderUpdates(const DeferredRenderUpdates &updates)
+{
+	for (const auto &deadPlayerFlag : updates.deadPlayerFlags) {
+		const Point tile = deadPlayerFlag.first;
+		if (deadPlayerFlag.second)
+			dFlags[tile.x][tile.y] |= DungeonFlag::DeadPlayer;
+		else
+			dFlags[tile.x][tile.y] &= ~DungeonFlag::DeadPlayer;
+	}
+	for (const auto &itemLabel : updates.itemLabels) {
+		AddItemToLabelQueue(itemLabel.first, itemLabel.second.x, itemLabel.second.y);
+	}
+#ifdef _DEBUG
+	for (const auto &debugCoord : updates.debugCoords) {
+		DebugCoordsMap[debugCoord.first] = debugCoord.second;
+	}
+#endif
+}
+#endif
+
+/**
+ * @brief Area of the map that DrawFloor and DrawTileContent read for the given view
+ *
+ * Every row moves one tile further along either x or y and every column one tile east. The neighbours of
+ * drawn tiles are checked for walls, so one more tile is included on every side.
+ */
+Rectangle GetDrawnTileArea(Point tilePosition, int rows, int columns)
+{
+	rows += MicroTileLen;
+	const Point first = tilePosition + Displacement { -1, -columns - 2 };
+	const Point last = tilePosition + Displacement { rows / 2 + columns + 2, (rows + 1) / 2 + 1 };
+	return { first, Size { last.x - first.x + 1, last.y - first.y + 1 } };
+}
+
+/**
+ * @brief Render the floor and the tile content, split into horizontal bands if render threads are enabled
+ * @param out Buffer to render to
+ * @param tilePosition dPiece coordinates
+ * @param targetBufferPosition Target buffer coordinates
+ * @param rows Number of rows
+ * @param columns Tile in a row
+ */
+void DrawFloorAndTileContent(const Surface &out, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+{
+	UpdateTileRenderStore(GetDrawnTileArea(tilePosition, rows, columns));
+
+#ifndef DISABLE_RENDER_THREADS
+	UpdateRenderTaskPool();
+
+	const int numBands = RenderTaskPool != nullptr ? static_cast<int>(RenderTaskPool->NumWorkers()) + 1 : 1;
+	if (numBands == 1 || out.h() < numBands * TILE_HEIGHT) {
+#endif
+		DrawFloor(out, tilePosition, targetBufferPosition, rows, columns);
+		DrawTileContent(out, tilePosition, targetBufferPosition, rows, columns);
+#ifndef DISABLE_RENDER_THREADS
+		return;
+	}
+
+	// Every band starts out with the same render state as the serial path would.
+	const int lightTableIndex = LightTableIndex;
+	const uint32_t levelCelBlock = level_cel_block;
+	const char archDrawType = arch_draw_type;
+	const bool celTransparencyActive = cel_transparency_active;
+	const bool celFoliageActive = cel_foliage_active;
+	const int levelPieceId = level_piece_id;
+
+	std::vector<DeferredRenderUpdates> deferredUpdates(numBands);
+	const auto drawBand = [&](int band) {
+		const int top = out.h() * band / numBands;
+		const int bottom = out.h() * (band + 1) / numBands;
+
+		LightTableIndex = lightTableIndex;
+		level_cel_block = levelCelBlock;
+		arch_draw_type = archDrawType;
+		cel_transparency_active = celTransparencyActive;
+		cel_foliage_active = celFoliageActive;
+		level_piece_id = levelPieceId;
+		CurrentRenderBand.offsetY = top;
+		CurrentRenderBand.height = bottom - top;
+		// Rows above or below the viewport go to the outermost bands, so every row has an owner.
+		if (band != 0)
+			CurrentRenderBand.ownedTop = top;
+		if (band != numBands - 1)
+			CurrentRenderBand.ownedBottom = bottom;
+		CurrentRenderBand.deferred = &deferredUpdates[band];
+
+		const Surface bandOut = out.subregionY(top, bottom - top);
+		const Point bandPosition = targetBufferPosition - Displacement { 0, top };
+		DrawFloor(bandOut, tilePosition, bandPosition, rows, columns);
+		DrawTileContent(bandOut, tilePosition, bandPosition, rows, columns);
+
+		CurrentRenderBand = {};
+	};
+
+	for (int band = 1; band < numBands; band++) {
+		RenderTaskPool->Submit([&drawBand, band]() { drawBand(band); });
+	}
+	drawBand(0);
+	RenderTaskPool->Wait();
+
+	// Bands own consecutive rows, so applying their updates in order matches the serial path.
+	for (const DeferredRenderUpdates &updates : deferredUpdates) {
+		ApplyDeferredRenderUpdates(updates);
+	}
+#endif
+}
+
 Displacement tileOffset;
 Displacement tileShift;
 int tileColums;
@@ -1177,8 +1411,7 @@ void DrawGame(const Surface &fullOut, Point position)
 		break;
 	}
 
-	DrawFloor(out, position, { sx, sy }, rows, columns);
-	DrawTileContent(out, position, { sx, sy }, rows, columns);
+	DrawFloorAndTileContent(out, position, { sx, sy }, rows, columns);
 
 	if (!zoomflag) {
 		Zoom(fullOut.subregionY(0, gnViewportHeight));
@@ -1192,6 +1425,7 @@ void DrawGame(const Surface &fullOut, Point position)
  */
 void DrawView(const Surface &out, Point startPosition)
 {
+	BenchmarkSection drawViewSection("DrawView");
 #ifdef _DEBUG
 	DebugCoordsMap.clear();
 #endif
@@ -1345,28 +1579,7 @@ void DrawFPS(const Surface &out)
 }
 
 /**
- * @brief Update part of the screen from the back buffer
- * @param dwX Back buffer coordinate
- * @param dwY Back buffer coordinate
- * @param dwWdt Back buffer coordinate
- * @param dwHgt Back buffer coordinate
- */
-void DoBlitScreen(Sint16 dwX, Sint16 dwY, Uint16 dwWdt, Uint16 dwHgt)
-{
-	// In SDL1 SDL_Rect x and y are Sint16. Cast explicitly to avoid a compiler warning.
-	using CoordType = decltype(SDL_Rect {}.x);
-	SDL_Rect srcRect {
-		static_cast<CoordType>(dwX),
-		static_cast<CoordType>(dwY),
-		dwWdt, dwHgt
-	};
-	SDL_Rect dstRect { dwX, dwY, dwWdt, dwHgt };
-
-	BltFast(&srcRect, &dstRect);
-}
-
-/**
- * @brief Check render pipeline and blit individual screen parts
+ * @brief Check render pipeline and blit the changed screen parts
  * @param dwHgt Section of screen to update from top to bottom
  * @param draw_desc Render info box
  * @param draw_hp Render health bar
@@ -1382,43 +1595,52 @@ void DrawMain(int dwHgt, bool drawDesc, bool drawHp, bool drawMana, bool drawSba
 
 	assert(dwHgt >= 0 && dwHgt <= gnScreenHeight);
 
-	if (dwHgt > 0) {
-		DoBlitScreen(0, 0, gnScreenWidth, dwHgt);
-	}
+	// Overlapping and neighbouring parts are merged so that each pixel is only copied once.
+	DirtyRegion damage;
+	damage.Add({ { 0, 0 }, { gnScreenWidth, dwHgt } });
 	if (dwHgt < gnScreenHeight) {
 		const Point mainPanelPosition = GetMainPanel().position;
 		if (drawSbar) {
-			DoBlitScreen(mainPanelPosition.x + 204, mainPanelPosition.y + 5, 232, 28);
+			damage.Add({ mainPanelPosition + Displacement { 204, 5 }, { 232, 28 } });
 		}
 		if (drawDesc) {
-			DoBlitScreen(mainPanelPosition.x + 176, mainPanelPosition.y + 46, 288, 63);
+			damage.Add({ mainPanelPosition + Displacement { 176, 46 }, { 288, 63 } });
 		}
 		if (drawMana) {
-			DoBlitScreen(mainPanelPosition.x + 460, mainPanelPosition.y, 88, 72);
-			DoBlitScreen(mainPanelPosition.x + 564, mainPanelPosition.y + 64, 56, 56);
+			damage.Add({ mainPanelPosition + Displacement { 460, 0 }, { 88, 72 } });
+			damage.Add({ mainPanelPosition + Displacement { 564, 64 }, { 56, 56 } });
 		}
 		if (drawHp) {
-			DoBlitScreen(mainPanelPosition.x + 96, mainPanelPosition.y, 88, 72);
+			damage.Add({ mainPanelPosition + Displacement { 96, 0 }, { 88, 72 } });
 		}
 		if (drawBtn) {
-			DoBlitScreen(mainPanelPosition.x + 8, mainPanelPosition.y + 5, 72, 119);
-			DoBlitScreen(mainPanelPosition.x + 556, mainPanelPosition.y + 5, 72, 48);
+			damage.Add({ mainPanelPosition + Displacement { 8, 5 }, { 72, 119 } });
+			damage.Add({ mainPanelPosition + Displacement { 556, 5 }, { 72, 48 } });
 			if (gbIsMultiplayer) {
-				DoBlitScreen(mainPanelPosition.x + 84, mainPanelPosition.y + 91, 36, 32);
-				DoBlitScreen(mainPanelPosition.x + 524, mainPanelPosition.y + 91, 36, 32);
+				damage.Add({ mainPanelPosition + Displacement { 84, 91 }, { 36, 32 } });
+				damage.Add({ mainPanelPosition + Displacement { 524, 91 }, { 36, 32 } });
 			}
 		}
-		if (sgdwCursWdtOld != 0) {
-			DoBlitScreen(sgdwCursXOld, sgdwCursYOld, sgdwCursWdtOld, sgdwCursHgtOld);
-		}
-		if (sgdwCursWdt != 0) {
-			DoBlitScreen(sgdwCursX, sgdwCursY, sgdwCursWdt, sgdwCursHgt);
-		}
+		damage.Add({ { sgdwCursXOld, sgdwCursYOld }, { static_cast<int>(sgdwCursWdtOld), static_cast<int>(sgdwCursHgtOld) } });
+		damage.Add({ { sgdwCursX, sgdwCursY }, { static_cast<int>(sgdwCursWdt), static_cast<int>(sgdwCursHgt) } });
+	}
+
+	for (const Rectangle &rect : damage.Rects()) {
+		SDL_Rect srcRect = MakeSdlRect(rect);
+		SDL_Rect dstRect = srcRect;
+		BltFast(&srcRect, &dstRect);
 	}
 }
 
 } // namespace
 
+#ifdef BUILD_TESTING
+void TestDrawFloorAndTileContent(const Surface &out, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+{
+	DrawFloorAndTileContent(out, tilePosition, targetBufferPosition, rows, columns);
+}
+#endif
+
 Displacement GetOffsetForWalking(const AnimationInfo &animationInfo, const Direction dir, bool cameraMode /*= false*/)
 {
 	// clang-format off
@@ -1712,6 +1934,8 @@ void DrawAndBlit()
 
 	force_redraw = 0;
 
+	BenchmarkSection drawSection("Draw");
+
 	const Surface &out = GlobalBackBuffer();
 	UndrawCursor(out);
 
@@ -1753,9 +1977,11 @@ void DrawAndBlit()
 
 	DrawFPS(out);
 
-	DrawMain(hgt, ddsdesc, drawhpflag, drawmanaflag, drawsbarflag, drawbtnflag);
-
-	RenderPresent();
+	// Benchmarks only render to the back buffer so that the timings don't depend on the display.
+	if (ActiveBenchmark == nullptr) {
+		DrawMain(hgt, ddsdesc, drawhpflag, drawmanaflag, drawsbarflag, drawbtnflag);
+		RenderPresent();
+	}
 
 	drawhpflag = false;
 	drawmanaflag = false;
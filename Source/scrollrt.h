@@ -25,12 +25,19 @@ enum class ScrollDirection : uint8_t {
 	NorthWest,
 };
 
-extern int LightTableIndex;
-extern uint32_t level_cel_block;
-extern char arch_draw_type;
-extern bool cel_transparency_active;
-extern bool cel_foliage_active;
-extern int level_piece_id;
+#ifdef DISABLE_RENDER_THREADS
+#define DVL_RENDER_THREAD_LOCAL
+#else
+/** The dungeon can be rendered in bands on worker threads, each with its own per-tile render state. */
+#define DVL_RENDER_THREAD_LOCAL thread_local
+#endif
+
+extern DVL_RENDER_THREAD_LOCAL int LightTableIndex;
+extern DVL_RENDER_THREAD_LOCAL uint32_t level_cel_block;
+extern DVL_RENDER_THREAD_LOCAL char arch_draw_type;
+extern DVL_RENDER_THREAD_LOCAL bool cel_transparency_active;
+extern DVL_RENDER_THREAD_LOCAL bool cel_foliage_active;
+extern DVL_RENDER_THREAD_LOCAL int level_piece_id;
 extern bool AutoMapShowItems;
 extern bool frameflag;
 
@@ -5,10 +5,9 @@
  */
 #include "sound.h"
 
+#include <array>
 #include <cstdint>
-#include <list>
 #include <memory>
-#include <mutex>
 
 #include <SDL.h>
 
@@ -17,7 +16,6 @@
 #include "options.h"
 #include "utils/log.hpp"
 #include "utils/math.h"
-#include "utils/sdl_mutex.h"
 #include "utils/stdcompat/algorithm.hpp"
 #include "utils/stdcompat/optional.hpp"
 #include "utils/stdcompat/shared_ptr_array.hpp"
@@ -91,27 +89,56 @@ bool LoadAudioFile(const char *path, bool stream, bool errorDialog, SoundSample
 	return true;
 }
 
-std::list<std::unique_ptr<SoundSample>> duplicateSounds;
-std::optional<SdlMutex> duplicateSoundsMutex;
+/** Number of sounds that can play on top of sounds that are already playing */
+constexpr size_t MaxVoices = 32;
 
-SoundSample *DuplicateSound(const SoundSample &sound)
+/** Plays a sound that is already playing once more. */
+struct Voice {
+	SoundSample sample;
+	/** The audio the voice plays, nullptr for streamed sounds */
+	std::shared_ptr<const DecodedAudio> audio;
+};
+
+std::array<Voice, MaxVoices> Voices;
+/** Voices are picked round-robin, so the one that finished first is reused first */
+size_t NextVoice;
+
+/**
+ * @brief Returns a voice that is set up to play the sound, nullptr if all voices are busy.
+ *
+ * The sound is decoded once and shared by all voices playing it. A voice that played
+ * the same sound before is reused as is, otherwise an idle voice is switched over.
+ */
+SoundSample *GetVoice(SoundSample &sound)
 {
-	auto duplicate = std::make_unique<SoundSample>();
-	if (duplicate->DuplicateFrom(sound) != 0)
+	const std::shared_ptr<const DecodedAudio> audio = sound.GetDecodedAudio();
+
+	std::optional<size_t> idleVoice;
+	for (size_t n = 0; n < MaxVoices; n++) {
+		const size_t i = (NextVoice + n) % MaxVoices;
+		Voice &voice = Voices[i];
+		if (voice.sample.IsPlaying())
+			continue;
+		if (audio != nullptr && voice.audio == audio) {
+			NextVoice = (i + 1) % MaxVoices;
+			return &voice.sample;
+		}
+		if (!idleVoice)
+			idleVoice = i;
+	}
+	if (!idleVoice)
+		return nullptr;
+
+	Voice &voice = Voices[*idleVoice];
+	const int error = audio != nullptr ? voice.sample.SetDecodedAudio(audio) : voice.sample.DuplicateFrom(sound);
+	if (error != 0) {
+		voice.sample.Release();
+		voice.audio = nullptr;
 		return nullptr;
-	auto *result = duplicate.get();
-	decltype(duplicateSounds.begin()) it;
-	{
-		const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-		duplicateSounds.push_back(std::move(duplicate));
-		it = duplicateSounds.end();
-		--it;
 	}
-	result->SetFinishCallback([it]([[maybe_unused]] Aulib::Stream &stream) {
-		const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-		duplicateSounds.erase(it);
-	});
-	return result;
+	voice.audio = audio;
+	NextVoice = (*idleVoice + 1) % MaxVoices;
+	return &voice.sample;
 }
 
 /** Maps from track ID to track name in spawn. */
@@ -146,8 +173,22 @@ int CapVolume(int volume)
 
 void ClearDuplicateSounds()
 {
-	const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-	duplicateSounds.clear();
+	for (Voice &voice : Voices) {
+		if (voice.sample.IsLoaded())
+			voice.sample.Stop();
+		voice.sample.Release();
+		voice.audio = nullptr;
+	}
+}
+
+void ReleaseIdleVoices()
+{
+	for (Voice &voice : Voices) {
+		if (voice.sample.IsPlaying())
+			continue;
+		voice.sample.Release();
+		voice.audio = nullptr;
+	}
 }
 
 void snd_play_snd(TSnd *pSnd, int lVolume, int lPan)
@@ -163,7 +204,7 @@ void snd_play_snd(TSnd *pSnd, int lVolume, int lPan)
 
 	SoundSample *sound = &pSnd->DSB;
 	if (sound->IsPlaying()) {
-		sound = DuplicateSound(*sound);
+		sound = GetVoice(*sound);
 		if (sound == nullptr)
 			return;
 	}
@@ -208,15 +249,14 @@ void snd_init()
 	LogVerbose(LogCategory::Audio, "Aulib sampleRate={} channels={} frameSize={} format={:#x}",
 	    Aulib::sampleRate(), Aulib::channelCount(), Aulib::frameSize(), Aulib::sampleFormat());
 
-	duplicateSoundsMutex.emplace();
 	gbSndInited = true;
 }
 
 void snd_deinit()
 {
 	if (gbSndInited) {
+		ClearDuplicateSounds();
 		Aulib::quit();
-		duplicateSoundsMutex = std::nullopt;
 	}
 
 	gbSndInited = false;
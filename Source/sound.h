@@ -54,6 +54,10 @@ extern bool gbSndInited;
 extern _music_id sgnMusicTrack;
 
 void ClearDuplicateSounds();
+/**
+ * @brief Frees the voices that are not playing, along with the decoded sounds they keep alive.
+ */
+void ReleaseIdleVoices();
 void snd_stop_snd(TSnd *pSnd);
 void snd_play_snd(TSnd *pSnd, int lVolume, int lPan);
 std::unique_ptr<TSnd> sound_file_load(const char *path, bool stream = false);
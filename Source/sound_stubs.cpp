@@ -12,6 +12,7 @@ _music_id sgnMusicTrack = NUM_MUSIC;
 // AllowShortFunctionsOnASingleLine: None
 // clang-format off
 void ClearDuplicateSounds() { }
+void ReleaseIdleVoices() { }
 void snd_play_snd(TSnd *pSnd, int lVolume, int lPan) { }
 std::unique_ptr<TSnd> sound_file_load(const char *path, bool stream) { return nullptr; }
 TSnd::~TSnd()
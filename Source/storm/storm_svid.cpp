@@ -219,6 +219,8 @@ bool BlitFrame()
 		}
 	}
 
+	// The frame was drawn straight to the output surface, bypassing `Blit`.
+	InvalidateOutputSurface();
 	RenderPresent();
 	return true;
 }
@@ -0,0 +1,48 @@
+/**
+ * @file tile_store.cpp
+ *
+ * Implementation of the packed copy of the per-tile data that is read while drawing the dungeon.
+ */
+#include "tile_store.h"
+
+#include <algorithm>
+
+namespace devilution {
+
+TileRenderData TileRenderStore[MAXDUNY][MAXDUNX];
+
+void UpdateTileRenderStore(Rectangle area)
+{
+	const int minX = std::max(area.position.x, 0);
+	const int minY = std::max(area.position.y, 0);
+	const int maxX = std::min(area.position.x + area.size.width, MAXDUNX);
+	const int maxY = std::min(area.position.y + area.size.height, MAXDUNY);
+
+	// The dungeon arrays are column-major, so walk them in memory order
+	for (int x = minX; x < maxX; x++) {
+		for (int y = minY; y < maxY; y++) {
+			TileRenderData &tile = TileRenderStore[y][x];
+			const int piece = dPiece[x][y];
+			tile.floor[0] = dpiece_defs_map_2[x][y].mt[0];
+			tile.floor[1] = dpiece_defs_map_2[x][y].mt[1];
+			tile.piece = static_cast<uint16_t>(piece);
+			tile.transVal = dTransVal[x][y];
+			tile.corpse = dCorpse[x][y];
+			tile.light = dLight[x][y];
+			tile.special = dSpecial[x][y];
+
+			TileRenderFlag flags = TileRenderFlag::None;
+			if (nSolidTable[piece])
+				flags |= TileRenderFlag::Solid;
+			if (nTransTable[piece])
+				flags |= TileRenderFlag::Transparent;
+			if (dPlayer[x][y] > 0)
+				flags |= TileRenderFlag::Player;
+			if (dMonster[x][y] > 0)
+				flags |= TileRenderFlag::Monster;
+			tile.flags = flags;
+		}
+	}
+}
+
+} // namespace devilution
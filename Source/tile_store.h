@@ -0,0 +1,72 @@
+/**
+ * @file tile_store.h
+ *
+ * Interface of the packed copy of the per-tile data that is read while drawing the dungeon.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "engine/point.hpp"
+#include "engine/rectangle.hpp"
+#include "gendung.h"
+#include "utils/attributes.h"
+#include "utils/enum_traits.h"
+
+namespace devilution {
+
+enum class TileRenderFlag : uint8_t {
+	// clang-format off
+	None        = 0,
+	/** nSolidTable is set for the piece */
+	Solid       = 1 << 0,
+	/** nTransTable is set for the piece */
+	Transparent = 1 << 1,
+	/** dPlayer is positive */
+	Player      = 1 << 2,
+	/** dMonster is positive */
+	Monster     = 1 << 3,
+	// clang-format on
+};
+use_enum_as_flags(TileRenderFlag);
+
+/**
+ * @brief The fields of one tile that are read for every drawn tile, packed into a single record.
+ *
+ * The dungeon arrays are column-major and spread over a dozen globals, while the renderer walks
+ * the map in screen rows. Copying the visible part into row-major records keeps the data that is
+ * read per tile in one place. The remaining micros of a tile stay in dpiece_defs_map_2.
+ */
+struct TileRenderData {
+	/** The two lowest micros of the piece, dpiece_defs_map_2 mt[0] and mt[1] */
+	uint16_t floor[2];
+	/** dPiece */
+	uint16_t piece;
+	/** dTransVal */
+	int8_t transVal;
+	/** dCorpse */
+	int8_t corpse;
+	/** dLight */
+	char light;
+	/** dSpecial */
+	char special;
+	TileRenderFlag flags;
+};
+
+/** Render data of every tile indexed as [y][x], only the area of the last UpdateTileRenderStore call is current. */
+extern DVL_API_FOR_TEST TileRenderData TileRenderStore[MAXDUNY][MAXDUNX];
+
+/**
+ * @brief Copies the tile data of an area of the map into TileRenderStore.
+ *
+ * Has to be called before drawing, after the dungeon arrays have been updated for the frame.
+ * @param area Tiles to update, parts outside of the map are ignored
+ */
+void UpdateTileRenderStore(Rectangle area);
+
+inline const TileRenderData &GetTileRenderData(Point position)
+{
+	return TileRenderStore[position.y][position.x];
+}
+
+} // namespace devilution
@@ -874,6 +874,32 @@ void CheckTriggers()
 	}
 }
 
+dungeon_type GetTriggerLevelType(const TriggerStruct &trigger)
+{
+	int level;
+	switch (trigger._tmsg) {
+	case WM_DIABNEXTLVL:
+		level = currlevel + 1;
+		break;
+	case WM_DIABPREVLVL:
+		level = currlevel - 1;
+		break;
+	case WM_DIABRTNLVL:
+		return ReturnLevelType;
+	case WM_DIABTOWNWARP:
+		level = trigger._tlvl;
+		break;
+	case WM_DIABTWARPUP:
+		return DTYPE_TOWN;
+	default:
+		return DTYPE_NONE;
+	}
+
+	if (setlevel || level < 0 || level >= NUMLEVELS)
+		return DTYPE_NONE;
+	return gnLevelTypeTbl[level];
+}
+
 bool EntranceBoundaryContains(Point entrance, Point position)
 {
 	constexpr Displacement entranceOffsets[7] = { { 0, 0 }, { -1, 0 }, { 0, -1 }, { -1, -1 }, { -2, -1 }, { -1, -2 }, { -2, -2 } };
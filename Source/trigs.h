@@ -39,6 +39,12 @@ void Freeupstairs();
 void CheckTrigForce();
 void CheckTriggers();
 
+/**
+ * @brief Returns the type of the level that the trigger leads to.
+ * @return DTYPE_NONE if the trigger does not lead to a known level
+ */
+dungeon_type GetTriggerLevelType(const TriggerStruct &trigger);
+
 /**
  * @brief Check if the provided position is in the entrance boundary of the entrance.
  * @param position The position to check against the entrance boundary.
@@ -338,6 +338,7 @@ void ReinitializeTexture()
 	SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, quality.c_str());
 
 	texture = SDLWrap::CreateTexture(renderer, SDL_PIXELFORMAT_RGB888, SDL_TEXTUREACCESS_STREAMING, gnScreenWidth, gnScreenHeight);
+	InvalidateOutputSurface();
 }
 
 void ReinitializeIntegerScale()
@@ -398,6 +399,7 @@ void ReinitializeRenderer()
 		Size windowSize = {};
 		SDL_GetWindowSize(ghMainWnd, &windowSize.width, &windowSize.height);
 		AdjustToScreenGeometry(windowSize);
+		InvalidateOutputSurface();
 	}
 #endif
 }
@@ -1,6 +1,7 @@
 #include "utils/file_util.h"
 
 #include <algorithm>
+#include <cerrno>
 #include <string>
 
 #include <SDL.h>
@@ -164,6 +165,116 @@ void RemoveFile(string_view lpFileName)
 #endif
 }
 
+bool CopyFileOverwrite(const char *from, const char *to)
+{
+#if defined(_WIN64) || defined(_WIN32)
+	const auto fromUtf16 = ToWideChar(from);
+	const auto toUtf16 = ToWideChar(to);
+	if (fromUtf16 == nullptr || toUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	if (!::CopyFileW(&fromUtf16[0], &toUtf16[0], /*bFailIfExists=*/FALSE)) {
+		LogError("CopyFileW: error code {}", ::GetLastError());
+		return false;
+	}
+	return true;
+#else
+	FILE *src = std::fopen(from, "rb");
+	if (src == nullptr)
+		return false;
+	FILE *dst = std::fopen(to, "wb");
+	if (dst == nullptr) {
+		std::fclose(src);
+		return false;
+	}
+	char buffer[4096];
+	bool result = true;
+	size_t len;
+	while ((len = std::fread(buffer, 1, sizeof(buffer), src)) != 0) {
+		if (std::fwrite(buffer, 1, len, dst) != len) {
+			result = false;
+			break;
+		}
+	}
+	if (std::ferror(src) != 0)
+		result = false;
+	std::fclose(src);
+	if (std::fclose(dst) != 0)
+		result = false;
+	if (!result)
+		Log("Failed to copy {} to {}", from, to);
+	return result;
+#endif
+}
+
+bool MoveFileOverwrite(const char *from, const char *to)
+{
+#if defined(_WIN64) || defined(_WIN32)
+	const auto fromUtf16 = ToWideChar(from);
+	const auto toUtf16 = ToWideChar(to);
+	if (fromUtf16 == nullptr || toUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	if (!::MoveFileExW(&fromUtf16[0], &toUtf16[0], MOVEFILE_REPLACE_EXISTING)) {
+		LogError("MoveFileExW: error code {}", ::GetLastError());
+		return false;
+	}
+	return true;
+#else
+	if (std::rename(from, to) != 0) {
+		Log("Failed to rename {} to {}", from, to);
+		return false;
+	}
+	return true;
+#endif
+}
+
+bool CreateDir(const char *path)
+{
+#if defined(_WIN64) || defined(_WIN32)
+	const auto pathUtf16 = ToWideChar(path);
+	if (pathUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	if (!::CreateDirectoryW(&pathUtf16[0], NULL) && ::GetLastError() != ERROR_ALREADY_EXISTS) {
+		LogError("CreateDirectoryW: error code {}", ::GetLastError());
+		return false;
+	}
+	return true;
+#else
+	if (::mkdir(path, 0755) != 0 && errno != EEXIST) {
+		Log("Failed to create directory {}", path);
+		return false;
+	}
+	return true;
+#endif
+}
+
+bool RemoveDir(const char *path)
+{
+#if defined(_WIN64) || defined(_WIN32)
+	const auto pathUtf16 = ToWideChar(path);
+	if (pathUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	if (!::RemoveDirectoryW(&pathUtf16[0])) {
+		LogError("RemoveDirectoryW: error code {}", ::GetLastError());
+		return false;
+	}
+	return true;
+#else
+	if (::rmdir(path) != 0) {
+		Log("Failed to remove directory {}", path);
+		return false;
+	}
+	return true;
+#endif
+}
+
 std::optional<std::fstream> CreateFileStream(const char *path, std::ios::openmode mode)
 {
 #if defined(_WIN64) || defined(_WIN32)
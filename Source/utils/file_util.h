@@ -15,6 +15,19 @@ bool FileExistsAndIsWriteable(const char *path);
 bool GetFileSize(const char *path, std::uintmax_t *size);
 bool ResizeFile(const char *path, std::uintmax_t size);
 void RemoveFile(string_view lpFileName);
+bool CopyFileOverwrite(const char *from, const char *to);
+/**
+ * @brief Renames a file, atomically replacing the destination if it exists.
+ */
+bool MoveFileOverwrite(const char *from, const char *to);
+/**
+ * @brief Creates a directory, succeeds if it exists already. The parent directory must exist.
+ */
+bool CreateDir(const char *path);
+/**
+ * @brief Removes an empty directory.
+ */
+bool RemoveDir(const char *path);
 std::optional<std::fstream> CreateFileStream(const char *path, std::ios::openmode mode);
 FILE *FOpen(const char *path, const char *mode);
 
@@ -0,0 +1,85 @@
+#include "pcm_aulib_decoder.h"
+
+#include <algorithm>
+
+#include <aulib.h>
+
+#include "appfat.h"
+
+namespace devilution {
+
+namespace {
+
+/**
+ * @brief The channel count of the samples returned by Aulib::Decoder::decode.
+ *
+ * decode() converts mono to stereo and stereo to mono to match the output device.
+ */
+int DecodedChannelCount(int sourceChannels)
+{
+	const int outputChannels = ::Aulib::channelCount();
+	if ((sourceChannels == 1 && outputChannels == 2) || (sourceChannels == 2 && outputChannels == 1))
+		return outputChannels;
+	return sourceChannels;
+}
+
+} // namespace
+
+std::shared_ptr<const DecodedAudio> DecodeAll(::Aulib::Decoder &decoder)
+{
+	auto audio = std::make_shared<DecodedAudio>();
+	audio->numChannels = DecodedChannelCount(decoder.getChannels());
+	audio->sampleRate = decoder.getRate();
+
+	// A multiple of any channel count the decoders support
+	constexpr int ChunkSize = 4096;
+	float chunk[ChunkSize];
+	while (true) {
+		bool callAgain = false;
+		const int numSamples = decoder.decode(chunk, ChunkSize, callAgain);
+		if (numSamples > 0)
+			audio->samples.insert(audio->samples.end(), chunk, chunk + numSamples);
+		else if (!callAgain)
+			break;
+	}
+
+	if (audio->samples.empty() || audio->numChannels <= 0 || audio->sampleRate <= 0)
+		return nullptr;
+	return audio;
+}
+
+bool PcmAulibDecoder::open([[maybe_unused]] SDL_RWops *rwops)
+{
+	assert(rwops == nullptr);
+	return true;
+}
+
+bool PcmAulibDecoder::rewind()
+{
+	pos_ = 0;
+	return true;
+}
+
+std::chrono::microseconds PcmAulibDecoder::duration() const
+{
+	const auto frames = static_cast<long long>(audio_->samples.size() / audio_->numChannels);
+	return std::chrono::microseconds { frames * 1000000 / audio_->sampleRate };
+}
+
+bool PcmAulibDecoder::seekToTime(std::chrono::microseconds pos)
+{
+	const auto frame = static_cast<std::size_t>(pos.count() * audio_->sampleRate / 1000000);
+	pos_ = std::min(frame * audio_->numChannels, audio_->samples.size());
+	return true;
+}
+
+int PcmAulibDecoder::doDecoding(float buf[], int len, bool &callAgain)
+{
+	callAgain = false;
+	const std::size_t count = std::min(static_cast<std::size_t>(len), audio_->samples.size() - pos_);
+	std::copy_n(audio_->samples.data() + pos_, count, buf);
+	pos_ += count;
+	return static_cast<int>(count);
+}
+
+} // namespace devilution
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <Aulib/Decoder.h>
+
+namespace devilution {
+
+/**
+ * @brief Audio that has been decoded into memory in full.
+ */
+struct DecodedAudio {
+	int numChannels;
+	int sampleRate;
+	/** Interleaved samples of all channels */
+	std::vector<float> samples;
+};
+
+/**
+ * @brief Decodes everything that is left in an opened decoder.
+ * @return nullptr if there was nothing to decode
+ */
+std::shared_ptr<const DecodedAudio> DecodeAll(::Aulib::Decoder &decoder);
+
+/**
+ * @brief A Decoder interface implementation that plays audio that was decoded in advance.
+ *
+ * Any number of decoders can share the same data, so playing a sound again does not decode it again.
+ */
+class PcmAulibDecoder final : public ::Aulib::Decoder {
+public:
+	explicit PcmAulibDecoder(std::shared_ptr<const DecodedAudio> audio)
+	    : audio_(std::move(audio))
+	{
+	}
+
+	bool open(SDL_RWops *rwops) override;
+
+	[[nodiscard]] int getChannels() const override
+	{
+		return audio_->numChannels;
+	}
+
+	[[nodiscard]] int getRate() const override
+	{
+		return audio_->sampleRate;
+	}
+
+	bool rewind() override;
+	[[nodiscard]] std::chrono::microseconds duration() const override;
+	bool seekToTime(std::chrono::microseconds pos) override;
+
+protected:
+	int doDecoding(float buf[], int len, bool &callAgain) override;
+
+private:
+	std::shared_ptr<const DecodedAudio> audio_;
+	std::size_t pos_ = 0;
+};
+
+} // namespace devilution
@@ -0,0 +1,236 @@
+/**
+ * @file pooled_list.hpp
+ *
+ * An ordered container that takes its elements from a pool of fixed-size blocks.
+ */
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace devilution {
+
+/**
+ * @brief A sequence of elements with stable addresses that are reused once removed.
+ *
+ * Elements live in blocks of `BlockSize` and are visited in insertion order through
+ * a contiguous array of pointers. Unlike std::list nothing is allocated once enough
+ * blocks exist, and elements added one after another sit next to each other in memory.
+ *
+ * Elements added while iterating are visited by the same loop, as with std::list.
+ * Removing elements keeps the order of the remaining ones.
+ *
+ * @tparam T element type, must be default constructible and move assignable.
+ * @tparam BlockSize number of elements allocated at once.
+ */
+template <typename T, std::size_t BlockSize = 64>
+class PooledList {
+	template <typename List, typename Value>
+	class Iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = T;
+		using pointer = Value *;
+		using reference = Value &;
+
+		Iterator() = default;
+
+		Iterator(List *list, std::size_t index)
+		    : list_(list)
+		    , index_(index)
+		{
+		}
+
+		reference operator*() const
+		{
+			return *list_->elements_[index_];
+		}
+
+		pointer operator->() const
+		{
+			return list_->elements_[index_];
+		}
+
+		Iterator &operator++()
+		{
+			index_++;
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			Iterator copy = *this;
+			index_++;
+			return copy;
+		}
+
+		/** The end iterator compares equal to any iterator that is past the current last element. */
+		bool operator==(const Iterator &other) const
+		{
+			const bool atEnd = IsAtEnd();
+			return atEnd == other.IsAtEnd() && (atEnd || index_ == other.index_);
+		}
+
+		bool operator!=(const Iterator &other) const
+		{
+			return !(*this == other);
+		}
+
+	private:
+		bool IsAtEnd() const
+		{
+			return list_ == nullptr || index_ >= list_->elements_.size();
+		}
+
+		List *list_ = nullptr;
+		std::size_t index_ = 0;
+	};
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using iterator = Iterator<PooledList, T>;
+	using const_iterator = Iterator<const PooledList, const T>;
+
+	PooledList() = default;
+
+	PooledList(const PooledList &) = delete;
+	PooledList &operator=(const PooledList &) = delete;
+
+	[[nodiscard]] size_type size() const // NOLINT(readability-identifier-naming)
+	{
+		return elements_.size();
+	}
+
+	[[nodiscard]] bool empty() const // NOLINT(readability-identifier-naming)
+	{
+		return elements_.empty();
+	}
+
+	[[nodiscard]] size_type max_size() const // NOLINT(readability-identifier-naming)
+	{
+		return elements_.max_size();
+	}
+
+	/**
+	 * @brief Number of elements that fit without allocating another block.
+	 */
+	[[nodiscard]] size_type capacity() const // NOLINT(readability-identifier-naming)
+	{
+		return blocks_.size() * BlockSize;
+	}
+
+	T &operator[](size_type pos)
+	{
+		return *elements_[pos];
+	}
+
+	const T &operator[](size_type pos) const
+	{
+		return *elements_[pos];
+	}
+
+	T &back() // NOLINT(readability-identifier-naming)
+	{
+		return *elements_.back();
+	}
+
+	iterator begin() // NOLINT(readability-identifier-naming)
+	{
+		return { this, 0 };
+	}
+
+	iterator end() // NOLINT(readability-identifier-naming)
+	{
+		return { this, static_cast<size_type>(-1) };
+	}
+
+	const_iterator begin() const // NOLINT(readability-identifier-naming)
+	{
+		return { this, 0 };
+	}
+
+	const_iterator end() const // NOLINT(readability-identifier-naming)
+	{
+		return { this, static_cast<size_type>(-1) };
+	}
+
+	const_iterator cbegin() const // NOLINT(readability-identifier-naming)
+	{
+		return begin();
+	}
+
+	const_iterator cend() const // NOLINT(readability-identifier-naming)
+	{
+		return end();
+	}
+
+	template <typename... Args>
+	T &emplace_back(Args &&...args) // NOLINT(readability-identifier-naming)
+	{
+		if (free_.empty())
+			AddBlock();
+		T *element = free_.back();
+		free_.pop_back();
+		*element = T(std::forward<Args>(args)...);
+		elements_.push_back(element);
+		return *element;
+	}
+
+	void push_back(const T &value) // NOLINT(readability-identifier-naming)
+	{
+		emplace_back(value);
+	}
+
+	/**
+	 * @brief Removes every element matching the predicate, which is called exactly once per element in order.
+	 */
+	template <typename Predicate>
+	void remove_if(Predicate pred) // NOLINT(readability-identifier-naming)
+	{
+		size_type kept = 0;
+		for (size_type i = 0; i < elements_.size(); i++) {
+			T *element = elements_[i];
+			if (pred(*element))
+				free_.push_back(element);
+			else
+				elements_[kept++] = element;
+		}
+		elements_.resize(kept);
+	}
+
+	/**
+	 * @brief Removes all elements, the blocks are kept for reuse.
+	 */
+	void clear() // NOLINT(readability-identifier-naming)
+	{
+		elements_.clear();
+		free_.clear();
+		for (size_type block = blocks_.size(); block-- > 0;) {
+			for (size_type i = BlockSize; i-- > 0;)
+				free_.push_back(&blocks_[block][i]);
+		}
+	}
+
+private:
+	void AddBlock()
+	{
+		blocks_.emplace_back(new T[BlockSize]);
+		T *block = blocks_.back().get();
+		// Hand out the slots of a new block from the front so that consecutive elements are adjacent
+		for (size_type i = BlockSize; i-- > 0;)
+			free_.push_back(&block[i]);
+	}
+
+	std::vector<std::unique_ptr<T[]>> blocks_;
+	/** Unused slots, the next one to use is at the back */
+	std::vector<T *> free_;
+	/** Elements in insertion order */
+	std::vector<T *> elements_;
+};
+
+} // namespace devilution
@@ -31,4 +31,9 @@ inline SDL_Rect MakeSdlRect(Rectangle rect)
 	return MakeSdlRect(rect.position.x, rect.position.y, rect.size.width, rect.size.height);
 }
 
+inline Rectangle MakeRectangle(const SDL_Rect &rect)
+{
+	return Rectangle { Point { rect.x, rect.y }, Size { rect.w, rect.h } };
+}
+
 } // namespace devilution
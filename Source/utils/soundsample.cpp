@@ -92,6 +92,7 @@ void SoundSample::Release()
 #ifndef STREAM_ALL_AUDIO
 	file_data_ = nullptr;
 	file_data_size_ = 0;
+	decoded_audio_ = nullptr;
 #endif
 }
 
@@ -155,6 +156,51 @@ int SoundSample::SetChunk(ArraySharedPtr<std::uint8_t> fileData, std::size_t dwB
 }
 #endif
 
+int SoundSample::SetDecodedAudio(std::shared_ptr<const DecodedAudio> audio)
+{
+#ifndef STREAM_ALL_AUDIO
+	file_data_ = nullptr;
+	file_data_size_ = 0;
+	decoded_audio_ = nullptr;
+#endif
+	file_path_.clear();
+	isMp3_ = false;
+	stream_ = std::make_unique<Aulib::Stream>(/*rwops=*/nullptr, std::make_unique<PcmAulibDecoder>(std::move(audio)), CreateAulibResampler(), /*closeRw=*/false);
+	if (!stream_->open()) {
+		stream_ = nullptr;
+		LogError(LogCategory::Audio, "Aulib::Stream::open (from SoundSample::SetDecodedAudio): {}", SDL_GetError());
+		return -1;
+	}
+	return 0;
+}
+
+std::shared_ptr<const DecodedAudio> SoundSample::GetDecodedAudio()
+{
+#ifdef STREAM_ALL_AUDIO
+	return nullptr;
+#else
+	if (decoded_audio_ != nullptr || IsStreaming())
+		return decoded_audio_;
+
+	SDL_RWops *buf = SDL_RWFromConstMem(file_data_.get(), file_data_size_);
+	if (buf == nullptr)
+		return nullptr;
+	std::unique_ptr<Aulib::Decoder> decoder = CreateDecoder(isMp3_);
+	if (decoder->open(buf))
+		decoded_audio_ = DecodeAll(*decoder);
+	decoder = nullptr;
+	SDL_RWclose(buf);
+	return decoded_audio_;
+#endif
+}
+
+void SoundSample::ReleaseDecodedAudio()
+{
+#ifndef STREAM_ALL_AUDIO
+	decoded_audio_ = nullptr;
+#endif
+}
+
 void SoundSample::SetVolume(int logVolume, int logMin, int logMax)
 {
 	stream_->setVolume(VolumeLogToLinear(logVolume, logMin, logMax));
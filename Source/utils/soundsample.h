@@ -7,6 +7,7 @@
 #include <Aulib/Stream.h>
 
 #include "sound_defs.hpp"
+#include "utils/pcm_aulib_decoder.h"
 #include "utils/stdcompat/shared_ptr_array.hpp"
 
 namespace devilution {
@@ -43,6 +44,23 @@ public:
 	int SetChunk(ArraySharedPtr<std::uint8_t> fileData, std::size_t dwBytes, bool isMp3);
 #endif
 
+	/**
+	 * @brief Sets the sample to play audio that was decoded in advance.
+	 * @return 0 on success, -1 otherwise
+	 */
+	int SetDecodedAudio(std::shared_ptr<const DecodedAudio> audio);
+
+	/**
+	 * @brief Returns the sample decoded into memory, the data is only decoded on the first call.
+	 * @return nullptr for streamed samples or if the data could not be decoded
+	 */
+	std::shared_ptr<const DecodedAudio> GetDecodedAudio();
+
+	/**
+	 * @brief Frees the decoded copy of the sample, it is decoded again when needed.
+	 */
+	void ReleaseDecodedAudio();
+
 #ifndef STREAM_ALL_AUDIO
 	[[nodiscard]] bool IsStreaming() const
 	{
@@ -107,6 +125,7 @@ private:
 	// Non-streaming audio fields:
 	ArraySharedPtr<std::uint8_t> file_data_;
 	std::size_t file_data_size_;
+	std::shared_ptr<const DecodedAudio> decoded_audio_;
 #endif
 
 	// Set for streaming audio to allow for duplicating it:
@@ -0,0 +1,77 @@
+#include "utils/task_pool.hpp"
+
+#include <mutex>
+
+namespace devilution {
+
+TaskPool::TaskPool(unsigned numWorkers)
+{
+	workers_.reserve(numWorkers);
+	for (unsigned i = 0; i < numWorkers; i++)
+		workers_.emplace_back(WorkerMain, this);
+}
+
+TaskPool::~TaskPool()
+{
+	Wait();
+	{
+		std::lock_guard<SdlMutex> lock(mutex_);
+		stopping_ = true;
+		taskAvailable_.broadcast();
+	}
+	for (SdlThread &worker : workers_)
+		worker.join();
+}
+
+void TaskPool::Submit(std::function<void()> task)
+{
+	std::lock_guard<SdlMutex> lock(mutex_);
+	tasks_.push_back(std::move(task));
+	pending_++;
+	taskAvailable_.signal();
+}
+
+void TaskPool::Wait()
+{
+	std::lock_guard<SdlMutex> lock(mutex_);
+	while (pending_ != 0) {
+		if (tasks_.empty()) {
+			tasksDone_.wait(mutex_);
+			continue;
+		}
+		std::function<void()> task = std::move(tasks_.front());
+		tasks_.pop_front();
+
+		mutex_.unlock();
+		task();
+		mutex_.lock();
+
+		if (--pending_ == 0)
+			tasksDone_.broadcast();
+	}
+}
+
+int SDLCALL TaskPool::WorkerMain(void *data)
+{
+	auto &pool = *static_cast<TaskPool *>(data);
+
+	std::lock_guard<SdlMutex> lock(pool.mutex_);
+	while (true) {
+		while (!pool.tasks_.empty()) {
+			std::function<void()> task = std::move(pool.tasks_.front());
+			pool.tasks_.pop_front();
+
+			pool.mutex_.unlock();
+			task();
+			pool.mutex_.lock();
+
+			if (--pool.pending_ == 0)
+				pool.tasksDone_.broadcast();
+		}
+		if (pool.stopping_)
+			return 0;
+		pool.taskAvailable_.wait(pool.mutex_);
+	}
+}
+
+} // namespace devilution
@@ -0,0 +1,65 @@
+/**
+ * @file task_pool.hpp
+ *
+ * A fixed set of worker threads that run queued tasks.
+ */
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+class TaskPool final {
+public:
+	/**
+	 * @brief Starts `numWorkers` worker threads.
+	 */
+	explicit TaskPool(unsigned numWorkers);
+
+	/**
+	 * @brief Finishes all queued tasks and joins the worker threads.
+	 */
+	~TaskPool();
+
+	TaskPool(const TaskPool &) = delete;
+	TaskPool(TaskPool &&) = delete;
+	TaskPool &operator=(const TaskPool &) = delete;
+	TaskPool &operator=(TaskPool &&) = delete;
+
+	unsigned NumWorkers() const
+	{
+		return static_cast<unsigned>(workers_.size());
+	}
+
+	/**
+	 * @brief Queues a task to be run on one of the worker threads.
+	 */
+	void Submit(std::function<void()> task);
+
+	/**
+	 * @brief Blocks until every submitted task has finished.
+	 *
+	 * The calling thread helps with running queued tasks while it waits.
+	 */
+	void Wait();
+
+private:
+	static int SDLCALL WorkerMain(void *data);
+
+	SdlMutex mutex_;
+	SdlCond taskAvailable_;
+	SdlCond tasksDone_;
+	std::deque<std::function<void()>> tasks_;
+	/** Number of tasks that are queued or running. */
+	unsigned pending_ = 0;
+	bool stopping_ = false;
+	std::vector<SdlThread> workers_;
+};
+
+} // namespace devilution
@@ -0,0 +1,61 @@
+#include "utils/task_queue.hpp"
+
+#include <mutex>
+
+namespace devilution {
+
+TaskQueue::TaskQueue()
+    : worker_(WorkerMain, this)
+{
+}
+
+TaskQueue::~TaskQueue()
+{
+	{
+		std::lock_guard<SdlMutex> lock(mutex_);
+		stopping_ = true;
+		taskAvailable_.signal();
+	}
+	worker_.join();
+}
+
+void TaskQueue::Submit(std::function<void()> task)
+{
+	std::lock_guard<SdlMutex> lock(mutex_);
+	tasks_.push_back(std::move(task));
+	taskAvailable_.signal();
+}
+
+void TaskQueue::Wait()
+{
+	std::lock_guard<SdlMutex> lock(mutex_);
+	while (busy_ || !tasks_.empty())
+		tasksDone_.wait(mutex_);
+}
+
+int SDLCALL TaskQueue::WorkerMain(void *data)
+{
+	auto &queue = *static_cast<TaskQueue *>(data);
+
+	std::lock_guard<SdlMutex> lock(queue.mutex_);
+	while (true) {
+		while (!queue.tasks_.empty()) {
+			std::function<void()> task = std::move(queue.tasks_.front());
+			queue.tasks_.pop_front();
+			queue.busy_ = true;
+
+			queue.mutex_.unlock();
+			task();
+			queue.mutex_.lock();
+
+			queue.busy_ = false;
+		}
+		queue.tasksDone_.broadcast();
+		// The queue is always drained before the worker stops.
+		if (queue.stopping_)
+			return 0;
+		queue.taskAvailable_.wait(queue.mutex_);
+	}
+}
+
+} // namespace devilution
@@ -0,0 +1,63 @@
+/**
+ * @file task_queue.hpp
+ *
+ * A background thread that runs queued tasks one after another.
+ */
+#pragma once
+
+#include <deque>
+#include <functional>
+
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+/**
+ * @brief Runs tasks on a single background thread in the order they were submitted.
+ *
+ * Unlike `TaskPool`, a task never runs concurrently with another one from the same queue,
+ * so tasks can share state without further locking.
+ */
+class TaskQueue final {
+public:
+	TaskQueue();
+
+	/**
+	 * @brief Finishes all queued tasks and joins the thread.
+	 */
+	~TaskQueue();
+
+	TaskQueue(const TaskQueue &) = delete;
+	TaskQueue(TaskQueue &&) = delete;
+	TaskQueue &operator=(const TaskQueue &) = delete;
+	TaskQueue &operator=(TaskQueue &&) = delete;
+
+	/**
+	 * @brief Queues a task to run after all previously submitted tasks.
+	 */
+	void Submit(std::function<void()> task);
+
+	/**
+	 * @brief Blocks until every submitted task has finished.
+	 *
+	 * Once this returns, the caller may access the state used by the tasks
+	 * until it submits the next task.
+	 */
+	void Wait();
+
+private:
+	static int SDLCALL WorkerMain(void *data);
+
+	SdlMutex mutex_;
+	SdlCond taskAvailable_;
+	SdlCond tasksDone_;
+	std::deque<std::function<void()>> tasks_;
+	/** Whether the worker is running a task that has already been removed from `tasks_`. */
+	bool busy_ = false;
+	bool stopping_ = false;
+	SdlThread worker_;
+};
+
+} // namespace devilution
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "engine/assets.hpp"
+#include "engine/benchmark.hpp"
+#include "utils/file_util.h"
+#include "utils/paths.h"
+
+using namespace devilution;
+
+namespace {
+
+/**
+ * @brief Opens every file once and returns the time each open took in milliseconds.
+ */
+std::vector<double> TimeOpenAssets(const std::vector<std::string> &names)
+{
+	std::vector<double> samplesMs;
+	for (const std::string &name : names) {
+		const auto start = std::chrono::steady_clock::now();
+		SDL_RWops *handle = OpenAsset(name.c_str());
+		samplesMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		if (handle != nullptr)
+			SDL_RWclose(handle);
+	}
+	return samplesMs;
+}
+
+} // namespace
+
+TEST(AssetsBenchmark, Lookup)
+{
+	paths::SetPrefPath("./");
+	InvalidateAssetIndex();
+
+	// Half of the names are found, like the .mp3 probe before every .wav in LoadAudioFile
+	std::vector<std::string> names;
+	for (int i = 0; i < 200; i++) {
+		names.push_back("Test_Assets_bench" + std::to_string(i) + (i % 2 == 0 ? ".wav" : ".mp3"));
+		if (i % 2 == 0) {
+			std::ofstream file(names.back(), std::ios::out | std::ios::trunc | std::ios::binary);
+			file << names.back();
+		}
+	}
+
+	const TimingSummary firstSummary = SummarizeTimings(TimeOpenAssets(names));
+	const TimingSummary indexedSummary = SummarizeTimings(TimeOpenAssets(names));
+	std::printf("OpenAsset of %zu names: first open mean %.4f ms, indexed open mean %.4f ms\n",
+	    names.size(), firstSummary.meanMs, indexedSummary.meanMs);
+
+	for (int i = 0; i < 200; i += 2)
+		RemoveFile(names[i]);
+	InvalidateAssetIndex();
+}
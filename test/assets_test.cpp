@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "diablo.h"
+#include "engine/assets.hpp"
+#include "engine/load_file.hpp"
+#include "init.h"
+#include "utils/file_util.h"
+#include "utils/paths.h"
+
+using namespace devilution;
+
+namespace {
+
+void WriteOverride(const std::string &name, const std::string &contents)
+{
+	std::ofstream file(name, std::ios::out | std::ios::trunc | std::ios::binary);
+	file << contents;
+}
+
+void WriteOverride(const std::string &name)
+{
+	WriteOverride(name, name);
+}
+
+std::string ReadAsset(const std::string &name)
+{
+	SDL_RWops *handle = OpenAsset(name.c_str());
+	if (handle == nullptr)
+		return {};
+	std::string contents(static_cast<std::size_t>(SDL_RWsize(handle)), '\0');
+	if (!contents.empty() && SDL_RWread(handle, &contents[0], contents.size(), 1) != 1)
+		contents.clear();
+	SDL_RWclose(handle);
+	return contents;
+}
+
+bool CanOpen(const char *filename)
+{
+	SDL_RWops *handle = OpenAsset(filename);
+	if (handle == nullptr)
+		return false;
+	SDL_RWclose(handle);
+	return true;
+}
+
+class AssetsTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		paths::SetPrefPath("./");
+		InvalidateAssetIndex();
+	}
+
+	void TearDown() override
+	{
+		InvalidateAssetIndex();
+	}
+};
+
+} // namespace
+
+TEST_F(AssetsTest, SearchesArchivesInOrder)
+{
+	const MpqSearchOrder diabloOrder = GetMpqSearchOrder(false);
+	const std::vector<std::optional<MpqArchive> *> diablo { &font_mpq, &lang_mpq, &devilutionx_mpq, &spawn_mpq, &diabdat_mpq };
+	EXPECT_EQ(std::vector<std::optional<MpqArchive> *>(diabloOrder.begin(), diabloOrder.end()), diablo);
+
+	const std::vector<std::optional<MpqArchive> *> hellfire { &font_mpq, &lang_mpq, &devilutionx_mpq,
+		&hfvoice_mpq, &hfmusic_mpq, &hfbarb_mpq, &hfbard_mpq, &hfmonk_mpq, &hellfire_mpq, &spawn_mpq, &diabdat_mpq };
+	const MpqSearchOrder hellfireOrder = GetMpqSearchOrder(true);
+	EXPECT_EQ(std::vector<std::optional<MpqArchive> *>(hellfireOrder.begin(), hellfireOrder.end()), hellfire);
+	// The orders are fixed, nothing is allocated per lookup
+	EXPECT_EQ(GetMpqSearchOrder(true).begin(), hellfireOrder.begin());
+}
+
+TEST_F(AssetsTest, RemembersMissingAssets)
+{
+	RemoveFile("Test_Assets_missing.wav");
+	EXPECT_FALSE(CanOpen("Test_Assets_missing.wav"));
+
+	WriteOverride("Test_Assets_missing.wav");
+	EXPECT_FALSE(CanOpen("Test_Assets_missing.wav"));
+
+	InvalidateAssetIndex();
+	EXPECT_TRUE(CanOpen("Test_Assets_missing.wav"));
+	RemoveFile("Test_Assets_missing.wav");
+}
+
+TEST_F(AssetsTest, OpensOverrides)
+{
+	WriteOverride("Test_Assets_override.txt");
+	for (int i = 0; i < 2; i++) {
+		SDL_RWops *handle = OpenAsset("Test_Assets_override.txt");
+		ASSERT_NE(handle, nullptr);
+		char contents[25] {};
+		EXPECT_EQ(SDL_RWread(handle, contents, sizeof(contents) - 1, 1), 1U);
+		EXPECT_STREQ(contents, "Test_Assets_override.txt");
+		SDL_RWclose(handle);
+	}
+	RemoveFile("Test_Assets_override.txt");
+}
+
+TEST_F(AssetsTest, OpensPreloadedAssets)
+{
+	if (SDL_GetCPUCount() <= 1)
+		GTEST_SKIP() << "Preloading needs a worker thread";
+
+	std::vector<std::string> names;
+	for (int i = 0; i < 20; i++) {
+		names.push_back("Test_Assets_preload" + std::to_string(i) + ".cel");
+		WriteOverride(names.back());
+	}
+	// Files that don't exist are looked up as usual when the preload fails
+	names.emplace_back("Test_Assets_preload_missing.cel");
+	PreloadAssets(names);
+	for (size_t i = 0; i + 1 < names.size(); i++) {
+		SDL_RWops *handle = OpenAsset(names[i].c_str());
+		ASSERT_NE(handle, nullptr) << names[i];
+		std::string contents(names[i].size(), '\0');
+		EXPECT_EQ(SDL_RWread(handle, &contents[0], contents.size(), 1), 1U);
+		EXPECT_EQ(contents, names[i]);
+		SDL_RWclose(handle);
+	}
+	EXPECT_FALSE(CanOpen(names.back().c_str()));
+
+	// Each preloaded copy is handed out once, nothing is left once the files are gone
+	for (size_t i = 0; i + 1 < names.size(); i++)
+		RemoveFile(names[i]);
+	InvalidateAssetIndex();
+	EXPECT_FALSE(CanOpen(names[0].c_str()));
+	ClearPreloadedAssets();
+}
+
+TEST_F(AssetsTest, OpensPrefetchedAssets)
+{
+	if (SDL_GetCPUCount() <= 1)
+		GTEST_SKIP() << "Prefetching needs a worker thread";
+
+	std::vector<std::string> names;
+	for (int i = 0; i < 4; i++) {
+		names.push_back("Test_Assets_prefetch" + std::to_string(i) + ".til");
+		WriteOverride(names.back());
+	}
+	// Walking up to the same entrance twice, then entering it
+	PrefetchAssets(names);
+	PrefetchAssets(names);
+	PreloadAssets(names);
+	for (const std::string &name : names) {
+		SDL_RWops *handle = OpenAsset(name.c_str());
+		ASSERT_NE(handle, nullptr) << name;
+		std::string contents(name.size(), '\0');
+		EXPECT_EQ(SDL_RWread(handle, &contents[0], contents.size(), 1), 1U);
+		EXPECT_EQ(contents, name);
+		SDL_RWclose(handle);
+	}
+
+	// Prefetched assets that are never opened are dropped
+	PrefetchAssets({ names[0] });
+	ClearPreloadedAssets();
+	for (const std::string &name : names)
+		RemoveFile(name);
+	InvalidateAssetIndex();
+	EXPECT_FALSE(CanOpen(names[0].c_str()));
+}
+
+TEST_F(AssetsTest, EvictsLeastRecentlyPrefetchedAssets)
+{
+	if (SDL_GetCPUCount() <= 1)
+		GTEST_SKIP() << "Prefetching needs a worker thread";
+
+	const std::vector<std::string> names { "Test_Assets_evict_a.til", "Test_Assets_evict_b.til", "Test_Assets_evict_c.til", "Test_Assets_evict_d.til" };
+	for (const std::string &name : names)
+		WriteOverride(name);
+	const std::size_t fileSize = names[0].size();
+	const std::size_t defaultBudget = SetPrefetchBudget(3 * fileSize);
+
+	PrefetchAssets({ names[0], names[1], names[2] });
+	WaitForPreloadedAssets();
+	// Requested again, so c is now the least recently requested
+	PrefetchAssets({ names[0] });
+	// Needed for sure, so b no longer counts towards the budget
+	PreloadAssets({ names[1] });
+	SetPrefetchBudget(fileSize);
+	// Only fits if the bytes of b were taken out of the budget, a is dropped for it
+	PrefetchAssets({ names[3] });
+	WaitForPreloadedAssets();
+
+	for (const std::string &name : names)
+		WriteOverride(name, "changed");
+	EXPECT_EQ(ReadAsset(names[0]), "changed");
+	EXPECT_EQ(ReadAsset(names[1]), names[1]);
+	EXPECT_EQ(ReadAsset(names[2]), "changed");
+	EXPECT_EQ(ReadAsset(names[3]), names[3]);
+
+	ClearPreloadedAssets();
+	SetPrefetchBudget(defaultBudget);
+	for (const std::string &name : names)
+		RemoveFile(name);
+}
+
+TEST_F(AssetsTest, KeepsPrefetchedAssetsAcrossLevelChanges)
+{
+	if (SDL_GetCPUCount() <= 1)
+		GTEST_SKIP() << "Prefetching needs a worker thread";
+
+	const std::string name = "Test_Assets_prefetch_level.til";
+	WriteOverride(name);
+	PrefetchAssets({ name });
+	WaitForPreloadedAssets();
+
+	// Every level transition frees the level data right before loading the next level
+	FreeGameMem();
+	WriteOverride(name, "changed");
+	std::size_t size;
+	std::unique_ptr<byte[]> data = LoadFileInMem<byte>(name.c_str(), &size);
+	ASSERT_NE(data, nullptr);
+	EXPECT_EQ(std::string(reinterpret_cast<const char *>(data.get()), size), name);
+
+	ClearPreloadedAssets();
+	RemoveFile(name);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include "engine/benchmark.hpp"
+
+using namespace devilution;
+
+TEST(BenchmarkTest, SummarizeTimings)
+{
+	std::vector<double> samples;
+	for (int i = 100; i >= 1; i--)
+		samples.push_back(i);
+
+	const TimingSummary summary = SummarizeTimings(samples);
+	EXPECT_EQ(summary.count, 100);
+	EXPECT_DOUBLE_EQ(summary.meanMs, 50.5);
+	EXPECT_DOUBLE_EQ(summary.p50Ms, 50);
+	EXPECT_DOUBLE_EQ(summary.p95Ms, 95);
+	EXPECT_DOUBLE_EQ(summary.p99Ms, 99);
+	EXPECT_DOUBLE_EQ(summary.maxMs, 100);
+}
+
+TEST(BenchmarkTest, SummarizeSingleAndNoTimings)
+{
+	const TimingSummary single = SummarizeTimings({ 4 });
+	EXPECT_EQ(single.count, 1);
+	EXPECT_DOUBLE_EQ(single.p50Ms, 4);
+	EXPECT_DOUBLE_EQ(single.p99Ms, 4);
+
+	const TimingSummary none = SummarizeTimings({});
+	EXPECT_EQ(none.count, 0);
+	EXPECT_DOUBLE_EQ(none.maxMs, 0);
+}
+
+TEST(BenchmarkTest, SectionsAreSummedPerFrame)
+{
+	using namespace std::chrono_literals;
+
+	BenchmarkRecorder recorder;
+	recorder.BeginFrame();
+	recorder.AddSectionTime("Draw", 2ms);
+	recorder.AddSectionTime("Draw", 3ms);
+	recorder.EndFrame();
+	recorder.BeginFrame();
+	recorder.AddSectionTime("ProcessMonsters", 1ms);
+	recorder.EndFrame();
+
+	EXPECT_EQ(recorder.FrameCount(), 2);
+	const std::string json = recorder.ToJson();
+	EXPECT_NE(json.find(R"("frames": 2)"), std::string::npos);
+	EXPECT_NE(json.find(R"("Draw": {"count": 1, "meanMs": 5.0000)"), std::string::npos) << json;
+	EXPECT_NE(json.find(R"("ProcessMonsters": {"count": 1, "meanMs": 1.0000)"), std::string::npos) << json;
+	EXPECT_NE(json.find(R"("frameTimesMs": [)"), std::string::npos);
+}
+
+TEST(BenchmarkTest, SectionsAreOnlyTimedWhileBenchmarking)
+{
+	BenchmarkRecorder recorder;
+	RunBenchmarkSection("Idle", [] {});
+
+	ActiveBenchmark = &recorder;
+	recorder.BeginFrame();
+	RunBenchmarkSection("Busy", [] {});
+	recorder.EndFrame();
+	ActiveBenchmark = nullptr;
+
+	const std::string json = recorder.ToJson();
+	EXPECT_EQ(json.find("Idle"), std::string::npos);
+	EXPECT_NE(json.find(R"("Busy": {"count": 1)"), std::string::npos) << json;
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+#include "diablo.h"
+#include "engine/demomode.h"
+#include "engine/random.hpp"
+#include "nthread.h"
+#include "utils/file_util.h"
+#include "utils/paths.h"
+
+using namespace devilution;
+
+namespace {
+
+constexpr int DemoNumber = 90;
+
+class DemoModeTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		prefPath_ = paths::PrefPath();
+		runGame_ = gbRunGame;
+		paths::SetPrefPath("./");
+		gbRunGame = true;
+	}
+
+	void TearDown() override
+	{
+		// Ends the playback like the game loop does, which closes the demo file
+		if (demo::IsRunning())
+			demo::NotifyGameLoopEnd();
+		RemoveFile("demo_90.dmo");
+		gbRunGame = runGame_;
+		paths::SetPrefPath(prefPath_);
+	}
+
+	static void StartRecording()
+	{
+		demo::InitRecording(DemoNumber, /*createDemoReference=*/false);
+		demo::NotifyGameLoopStart();
+		gbRunGame = true;
+	}
+
+	static void StopRecording()
+	{
+		demo::NotifyGameLoopEnd();
+		gbRunGame = true;
+	}
+
+	/**
+	 * @brief Plays back the next game loop iteration of the demo.
+	 * @return true if the game ran a game tick
+	 */
+	static bool PlayGameLoop()
+	{
+		bool drawGame = true;
+		bool processInput = true;
+		return demo::GetRunGameLoop(drawGame, processInput);
+	}
+
+private:
+	std::string prefPath_;
+	bool runGame_;
+};
+
+} // namespace
+
+TEST_F(DemoModeTest, PlaysBackRecording)
+{
+	SetRndSeed(42);
+	StartRecording();
+	gfProgressToNextGameTick = 0.F;
+	demo::RecordGameLoopResult(true);
+	gfProgressToNextGameTick = 0.25F;
+	tagMSG recorded { DVL_WM_KEYDOWN, 65, -7 };
+	demo::RecordMessage(&recorded);
+	gfProgressToNextGameTick = 0.5F;
+	demo::RecordGameLoopResult(false);
+	gfProgressToNextGameTick = 0.F;
+	demo::RecordGameLoopResult(true);
+	StopRecording();
+
+	demo::InitPlayBack(DemoNumber, /*timedemo=*/true);
+	EXPECT_TRUE(PlayGameLoop());
+	EXPECT_EQ(gfProgressToNextGameTick, 0.F);
+
+	tagMSG msg;
+	ASSERT_TRUE(demo::FetchMessage(&msg));
+	EXPECT_EQ(msg.message, static_cast<uint32_t>(DVL_WM_KEYDOWN));
+	EXPECT_EQ(msg.wParam, 65);
+	EXPECT_EQ(msg.lParam, -7);
+	EXPECT_EQ(gfProgressToNextGameTick, 0.25F);
+	EXPECT_FALSE(demo::FetchMessage(&msg));
+
+	EXPECT_FALSE(PlayGameLoop());
+	EXPECT_EQ(gfProgressToNextGameTick, 0.5F);
+	EXPECT_TRUE(PlayGameLoop());
+	EXPECT_TRUE(gbRunGame);
+	EXPECT_EQ(demo::GetDivergedTick(), std::nullopt);
+}
+
+TEST_F(DemoModeTest, StopsAtFirstChecksumMismatch)
+{
+	// Checksums are recorded before game tick 0 and 20
+	SetRndSeed(42);
+	StartRecording();
+	for (int i = 0; i <= 20; i++)
+		demo::RecordGameLoopResult(true);
+	StopRecording();
+
+	demo::InitPlayBack(DemoNumber, /*timedemo=*/true);
+	for (int i = 0; i < 20; i++)
+		ASSERT_TRUE(PlayGameLoop()) << "Game tick " << i;
+	EXPECT_EQ(demo::GetDivergedTick(), std::nullopt);
+
+	SetRndSeed(43);
+	EXPECT_FALSE(PlayGameLoop());
+	EXPECT_FALSE(gbRunGame);
+	EXPECT_EQ(demo::GetDivergedTick(), 20U);
+}
+
+TEST_F(DemoModeTest, PlaysBackCsvDemo)
+{
+	{
+		std::ofstream file("demo_90.dmo", std::ios::out | std::ios::trunc | std::ios::binary);
+		file << "0,0,640,480\n"
+		     << "0,0\n"
+		     << "2,0.25,256,65,0\n"
+		     << "1,0.5\n"
+		     << "0,0\n";
+	}
+
+	demo::InitPlayBack(DemoNumber, /*timedemo=*/true);
+	EXPECT_TRUE(PlayGameLoop());
+
+	tagMSG msg;
+	ASSERT_TRUE(demo::FetchMessage(&msg));
+	EXPECT_EQ(msg.message, static_cast<uint32_t>(DVL_WM_KEYDOWN));
+	EXPECT_EQ(msg.wParam, 65);
+	EXPECT_EQ(gfProgressToNextGameTick, 0.25F);
+
+	EXPECT_FALSE(PlayGameLoop());
+	EXPECT_EQ(gfProgressToNextGameTick, 0.5F);
+	EXPECT_TRUE(PlayGameLoop());
+	EXPECT_EQ(demo::GetDivergedTick(), std::nullopt);
+}
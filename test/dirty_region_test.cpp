@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "engine/dirty_region.hpp"
+
+using namespace devilution;
+
+namespace {
+
+bool Covers(const DirtyRegion &region, Point point)
+{
+	for (const Rectangle &rect : region.Rects()) {
+		if (rect.Contains(point))
+			return true;
+	}
+	return false;
+}
+
+} // namespace
+
+TEST(DirtyRegionTest, IgnoresEmptyRectangles)
+{
+	DirtyRegion region;
+	region.Add({ { 10, 10 }, { 0, 20 } });
+	region.Add({ { 10, 10 }, { 20, 0 } });
+	EXPECT_TRUE(region.IsEmpty());
+}
+
+TEST(DirtyRegionTest, MergesOverlappingAndTouching)
+{
+	DirtyRegion region;
+	region.Add({ { 0, 0 }, { 10, 10 } });
+	region.Add({ { 5, 5 }, { 10, 10 } });
+	ASSERT_EQ(region.Rects().size(), 1);
+	EXPECT_EQ(region.Rects()[0].position, Point(0, 0));
+	EXPECT_EQ(region.Rects()[0].size, Size(15, 15));
+
+	region.Add({ { 15, 0 }, { 5, 15 } });
+	ASSERT_EQ(region.Rects().size(), 1);
+	EXPECT_EQ(region.Rects()[0].size, Size(20, 15));
+}
+
+TEST(DirtyRegionTest, KeepsDistantRectanglesApart)
+{
+	DirtyRegion region;
+	region.Add({ { 0, 0 }, { 10, 10 } });
+	region.Add({ { 100, 100 }, { 10, 10 } });
+	EXPECT_EQ(region.Rects().size(), 2);
+	EXPECT_EQ(region.Area(), 200);
+}
+
+TEST(DirtyRegionTest, MergesRectanglesBridgedByNewOne)
+{
+	DirtyRegion region;
+	region.Add({ { 0, 0 }, { 10, 10 } });
+	region.Add({ { 20, 0 }, { 10, 10 } });
+	region.Add({ { 8, 0 }, { 14, 10 } });
+	ASSERT_EQ(region.Rects().size(), 1);
+	EXPECT_EQ(region.Rects()[0].size, Size(30, 10));
+}
+
+TEST(DirtyRegionTest, LimitsNumberOfRectangles)
+{
+	DirtyRegion region;
+	std::vector<Point> points;
+	for (int i = 0; i < 40; i++) {
+		const Point position { (i % 8) * 50, (i / 8) * 50 };
+		region.Add({ position, { 10, 10 } });
+		points.push_back(position);
+		points.push_back(position + Displacement { 9, 9 });
+	}
+	EXPECT_LE(region.Rects().size(), DirtyRegion::MaxRects);
+	for (Point point : points)
+		EXPECT_TRUE(Covers(region, point)) << point.x << "," << point.y;
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "engine/render/dun_render.hpp"
+#include "gendung.h"
+#include "lighting.h"
+#include "palette.h"
+#include "scrollrt.h"
+
+using namespace devilution;
+
+namespace {
+
+constexpr int TileTypeCount = 6;
+constexpr int TransparentSquare = 1;
+
+/** Size reserved for every frame, large enough for any tile encoding. */
+constexpr std::size_t FrameSize = 1024;
+
+/** Fills the global tile data with one random frame per tile type, frame `n` having tile type `n`. */
+void FillDungeonCels(std::mt19937 &rng)
+{
+	const std::size_t headerSize = sizeof(std::uint32_t) * TileTypeCount;
+	pDungeonCels = std::make_unique<byte[]>(headerSize + FrameSize * TileTypeCount);
+	auto *data = reinterpret_cast<std::uint8_t *>(pDungeonCels.get());
+	for (int frame = 0; frame < TileTypeCount; frame++) {
+		const std::uint32_t offset = SDL_SwapLE32(static_cast<std::uint32_t>(headerSize + FrameSize * frame));
+		memcpy(&data[sizeof(std::uint32_t) * frame], &offset, sizeof(offset));
+
+		std::uint8_t *src = &data[headerSize + FrameSize * frame];
+		if (frame != TransparentSquare) {
+			for (std::size_t i = 0; i < FrameSize; i++)
+				src[i] = static_cast<std::uint8_t>(rng());
+			continue;
+		}
+
+		// Transparent squares are RLE encoded, the runs must add up to exactly 32 per row.
+		for (int row = 0; row < TILE_HEIGHT; row++) {
+			int remaining = TILE_WIDTH / 2;
+			while (remaining > 0) {
+				const int run = std::min<int>(remaining, 1 + rng() % 12);
+				if (rng() % 3 == 0) {
+					*src++ = static_cast<std::uint8_t>(-run);
+				} else {
+					*src++ = static_cast<std::uint8_t>(run);
+					for (int i = 0; i < run; i++)
+						*src++ = static_cast<std::uint8_t>(rng());
+				}
+				remaining -= run;
+			}
+		}
+	}
+}
+
+void FillLookupTables(std::mt19937 &rng)
+{
+	for (auto &entry : LightTables)
+		entry = static_cast<std::uint8_t>(rng());
+	for (auto &row : paletteTransparencyLookup) {
+		for (auto &entry : row)
+			entry = static_cast<std::uint8_t>(rng());
+	}
+}
+
+struct MaskSetup {
+	bool transparency;
+	bool foliage;
+	char archDrawType;
+	std::uint8_t lvid;
+};
+
+constexpr std::array<MaskSetup, 7> MaskSetups { {
+	{ false, false, 0, 0 }, // Solid
+	{ true, false, 0, 0 },  // WallMaskFullyTrasparent
+	{ true, false, 1, 1 },  // LeftMaskTransparent
+	{ true, false, 2, 2 },  // RightMaskTransparent
+	{ true, false, 1, 0 },  // Solid (no transparency flag for the piece)
+	{ false, true, 1, 0 },  // LeftFoliageMask
+	{ false, true, 2, 0 },  // RightFoliageMask
+} };
+
+std::vector<std::uint8_t> RenderWithBackend(TileRenderBackend backend, Point position, const std::vector<std::uint8_t> &background)
+{
+	constexpr int SurfaceSize = 96;
+	OwnedSurface out { SurfaceSize, SurfaceSize };
+	for (int y = 0; y < SurfaceSize; y++)
+		memcpy(out.at(0, y), &background[y * SurfaceSize], SurfaceSize);
+
+	SetTileRenderBackend(backend);
+	RenderTile(out, position);
+
+	std::vector<std::uint8_t> result(SurfaceSize * SurfaceSize);
+	for (int y = 0; y < SurfaceSize; y++)
+		memcpy(&result[y * SurfaceSize], out.at(0, y), SurfaceSize);
+	return result;
+}
+
+} // namespace
+
+TEST(DunRenderTest, VectorizedMatchesScalar)
+{
+	if (!IsVectorizedTileRenderBackendAvailable())
+		GTEST_SKIP() << "No vectorized backend for this target";
+
+	std::mt19937 rng(42);
+	FillDungeonCels(rng);
+	FillLookupTables(rng);
+
+	std::vector<std::uint8_t> background(96 * 96);
+	for (auto &pixel : background)
+		pixel = static_cast<std::uint8_t>(rng());
+
+	// Fully visible, and clipped on every side of the surface.
+	const Point positions[] = { { 32, 64 }, { -7, 64 }, { -30, 64 }, { 77, 64 }, { 90, 64 }, { 32, 10 }, { 32, 100 }, { -5, 5 }, { 81, 120 } };
+	const int lightIndices[] = { 0, 3, LightsMax };
+
+	level_piece_id = 1;
+	for (int tile = 0; tile < TileTypeCount; tile++) {
+		level_cel_block = (tile << 12) | tile;
+		for (const MaskSetup &maskSetup : MaskSetups) {
+			cel_transparency_active = maskSetup.transparency;
+			cel_foliage_active = maskSetup.foliage;
+			arch_draw_type = maskSetup.archDrawType;
+			block_lvid[level_piece_id] = maskSetup.lvid;
+			for (int lightIndex : lightIndices) {
+				LightTableIndex = lightIndex;
+				for (Point position : positions) {
+					const std::vector<std::uint8_t> expected = RenderWithBackend(TileRenderBackend::Scalar, position, background);
+					const std::vector<std::uint8_t> actual = RenderWithBackend(TileRenderBackend::Vectorized, position, background);
+					ASSERT_EQ(actual, expected) << "tile type " << tile << ", arch_draw_type " << static_cast<int>(maskSetup.archDrawType)
+					                            << ", transparency " << maskSetup.transparency << ", foliage " << maskSetup.foliage
+					                            << ", light " << lightIndex << ", position " << position.x << "," << position.y;
+				}
+			}
+		}
+	}
+
+	SetTileRenderBackend(TileRenderBackend::Vectorized);
+}
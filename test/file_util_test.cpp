@@ -63,4 +63,19 @@ TEST(FileUtil, ResizeFile)
 	EXPECT_EQ(size, 30);
 }
 
+TEST(FileUtil, CreateDir)
+{
+	const std::string path = GetTmpPathName(".dir");
+	std::cout << path << std::endl;
+	ASSERT_TRUE(CreateDir(path.c_str()));
+	// Succeeds if the directory exists already
+	EXPECT_TRUE(CreateDir(path.c_str()));
+	const std::string filePath = path + "/file.tmp";
+	WriteDummyFile(filePath.c_str(), 42);
+	EXPECT_TRUE(FileExists(filePath.c_str()));
+	RemoveFile(filePath);
+	EXPECT_TRUE(RemoveDir(path.c_str()));
+	EXPECT_FALSE(FileExists(path.c_str()));
+}
+
 } // namespace
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "dvlnet/frame_queue.h"
+#include "engine/benchmark.hpp"
+
+using namespace devilution;
+using namespace devilution::net;
+
+namespace {
+
+/** Frames of game sized packets, most of them small turn and command packets and a few larger delta packets. */
+buffer_t MakeStream(int packetCount)
+{
+	std::mt19937 rng(5);
+	std::uniform_int_distribution<int> smallSize(8, 200);
+	std::uniform_int_distribution<int> largeSize(1000, 8000);
+	buffer_t stream;
+	for (int i = 0; i < packetCount; i++) {
+		buffer_t packet(i % 20 == 0 ? largeSize(rng) : smallSize(rng), static_cast<unsigned char>(i));
+		buffer_t frame = frame_queue::MakeFrame(packet);
+		stream.insert(stream.end(), frame.begin(), frame.end());
+	}
+	return stream;
+}
+
+/**
+ * @brief Feeds the stream in chunks of the given size and returns the time each pass took in milliseconds.
+ */
+std::vector<double> TimeFragmentedStream(const buffer_t &stream, size_t chunkSize, int passes)
+{
+	std::vector<double> samplesMs;
+	for (int pass = 0; pass < passes; pass++) {
+		frame_queue queue;
+		size_t received = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t pos = 0; pos < stream.size(); pos += chunkSize) {
+			queue.Write(&stream[pos], std::min(chunkSize, stream.size() - pos));
+			while (queue.PacketReady())
+				received += queue.ReadPacket().size();
+		}
+		samplesMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		EXPECT_GT(received, 0U);
+	}
+	return samplesMs;
+}
+
+} // namespace
+
+TEST(FrameQueueBenchmark, FragmentedStream)
+{
+	const buffer_t stream = MakeStream(10000);
+	// A byte at a time, small TCP segments, one MTU, and large socket reads
+	for (size_t chunkSize : { 1, 64, 1460, 65536 }) {
+		const TimingSummary summary = SummarizeTimings(TimeFragmentedStream(stream, chunkSize, 20));
+		std::printf("%zu bytes in chunks of %zu: mean %.4f ms (%.1f MB/s), p99 %.4f ms\n",
+		    stream.size(), chunkSize, summary.meanMs, stream.size() / (summary.meanMs * 1000), summary.p99Ms);
+	}
+}
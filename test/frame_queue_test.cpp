@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "dvlnet/frame_queue.h"
+
+using namespace devilution::net;
+
+namespace {
+
+buffer_t MakePacket(size_t size, unsigned char seed)
+{
+	buffer_t packet(size);
+	for (size_t i = 0; i < size; i++)
+		packet[i] = static_cast<unsigned char>(seed + i);
+	return packet;
+}
+
+/** Feeds the frames of all packets in chunks of the given size and checks that every packet comes out unchanged. */
+void CheckFragmentedStream(const std::vector<buffer_t> &packets, size_t chunkSize)
+{
+	buffer_t stream;
+	for (const buffer_t &packet : packets) {
+		buffer_t frame = frame_queue::MakeFrame(packet);
+		stream.insert(stream.end(), frame.begin(), frame.end());
+	}
+
+	frame_queue queue;
+	std::vector<buffer_t> received;
+	for (size_t pos = 0; pos < stream.size(); pos += chunkSize) {
+		queue.Write(&stream[pos], std::min(chunkSize, stream.size() - pos));
+		while (queue.PacketReady())
+			received.push_back(queue.ReadPacket());
+	}
+	EXPECT_EQ(received, packets) << "chunk size " << chunkSize;
+}
+
+} // namespace
+
+TEST(FrameQueueTest, FragmentedStream)
+{
+	std::vector<buffer_t> packets;
+	for (unsigned char i = 0; i < 50; i++)
+		packets.push_back(MakePacket(1 + (i * 997) % 3000, i));
+	// Larger than the initial ring to make it grow while bytes are wrapped around.
+	packets.push_back(MakePacket(frame_queue::max_frame_size, 7));
+
+	for (size_t chunkSize : { 1, 3, 4, 5, 1000, 4096, 65536, 200000 })
+		CheckFragmentedStream(packets, chunkSize);
+}
+
+TEST(FrameQueueTest, RandomChunks)
+{
+	std::mt19937 rng(1);
+	std::vector<buffer_t> packets;
+	buffer_t stream;
+	for (unsigned char i = 0; i < 200; i++) {
+		packets.push_back(MakePacket(1 + rng() % 5000, i));
+		buffer_t frame = frame_queue::MakeFrame(packets.back());
+		stream.insert(stream.end(), frame.begin(), frame.end());
+	}
+
+	frame_queue queue;
+	std::vector<buffer_t> received;
+	for (size_t pos = 0; pos < stream.size();) {
+		const size_t size = std::min<size_t>(rng() % 9000, stream.size() - pos);
+		queue.Write(&stream[pos], size);
+		pos += size;
+		while (queue.PacketReady())
+			received.push_back(queue.ReadPacket());
+	}
+	EXPECT_EQ(received, packets);
+}
+
+TEST(FrameQueueTest, ReadPacketWithoutFrame)
+{
+	frame_queue queue;
+	EXPECT_THROW(queue.ReadPacket(), frame_queue_exception);
+}
+
+TEST(FrameQueueTest, ZeroSizeFrame)
+{
+	frame_queue queue;
+	const unsigned char header[sizeof(framesize_t)] = {};
+	queue.Write(header, sizeof(header));
+	EXPECT_THROW(queue.PacketReady(), frame_queue_exception);
+}
@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#include "automap.h"
 #include "control.h"
+#include "gendung.h"
 #include "lighting.h"
 
 using namespace devilution;
@@ -32,3 +38,197 @@ TEST(Lighting, CrawlTables)
 		}
 	}
 }
+
+namespace {
+
+/** Applies every light to the static lighting from scratch, what the incremental update has to match. */
+void RebuildReferenceLighting(char (&reference)[MAXDUNX][MAXDUNY])
+{
+	char current[MAXDUNX][MAXDUNY];
+	memcpy(current, dLight, sizeof(dLight));
+	memcpy(dLight, dPreLight, sizeof(dLight));
+	for (int i = 0; i < ActiveLightCount; i++) {
+		const Light &light = Lights[ActiveLights[i]];
+		DoLighting(light.position.tile, light._lradius, ActiveLights[i]);
+	}
+	memcpy(reference, dLight, sizeof(dLight));
+	memcpy(dLight, current, sizeof(dLight));
+}
+
+void ClearReferenceVision(Point position, int nRadius)
+{
+	nRadius += 2;
+	for (int i = std::max(position.x - nRadius, 0); i < std::min(position.x + nRadius, MAXDUNX); i++) {
+		for (int j = std::max(position.y - nRadius, 0); j < std::min(position.y + nRadius, MAXDUNY); j++)
+			dFlags[i][j] &= ~(DungeonFlag::Visible | DungeonFlag::Lit);
+	}
+}
+
+/** Clears and reapplies every vision with DoVision, what ProcessVisionList has to match. */
+void ProcessReferenceVision(Light (&visions)[MAXVISION], int &count)
+{
+	for (int i = 0; i < count; i++) {
+		if (visions[i]._ldel)
+			ClearReferenceVision(visions[i].position.tile, visions[i]._lradius);
+		if (visions[i]._lunflag) {
+			ClearReferenceVision(visions[i].position.old, visions[i].oldRadius);
+			visions[i]._lunflag = false;
+		}
+	}
+	for (int i = 0; i < TransVal; i++)
+		TransList[i] = false;
+	for (int i = 0; i < count; i++) {
+		const Light &vision = visions[i];
+		if (!vision._ldel)
+			DoVision(vision.position.tile, vision._lradius, vision._lflags ? MAP_EXP_SELF : MAP_EXP_OTHERS, vision._lflags);
+	}
+	for (int i = 0; i < count; i++) {
+		if (!visions[i]._ldel)
+			continue;
+		count--;
+		if (count > 0 && i != count)
+			visions[i] = visions[count];
+		i--;
+	}
+}
+
+} // namespace
+
+TEST(Lighting, IncrementalUpdateMatchesRebuild)
+{
+	std::mt19937 rng(1234);
+	const auto randomInt = [&rng](int min, int max) {
+		return std::uniform_int_distribution<int>(min, max)(rng);
+	};
+	const auto randomPosition = [&randomInt]() {
+		return Point { randomInt(-2, MAXDUNX + 1), randomInt(-2, MAXDUNY + 1) };
+	};
+
+	for (uint8_t level : { 1, 17 }) {
+		currlevel = level;
+		MakeLightRadiusTables();
+		for (auto &column : dPreLight) {
+			for (char &light : column)
+				light = static_cast<char>(randomInt(0, LightsMax));
+		}
+		memcpy(dLight, dPreLight, sizeof(dLight));
+		InitLighting();
+
+		for (int step = 0; step < 300; step++) {
+			for (int change = randomInt(1, 6); change > 0; change--) {
+				const int lid = ActiveLightCount == 0 ? NO_LIGHT : ActiveLights[randomInt(0, ActiveLightCount - 1)];
+				switch (randomInt(0, 5)) {
+				case 0:
+					AddLight(randomPosition(), randomInt(0, 15));
+					break;
+				case 1:
+					AddUnLight(lid);
+					break;
+				case 2:
+					ChangeLightXY(lid, randomPosition());
+					break;
+				case 3:
+					ChangeLightRadius(lid, randomInt(0, 15));
+					break;
+				case 4:
+					ChangeLightOffset(lid, { randomInt(-7, 7), randomInt(-7, 7) });
+					break;
+				case 5:
+					ChangeLight(lid, randomPosition(), randomInt(0, 15));
+					break;
+				}
+			}
+			ProcessLightList();
+
+			char reference[MAXDUNX][MAXDUNY];
+			RebuildReferenceLighting(reference);
+			ASSERT_EQ(memcmp(reference, dLight, sizeof(dLight)), 0) << "level " << static_cast<int>(level) << ", step " << step;
+		}
+	}
+}
+
+TEST(Lighting, VisionMatchesDoVision)
+{
+	std::mt19937 rng(4321);
+	const auto randomInt = [&rng](int min, int max) {
+		return std::uniform_int_distribution<int>(min, max)(rng);
+	};
+	const auto randomPosition = [&randomInt]() {
+		return Point { randomInt(-2, MAXDUNX + 1), randomInt(-2, MAXDUNY + 1) };
+	};
+
+	for (int piece = 0; piece < 100; piece++)
+		nBlockTable[piece] = randomInt(0, 3) == 0;
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			dPiece[x][y] = randomInt(0, 99);
+			dTransVal[x][y] = static_cast<int8_t>(randomInt(0, 15));
+		}
+	}
+	TransVal = 16;
+	memset(dFlags, 0, sizeof(dFlags));
+	memset(AutomapView, 0, sizeof(AutomapView));
+	InitVision();
+
+	for (int step = 0; step < 500; step++) {
+		if (VisionCount == 0)
+			AddVision(randomPosition(), randomInt(0, 15), true);
+		// Move one vision every step, most of the others stay where they are
+		const Light &moved = VisionList[randomInt(0, VisionCount - 1)];
+		ChangeVisionXY(moved._lid, moved.position.tile + Displacement { randomInt(-1, 1), randomInt(-1, 1) });
+		for (int change = randomInt(0, 2); change > 0; change--) {
+			Light &vision = VisionList[randomInt(0, VisionCount - 1)];
+			switch (randomInt(0, 5)) {
+			case 0:
+				AddVision(randomPosition(), randomInt(0, 15), randomInt(0, 1) == 0);
+				break;
+			case 1:
+				vision._ldel = true;
+				break;
+			case 2:
+				ChangeVisionXY(vision._lid, randomPosition());
+				break;
+			case 3:
+				ChangeVisionRadius(vision._lid, randomInt(0, 15));
+				break;
+			case 4:
+				DoUnVision(randomPosition(), randomInt(0, 15));
+				break;
+			case 5:
+				dPiece[randomInt(0, MAXDUNX - 1)][randomInt(0, MAXDUNY - 1)] = randomInt(0, 99);
+				InvalidateVision();
+				break;
+			}
+		}
+
+		DungeonFlag flags[MAXDUNX][MAXDUNY];
+		uint8_t automap[DMAXX][DMAXY];
+		bool transList[256];
+		memcpy(flags, dFlags, sizeof(flags));
+		memcpy(automap, AutomapView, sizeof(automap));
+		memcpy(transList, TransList, sizeof(transList));
+		Light visions[MAXVISION];
+		std::copy(std::begin(VisionList), std::end(VisionList), visions);
+		int visionCount = VisionCount;
+		ProcessReferenceVision(visions, visionCount);
+
+		DungeonFlag expectedFlags[MAXDUNX][MAXDUNY];
+		uint8_t expectedAutomap[DMAXX][DMAXY];
+		bool expectedTransList[256];
+		memcpy(expectedFlags, dFlags, sizeof(flags));
+		memcpy(expectedAutomap, AutomapView, sizeof(automap));
+		memcpy(expectedTransList, TransList, sizeof(transList));
+		memcpy(dFlags, flags, sizeof(flags));
+		memcpy(AutomapView, automap, sizeof(automap));
+		memcpy(TransList, transList, sizeof(transList));
+
+		ProcessVisionList();
+
+		ASSERT_EQ(memcmp(expectedFlags, dFlags, sizeof(flags)), 0) << "step " << step;
+		ASSERT_EQ(memcmp(expectedAutomap, AutomapView, sizeof(automap)), 0) << "step " << step;
+		ASSERT_EQ(memcmp(expectedTransList, TransList, sizeof(transList)), 0) << "step " << step;
+		ASSERT_EQ(visionCount, VisionCount) << "step " << step;
+		for (int i = 0; i < VisionCount; i++)
+			ASSERT_EQ(visions[i]._lid, VisionList[i]._lid) << "step " << step;
+	}
+}
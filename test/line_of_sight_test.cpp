@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "gendung.h"
+#include "line_of_sight.h"
+#include "monster.h"
+#include "path.h"
+
+using namespace devilution;
+
+namespace {
+
+void FillRandomMap(unsigned seed)
+{
+	for (int i = 0; i < 20; i++) {
+		nSolidTable[i] = (i % 3) == 0;
+		nMissileTable[i] = (i % 4) == 0;
+	}
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			seed = seed * 1103515245 + 12345;
+			// Mostly open floor so that long lines get checked too
+			dPiece[x][y] = (seed >> 16) % 8 == 0 ? (seed >> 20) % 20 : 1;
+		}
+	}
+	InvalidateLineOfSight();
+}
+
+} // namespace
+
+TEST(LineOfSightTest, MatchesPredicateWalk)
+{
+	FillRandomMap(42);
+	unsigned seed = 7;
+	for (int i = 0; i < 20000; i++) {
+		seed = seed * 1103515245 + 12345;
+		const Point start { static_cast<int>(seed >> 8) % MAXDUNX, static_cast<int>(seed >> 16) % MAXDUNY };
+		seed = seed * 1103515245 + 12345;
+		const Point end = start + Displacement { static_cast<int>((seed >> 8) % 31) - 15, static_cast<int>((seed >> 16) % 31) - 15 };
+		if (InDungeonBounds(end))
+			EXPECT_EQ(LineClearMissile(start, end), LineClear(PosOkMissile, start, end)) << i;
+		EXPECT_EQ(IsLineNotSolid(start, end), LineClear(IsTileNotSolid, start, end)) << i;
+	}
+}
+
+TEST(LineOfSightTest, PicksUpChangedTiles)
+{
+	FillRandomMap(1);
+	for (int x = 10; x <= 20; x++)
+		dPiece[x][10] = 1;
+	EXPECT_TRUE(LineClearMissile({ 10, 10 }, { 20, 10 }));
+	EXPECT_TRUE(IsLineNotSolid({ 10, 10 }, { 20, 10 }));
+
+	dPiece[15][10] = 12;
+	InvalidateLineOfSight();
+	EXPECT_FALSE(LineClearMissile({ 10, 10 }, { 20, 10 }));
+	EXPECT_FALSE(IsLineNotSolid({ 10, 10 }, { 20, 10 }));
+}
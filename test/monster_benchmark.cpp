@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "engine/benchmark.hpp"
+#include "monster.h"
+#include "monster_test.h"
+
+using namespace devilution;
+
+TEST(MonsterBenchmark, UpdateEnemy)
+{
+	std::mt19937 rng(11);
+	FillLevel(rng);
+
+	std::vector<double> samplesMs;
+	for (int round = 0; round < 200; round++) {
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < ActiveMonsterCount; i++)
+			UpdateEnemy(Monsters[ActiveMonsters[i]]);
+		samplesMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	const TimingSummary summary = SummarizeTimings(samplesMs);
+	std::printf("UpdateEnemy sweep over %d monsters: mean %.4f ms, p50 %.4f ms, p99 %.4f ms\n",
+	    ActiveMonsterCount, summary.meanMs, summary.p50Ms, summary.p99Ms);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "gendung.h"
+#include "missiles.h"
+#include "monster.h"
+#include "monster_test.h"
+#include "multi.h"
+#include "player.h"
+
+using namespace devilution;
+
+namespace {
+
+struct EnemyChoice {
+	int menemy;
+	Point enemyPosition;
+	uint32_t flags;
+};
+
+/** The target selection scanning every active monster, what UpdateEnemy has to match. */
+EnemyChoice ReferenceUpdateEnemy(int monsterId)
+{
+	const Monster &monster = Monsters[monsterId];
+	uint32_t flags = monster._mFlags;
+	Point target;
+	int menemy = -1;
+	int bestDist = -1;
+	bool bestsameroom = false;
+	const Point position = monster.position.tile;
+	if ((monster._mFlags & MFLAG_BERSERK) != 0 || (monster._mFlags & MFLAG_GOLEM) == 0) {
+		for (int pnum = 0; pnum < MAX_PLRS; pnum++) {
+			Player &player = Players[pnum];
+			if (!player.plractive || currlevel != player.plrlevel || player._pLvlChanging
+			    || (((player._pHitPoints >> 6) == 0) && gbIsMultiplayer))
+				continue;
+			bool sameroom = (dTransVal[position.x][position.y] == dTransVal[player.position.tile.x][player.position.tile.y]);
+			int dist = position.WalkingDistance(player.position.tile);
+			if ((sameroom && !bestsameroom) || ((sameroom || !bestsameroom) && dist < bestDist) || (menemy == -1)) {
+				flags &= ~MFLAG_TARGETS_MONSTER;
+				menemy = pnum;
+				target = player.position.future;
+				bestDist = dist;
+				bestsameroom = sameroom;
+			}
+		}
+	}
+	for (int j = 0; j < ActiveMonsterCount; j++) {
+		int mi = ActiveMonsters[j];
+		auto &otherMonster = Monsters[mi];
+		if (mi == monsterId)
+			continue;
+		if ((otherMonster._mhitpoints >> 6) <= 0)
+			continue;
+		if (otherMonster.position.tile == GolemHoldingCell)
+			continue;
+		if (M_Talker(otherMonster) && otherMonster.mtalkmsg != TEXT_NONE)
+			continue;
+		bool isBerserked = (monster._mFlags & MFLAG_BERSERK) != 0 || (otherMonster._mFlags & MFLAG_BERSERK) != 0;
+		if ((monster._mFlags & MFLAG_GOLEM) != 0 && (otherMonster._mFlags & MFLAG_GOLEM) != 0 && !isBerserked)
+			continue;
+
+		int dist = otherMonster.position.tile.WalkingDistance(position);
+		bool isRanged = IsAnyOf(monster._mAi, AI_SKELBOW, AI_GOATBOW, AI_SUCC, AI_LAZHELP);
+		if (((monster._mFlags & MFLAG_GOLEM) == 0 && (monster._mFlags & MFLAG_BERSERK) == 0 && dist >= 2 && !isRanged)
+		    || ((monster._mFlags & MFLAG_GOLEM) == 0 && (monster._mFlags & MFLAG_BERSERK) == 0 && (otherMonster._mFlags & MFLAG_GOLEM) == 0)) {
+			continue;
+		}
+		bool sameroom = dTransVal[position.x][position.y] == dTransVal[otherMonster.position.tile.x][otherMonster.position.tile.y];
+		if ((sameroom && !bestsameroom) || ((sameroom || !bestsameroom) && dist < bestDist) || (menemy == -1)) {
+			flags |= MFLAG_TARGETS_MONSTER;
+			menemy = mi;
+			target = otherMonster.position.future;
+			bestDist = dist;
+			bestsameroom = sameroom;
+		}
+	}
+	if (menemy != -1)
+		return { menemy, target, flags & ~MFLAG_NO_ENEMY };
+	return { monster._menemy, monster.enemyPosition, flags | MFLAG_NO_ENEMY };
+}
+
+EnemyChoice ActualUpdateEnemy(int monsterId)
+{
+	Monster &monster = Monsters[monsterId];
+	const EnemyChoice saved { monster._menemy, monster.enemyPosition, monster._mFlags };
+	UpdateEnemy(monster);
+	const EnemyChoice choice { monster._menemy, monster.enemyPosition, monster._mFlags };
+	monster._menemy = saved.menemy;
+	monster.enemyPosition = saved.enemyPosition;
+	monster._mFlags = saved.flags;
+	return choice;
+}
+
+void ExpectSameEnemy(int monsterId)
+{
+	const EnemyChoice expected = ReferenceUpdateEnemy(monsterId);
+	const EnemyChoice actual = ActualUpdateEnemy(monsterId);
+	EXPECT_EQ(actual.menemy, expected.menemy) << "monster " << monsterId;
+	EXPECT_EQ(actual.enemyPosition, expected.enemyPosition) << "monster " << monsterId;
+	EXPECT_EQ(actual.flags, expected.flags) << "monster " << monsterId;
+}
+
+} // namespace
+
+TEST(Monster, UpdateEnemyMatchesFullScan)
+{
+	std::mt19937 rng(7);
+	FillLevel(rng);
+
+	std::uniform_int_distribution<int> step(-1, 1);
+	for (int round = 0; round < 20; round++) {
+		for (int i = 0; i < ActiveMonsterCount; i++)
+			ExpectSameEnemy(ActiveMonsters[i]);
+
+		// Monsters walk around without the golem list being rebuilt
+		for (Monster &monster : Monsters) {
+			if (monster.position.tile != GolemHoldingCell)
+				monster.position.tile += Displacement { step(rng), step(rng) };
+		}
+	}
+
+	// Berserking a monster and deleting monsters both change who can be targeted
+	Monsters[ActiveMonsters[100]]._mFlags |= MFLAG_BERSERK | MFLAG_GOLEM;
+	InvalidateGolemMonsters();
+	for (int i = 0; i < ActiveMonsterCount; i++)
+		ExpectSameEnemy(ActiveMonsters[i]);
+
+	Monsters[ActiveMonsters[MAX_PLRS]]._mDelFlag = true;
+	Monsters[ActiveMonsters[40]]._mDelFlag = true;
+	DeleteMonsterList();
+	for (int i = 0; i < ActiveMonsterCount; i++)
+		ExpectSameEnemy(ActiveMonsters[i]);
+}
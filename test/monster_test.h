@@ -0,0 +1,71 @@
+/**
+ * @file monster_test.h
+ *
+ * Helpers for monster related tests and benchmarks.
+ */
+#pragma once
+
+#include <algorithm>
+#include <random>
+
+#include "gendung.h"
+#include "monster.h"
+#include "multi.h"
+#include "player.h"
+
+using namespace devilution;
+
+static constexpr _mai_id MonsterAis[] = { AI_ZOMBIE, AI_FAT, AI_SKELSD, AI_SKELBOW, AI_SCAV, AI_GOATBOW, AI_SUCC };
+
+/**
+ * @brief Fills the level with MAXMONSTERS monsters and a player, a few of the monsters being golems and berserked monsters.
+ *
+ * Ordinary monsters are packed around the golems so that there are plenty of targets at equal distances.
+ */
+static void FillLevel(std::mt19937 &rng)
+{
+	currlevel = 1;
+	gbIsMultiplayer = false;
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++)
+			dTransVal[x][y] = static_cast<int8_t>(1 + x / 20 + (y / 20) * 6);
+	}
+
+	for (Player &player : Players)
+		player.plractive = false;
+	Player &player = Players[0];
+	player.plractive = true;
+	player.plrlevel = currlevel;
+	player._pLvlChanging = false;
+	player._pHitPoints = 100 << 6;
+	player.position.tile = { 50, 50 };
+	player.position.future = { 51, 50 };
+
+	std::uniform_int_distribution<int> coordinate(16, 95);
+	std::uniform_int_distribution<int> offset(-2, 2);
+	std::uniform_int_distribution<int> ai(0, sizeof(MonsterAis) / sizeof(MonsterAis[0]) - 1);
+	for (int i = 0; i < MAXMONSTERS; i++) {
+		Monster &monster = Monsters[i];
+		monster = {};
+		monster._mhitpoints = 10 << 6;
+		monster._mAi = MonsterAis[ai(rng)];
+		monster.mtalkmsg = TEXT_NONE;
+		ActiveMonsters[i] = i;
+		if (i < MAX_PLRS) {
+			monster._mAi = AI_GOLUM;
+			monster._mFlags = MFLAG_GOLEM;
+			monster.position.tile = i < 2 ? Point { coordinate(rng), coordinate(rng) } : GolemHoldingCell;
+		} else if (i % 40 == 0) {
+			monster._mFlags = MFLAG_BERSERK | MFLAG_GOLEM;
+			monster.position.tile = { coordinate(rng), coordinate(rng) };
+		} else {
+			const Point golem = Monsters[i % 2].position.tile;
+			monster.position.tile = rng() % 2 == 0 ? Point { coordinate(rng), coordinate(rng) } : golem + Displacement { offset(rng), offset(rng) };
+		}
+		monster.position.future = monster.position.tile + Displacement { 1, 0 };
+	}
+	// Shuffle the monsters after the golems like deleting monsters would
+	std::shuffle(&ActiveMonsters[MAX_PLRS], &ActiveMonsters[MAXMONSTERS], rng);
+	ActiveMonsterCount = MAXMONSTERS;
+	InvalidateGolemMonsters();
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mpq/mpq_reader.hpp"
+#include "mpq/mpq_sdl_rwops.hpp"
+#include "mpq/mpq_writer.hpp"
+#include "utils/file_util.h"
+
+using namespace devilution;
+
+namespace {
+
+constexpr const char *ArchivePath = "Test_MpqSdlRwops.mpq";
+constexpr const char *FileName = "levels\\test.bin";
+
+std::vector<uint8_t> TestContents()
+{
+	// A bit over three 4096 byte sectors, with a pattern that is neither constant nor random
+	std::vector<uint8_t> contents(3 * 4096 + 1000);
+	for (size_t i = 0; i < contents.size(); i++)
+		contents[i] = static_cast<uint8_t>((i * 7 + i / 300) % 251);
+	return contents;
+}
+
+class MpqSdlRwopsTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		contents_ = TestContents();
+		{
+			MpqWriter writer;
+			ASSERT_TRUE(writer.Open(ArchivePath));
+			ASSERT_TRUE(writer.WriteFile(FileName, reinterpret_cast<const byte *>(contents_.data()), contents_.size()));
+		}
+		int32_t error = 0;
+		archive_ = MpqArchive::Open(ArchivePath, error);
+		ASSERT_TRUE(archive_);
+		uint32_t fileNumber;
+		ASSERT_TRUE(archive_->GetFileNumber(MpqArchive::CalculateFileHash(FileName), fileNumber));
+		handle_ = SDL_RWops_FromMpqFile(*archive_, fileNumber, FileName, /*threadsafe=*/false);
+		ASSERT_NE(handle_, nullptr);
+	}
+
+	void TearDown() override
+	{
+		if (handle_ != nullptr)
+			SDL_RWclose(handle_);
+		archive_ = std::nullopt;
+		RemoveFile(ArchivePath);
+	}
+
+	std::vector<uint8_t> Read(size_t size)
+	{
+		std::vector<uint8_t> result(size);
+		EXPECT_EQ(SDL_RWread(handle_, result.data(), size, 1), 1U);
+		return result;
+	}
+
+	std::vector<uint8_t> Expected(size_t begin, size_t size)
+	{
+		return { contents_.begin() + begin, contents_.begin() + begin + size };
+	}
+
+	std::vector<uint8_t> contents_;
+	std::optional<MpqArchive> archive_;
+	SDL_RWops *handle_ = nullptr;
+};
+
+} // namespace
+
+TEST_F(MpqSdlRwopsTest, ReadsWholeFile)
+{
+	EXPECT_EQ(SDL_RWsize(handle_), static_cast<Sint64>(contents_.size()));
+	EXPECT_EQ(Read(contents_.size()), contents_);
+}
+
+TEST_F(MpqSdlRwopsTest, ReadsAcrossSectors)
+{
+	for (size_t position = 0; position + 1000 <= contents_.size(); position += 1000)
+		EXPECT_EQ(Read(1000), Expected(position, 1000)) << position;
+
+	SDL_RWseek(handle_, 4000, RW_SEEK_SET);
+	EXPECT_EQ(Read(200), Expected(4000, 200));
+}
+
+TEST_F(MpqSdlRwopsTest, MixesWholeAndPartialSectors)
+{
+	SDL_RWseek(handle_, 4096, RW_SEEK_SET);
+	EXPECT_EQ(Read(4096), Expected(4096, 4096));
+	EXPECT_EQ(Read(10), Expected(8192, 10));
+	EXPECT_EQ(Read(5000), Expected(8202, 5000));
+
+	SDL_RWseek(handle_, 4090, RW_SEEK_SET);
+	EXPECT_EQ(Read(6), Expected(4090, 6));
+	EXPECT_EQ(Read(4096), Expected(4096, 4096));
+}
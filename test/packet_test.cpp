@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include "dvlnet/packet.h"
+
+using namespace devilution::net;
+
+namespace {
+
+std::unique_ptr<packet> RoundTrip(packet_factory &factory, packet &pkt)
+{
+	return factory.make_packet(pkt.Data());
+}
+
+} // namespace
+
+TEST(PacketTest, Message)
+{
+	packet_factory factory;
+	const buffer_t message { 1, 2, 3, 4, 5, 6, 7 };
+	auto sent = factory.make_packet<PT_MESSAGE>(plr_t { 1 }, plr_t { 2 }, message);
+	auto received = RoundTrip(factory, *sent);
+
+	EXPECT_EQ(received->Type(), PT_MESSAGE);
+	EXPECT_EQ(received->Source(), 1);
+	EXPECT_EQ(received->Destination(), 2);
+	const buffer_span payload = received->Message();
+	EXPECT_EQ(buffer_t(payload.begin(), payload.end()), message);
+	EXPECT_EQ(received->Data(), sent->Data());
+}
+
+TEST(PacketTest, Turn)
+{
+	packet_factory factory;
+	auto sent = factory.make_packet<PT_TURN>(plr_t { 3 }, PLR_BROADCAST, turn_t { 42, -12345 });
+	auto received = RoundTrip(factory, *sent);
+
+	EXPECT_EQ(received->Type(), PT_TURN);
+	EXPECT_EQ(received->Turn().SequenceNumber, 42);
+	EXPECT_EQ(received->Turn().Value, -12345);
+}
+
+TEST(PacketTest, JoinAccept)
+{
+	packet_factory factory;
+	const buffer_t info { 9, 8, 7 };
+	auto sent = factory.make_packet<PT_JOIN_ACCEPT>(PLR_MASTER, PLR_BROADCAST, cookie_t { 0xDEADBEEF }, plr_t { 2 }, info);
+	auto received = RoundTrip(factory, *sent);
+
+	EXPECT_EQ(received->Type(), PT_JOIN_ACCEPT);
+	EXPECT_EQ(received->Cookie(), 0xDEADBEEF);
+	EXPECT_EQ(received->NewPlayer(), 2);
+	EXPECT_EQ(received->Info(), info);
+}
+
+TEST(PacketTest, Truncated)
+{
+	packet_factory factory;
+	auto sent = factory.make_packet<PT_TURN>(plr_t { 3 }, PLR_BROADCAST, turn_t { 42, 7 });
+	buffer_t data = sent->Data();
+	data.pop_back();
+	EXPECT_THROW(factory.make_packet(data), packet_exception);
+}
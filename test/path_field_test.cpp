@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "path_field.h"
+
+// The following headers are included to access globals used in functions that have not been isolated yet.
+#include "gendung.h"
+#include "objects.h"
+#include "player.h"
+
+using namespace devilution;
+
+namespace {
+
+void ClearLevel()
+{
+	memset(dPiece, 0, sizeof(dPiece));
+	memset(dObject, 0, sizeof(dObject));
+	nSolidTable[0] = false;
+	nSolidTable[1] = true;
+	InvalidatePathFields();
+}
+
+void BuildWall(int x, int minY, int maxY)
+{
+	for (int y = minY; y <= maxY; y++)
+		dPiece[x][y] = 1;
+	InvalidatePathFields();
+}
+
+int8_t FirstStep(Point startPosition)
+{
+	const Point destination = Players[0].position.future;
+	return FindPathFieldStep([](Point) { return true; }, 0, false, startPosition, destination);
+}
+
+} // namespace
+
+TEST(PathFieldTest, Distances)
+{
+	ClearLevel();
+	Players[0].position.future = { 20, 20 };
+
+	const auto &field = detail::GetPathField(0, false);
+	EXPECT_EQ(field[20][20], 0);
+	EXPECT_EQ(field[21][20], 2) << "Straight steps cost 2";
+	EXPECT_EQ(field[21][21], 3) << "Diagonal steps cost 3";
+	EXPECT_EQ(field[23][26], 3 * 3 + 3 * 2);
+	EXPECT_EQ(field[20][57], 74);
+	EXPECT_EQ(field[20][58], PathFieldUnreachable) << "Tiles beyond the search limit are unreachable";
+}
+
+TEST(PathFieldTest, FirstStep)
+{
+	ClearLevel();
+	Players[0].position.future = { 20, 20 };
+
+	EXPECT_EQ(FirstStep({ 20, 20 }), 0) << "No step when already at the destination";
+	EXPECT_EQ(FirstStep({ 20, 26 }), 1);
+	EXPECT_EQ(FirstStep({ 14, 20 }), 3);
+	EXPECT_EQ(FirstStep({ 24, 24 }), 5) << "Diagonal steps are taken when they get closest";
+	EXPECT_EQ(FirstStep({ 20, 20 + MaxPathFieldDistance }), 0) << "No step when too far away";
+
+	Players[0].position.future = { 24, 20 };
+	EXPECT_EQ(FirstStep({ 20, 26 }), 6) << "Fields follow the player";
+}
+
+TEST(PathFieldTest, Walls)
+{
+	ClearLevel();
+	Players[0].position.future = { 24, 20 };
+	BuildWall(22, 15, 25);
+
+	// Both ways around the wall are equally long, the first direction of PathDirs wins
+	EXPECT_EQ(FirstStep({ 20, 20 }), 6);
+	EXPECT_EQ(detail::GetPathField(0, false)[22][20], PathFieldUnreachable) << "Walls are unreachable";
+
+	BuildWall(22, 0, MAXDUNY - 1);
+	EXPECT_EQ(FirstStep({ 20, 20 }), 0) << "No step when the wall has no way around";
+}
@@ -137,6 +137,23 @@ TEST(PathTest, FindPath)
 	CheckPath({ 8, 8 }, { 12, 20 }, { 7, 7, 7, 7, 4, 4, 4, 4, 4, 4, 4, 4 });
 }
 
+TEST(PathTest, FindPathAroundWall)
+{
+	const auto posOk = [](Point position) { return position.x != 10 || position.y < 5 || position.y > 12; };
+	const std::vector<int8_t> expectedSteps { 6, 1, 1, 6, 7, 7, 4, 4 };
+
+	int8_t pathSteps[MAX_PATH_LENGTH];
+	ASSERT_EQ(FindPath(posOk, { 8, 8 }, { 12, 8 }, pathSteps), expectedSteps.size());
+	EXPECT_EQ(std::vector<int8_t>(pathSteps, pathSteps + expectedSteps.size()), expectedSteps);
+
+	// The std::function overload has to find the same path
+	const std::function<bool(Point)> posOkFunction = posOk;
+	ASSERT_EQ(FindPath(posOkFunction, { 8, 8 }, { 12, 8 }, pathSteps), expectedSteps.size());
+	EXPECT_EQ(std::vector<int8_t>(pathSteps, pathSteps + expectedSteps.size()), expectedSteps);
+
+	EXPECT_EQ(FindPath([](Point position) { return position.x != 10; }, { 8, 8 }, { 12, 8 }, pathSteps), 0) << "No path through an endless wall";
+}
+
 TEST(PathTest, Walkable)
 {
 	dPiece[5][5] = 0;
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "utils/pcm_aulib_decoder.h"
+
+using namespace devilution;
+
+namespace {
+
+/**
+ * @brief Produces the sample index as the value of each sample, in chunks of at most `ChunkSize`.
+ */
+class RampDecoder final : public ::Aulib::Decoder {
+public:
+	RampDecoder(int numChannels, int numSamples)
+	    : numChannels_(numChannels)
+	    , numSamples_(numSamples)
+	{
+	}
+
+	bool open(SDL_RWops * /*rwops*/) override
+	{
+		return true;
+	}
+
+	[[nodiscard]] int getChannels() const override
+	{
+		return numChannels_;
+	}
+
+	[[nodiscard]] int getRate() const override
+	{
+		return 1000;
+	}
+
+	bool rewind() override
+	{
+		pos_ = 0;
+		return true;
+	}
+
+	[[nodiscard]] std::chrono::microseconds duration() const override
+	{
+		return {};
+	}
+
+	bool seekToTime(std::chrono::microseconds /*pos*/) override
+	{
+		return false;
+	}
+
+protected:
+	int doDecoding(float buf[], int len, bool &callAgain) override
+	{
+		constexpr int ChunkSize = 1000;
+		const int count = std::min({ len, ChunkSize, numSamples_ - pos_ });
+		for (int i = 0; i < count; i++)
+			buf[i] = static_cast<float>(pos_ + i);
+		pos_ += count;
+		callAgain = false;
+		return count;
+	}
+
+private:
+	int numChannels_;
+	int numSamples_;
+	int pos_ = 0;
+};
+
+} // namespace
+
+TEST(PcmAulibDecoderTest, DecodesEverything)
+{
+	RampDecoder ramp { 2, 10000 };
+	const std::shared_ptr<const DecodedAudio> audio = DecodeAll(ramp);
+	ASSERT_NE(audio, nullptr);
+	EXPECT_EQ(audio->numChannels, 2);
+	EXPECT_EQ(audio->sampleRate, 1000);
+	ASSERT_EQ(audio->samples.size(), 10000U);
+	EXPECT_EQ(audio->samples[0], 0.F);
+	EXPECT_EQ(audio->samples[9999], 9999.F);
+
+	RampDecoder empty { 2, 0 };
+	EXPECT_EQ(DecodeAll(empty), nullptr);
+}
+
+TEST(PcmAulibDecoderTest, PlaysDecodedAudio)
+{
+	RampDecoder ramp { 2, 4000 };
+	const std::shared_ptr<const DecodedAudio> audio = DecodeAll(ramp);
+	ASSERT_NE(audio, nullptr);
+	PcmAulibDecoder decoder { audio };
+	PcmAulibDecoder other { audio };
+	EXPECT_EQ(decoder.getChannels(), 2);
+	EXPECT_EQ(decoder.getRate(), 1000);
+	// 2000 frames at 1000 Hz
+	EXPECT_EQ(decoder.duration(), std::chrono::seconds { 2 });
+
+	float buf[3000];
+	bool callAgain = true;
+	EXPECT_EQ(decoder.decode(buf, 3000, callAgain), 3000);
+	EXPECT_EQ(buf[2999], 2999.F);
+	// Stops at the end of the audio
+	EXPECT_EQ(decoder.decode(buf, 3000, callAgain), 1000);
+	EXPECT_EQ(buf[0], 3000.F);
+	EXPECT_EQ(buf[999], 3999.F);
+	EXPECT_FALSE(callAgain);
+	EXPECT_EQ(decoder.decode(buf, 3000, callAgain), 0);
+	EXPECT_FALSE(callAgain);
+
+	// Decoders sharing the audio play it independently
+	EXPECT_EQ(other.decode(buf, 10, callAgain), 10);
+	EXPECT_EQ(buf[9], 9.F);
+
+	// Seeks to the first sample of the frame
+	EXPECT_TRUE(decoder.seekToTime(std::chrono::milliseconds { 500 }));
+	EXPECT_EQ(decoder.decode(buf, 2, callAgain), 2);
+	EXPECT_EQ(buf[0], 1000.F);
+	EXPECT_TRUE(decoder.seekToTime(std::chrono::seconds { 5 }));
+	EXPECT_EQ(decoder.decode(buf, 2, callAgain), 0);
+
+	EXPECT_TRUE(decoder.rewind());
+	EXPECT_EQ(decoder.decode(buf, 2, callAgain), 2);
+	EXPECT_EQ(buf[1], 1.F);
+}
@@ -1,7 +1,18 @@
 #include "player_test.h"
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "engine/assets.hpp"
+#include "utils/file_util.h"
+#include "utils/paths.h"
+
 using namespace devilution;
 
 namespace devilution {
@@ -184,3 +195,139 @@ TEST(Player, CreatePlayer)
 	CreatePlayer(0, HeroClass::Rogue);
 	AssertPlayer(Players[0]);
 }
+
+namespace {
+
+bool PointsInto(const std::optional<CelSprite> &celSprite, const PlayerAnimationData &animationData, std::size_t size)
+{
+	const byte *data = animationData.RawData.get();
+	return celSprite && data != nullptr && celSprite->Data() >= data && celSprite->Data() < data + size;
+}
+
+/**
+ * @brief Writes player graphics overrides to the pref path and removes them again after the test.
+ */
+class PlayerGFXTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		Player &player = Players[0];
+		prefPath_ = paths::PrefPath();
+		leveltype_ = leveltype;
+		class_ = player._pClass;
+		gfxnum_ = player._pgfxnum;
+		animInfo_ = player.AnimInfo;
+
+		paths::SetPrefPath("./");
+		InvalidateAssetIndex();
+	}
+
+	void TearDown() override
+	{
+		Player &player = Players[0];
+		ClearPlayerGFXLoads();
+		ResetPlayerGFX(player);
+		for (const std::string &path : files_)
+			RemoveFile(path);
+		for (auto it = dirs_.rbegin(); it != dirs_.rend(); ++it)
+			RemoveDir(it->c_str());
+
+		player._pClass = class_;
+		player._pgfxnum = gfxnum_;
+		player.AnimInfo = animInfo_;
+		leveltype = leveltype_;
+		paths::SetPrefPath(prefPath_);
+		InvalidateAssetIndex();
+	}
+
+	/**
+	 * @brief Writes a CL2 file override whose 8 directions all point to the same frame.
+	 * @return The contents of the file
+	 */
+	std::string WritePlrGFXOverride(const std::string &path, char frame)
+	{
+		std::string contents;
+		for (int i = 0; i < 8; i++)
+			contents += std::string { 32, 0, 0, 0 };
+		contents += std::string(4, frame);
+
+		for (std::size_t pos = path.find('/'); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+			std::string dir = path.substr(0, pos);
+			if (std::find(dirs_.begin(), dirs_.end(), dir) != dirs_.end())
+				continue;
+			CreateDir(dir.c_str());
+			dirs_.push_back(std::move(dir));
+		}
+		files_.push_back(path);
+		std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+		file << contents;
+		return contents;
+	}
+
+private:
+	std::string prefPath_;
+	dungeon_type leveltype_;
+	HeroClass class_;
+	int gfxnum_;
+	AnimationInfo animInfo_;
+	/** Directories created by WritePlrGFXOverride, parents first */
+	std::vector<std::string> dirs_;
+	std::vector<std::string> files_;
+};
+
+} // namespace
+
+TEST_F(PlayerGFXTest, ChangePlayerGFXInBackground)
+{
+	if (SDL_GetCPUCount() <= 1)
+		GTEST_SKIP() << "Player graphics are only loaded in the background with more than one CPU";
+
+	WritePlrGFXOverride("PlrGFX/Warrior/WLN/WLNST.CL2", 'N');
+	WritePlrGFXOverride("PlrGFX/Warrior/WLU/WLUST.CL2", 'U');
+	const std::string newest = WritePlrGFXOverride("PlrGFX/Warrior/WLS/WLSST.CL2", 'S');
+
+	Player &player = Players[0];
+	const auto stand = static_cast<size_t>(player_graphic::Stand);
+	leveltype = DTYPE_TOWN;
+	player._pClass = HeroClass::Warrior;
+	player._pgfxnum = static_cast<int>(PlayerWeaponGraphic::Unarmed);
+	ResetPlayerGFX(player);
+	LoadPlrGFX(player, player_graphic::Stand);
+	ASSERT_NE(player.AnimationData[stand].RawData, nullptr);
+	player.AnimInfo.celSprite = player.AnimationData[stand].GetCelSpritesForDirection(Direction::South);
+
+	// Change the set twice before the first change is handed to the player
+	player._pgfxnum = static_cast<int>(PlayerWeaponGraphic::UnarmedShield);
+	ChangePlayerGFX(player);
+	player._pgfxnum = static_cast<int>(PlayerWeaponGraphic::Sword);
+	ChangePlayerGFX(player);
+
+	const PlayerAnimationData &previous = player.PreviousAnimationData[stand];
+	ASSERT_NE(previous.RawData, nullptr);
+	EXPECT_EQ(GetPlayerSprite(player, player_graphic::Stand, Direction::West), previous.GetCelSpritesForDirection(Direction::West));
+	EXPECT_EQ(player.AnimationData[stand].RawData, nullptr);
+	EXPECT_TRUE(IsShowingPreviousPlayerGFX(player));
+
+	const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	const auto isIdle = [&player]() {
+		return std::all_of(player.PreviousAnimationData.begin(), player.PreviousAnimationData.end(), [](const PlayerAnimationData &animationData) {
+			return animationData.RawData == nullptr;
+		});
+	};
+	do {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		ProcessPlayerGFXLoads();
+	} while (!isIdle() && std::chrono::steady_clock::now() < timeout);
+
+	EXPECT_TRUE(isIdle());
+	EXPECT_FALSE(IsShowingPreviousPlayerGFX(player));
+	const PlayerAnimationData &animationData = player.AnimationData[stand];
+	ASSERT_NE(animationData.RawData, nullptr);
+	EXPECT_EQ(std::string(reinterpret_cast<const char *>(animationData.RawData.get()), newest.size()), newest);
+	EXPECT_TRUE(PointsInto(player.AnimInfo.celSprite, animationData, newest.size()));
+	for (const PlayerAnimationData &previousData : player.PreviousAnimationData) {
+		EXPECT_EQ(previousData.RawData, nullptr);
+		for (const std::optional<CelSprite> &celSprite : previousData.CelSpritesForDirections)
+			EXPECT_EQ(celSprite, std::nullopt);
+	}
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <vector>
+
+#include "engine/benchmark.hpp"
+#include "missiles.h"
+#include "utils/pooled_list.hpp"
+
+using namespace devilution;
+
+namespace {
+
+/**
+ * @brief Spawns missiles the way a busy fight does and returns the time per game tick in milliseconds.
+ *
+ * Every tick adds `spawnsPerTick` missiles and walks the container twice like ProcessMissiles,
+ * missiles expire after a few ticks and are removed in bulk.
+ */
+template <typename Container>
+std::vector<double> SimulateMissiles(Container &missiles, int ticks, int spawnsPerTick)
+{
+	std::vector<double> samplesMs;
+	for (int tick = 0; tick < ticks; tick++) {
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < spawnsPerTick; i++) {
+			missiles.emplace_back(Missile {});
+			Missile &missile = missiles.back();
+			missile._mirange = 4 + (tick + i) % 12;
+			missile.position.tile = { i % 112, tick % 112 };
+		}
+		for (Missile &missile : missiles)
+			missile._miDelFlag = missile.position.tile.x < 0;
+		missiles.remove_if([](Missile &missile) { return missile._miDelFlag; });
+		for (Missile &missile : missiles) {
+			missile.position.traveled += { 1, 1 };
+			if (--missile._mirange <= 0)
+				missile._miDelFlag = true;
+		}
+		missiles.remove_if([](Missile &missile) { return missile._miDelFlag; });
+		samplesMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+	return samplesMs;
+}
+
+} // namespace
+
+TEST(PooledListBenchmark, MissileThroughput)
+{
+	constexpr int Ticks = 2000;
+	constexpr int SpawnsPerTick = 100; // 2000 missiles per second at 20 game ticks per second
+
+	std::list<Missile> missileList;
+	const TimingSummary listSummary = SummarizeTimings(SimulateMissiles(missileList, Ticks, SpawnsPerTick));
+	PooledList<Missile> pooledList;
+	const TimingSummary pooledSummary = SummarizeTimings(SimulateMissiles(pooledList, Ticks, SpawnsPerTick));
+
+	std::printf("Missile tick with %d spawns: std::list mean %.4f ms, PooledList mean %.4f ms\n",
+	    SpawnsPerTick, listSummary.meanMs, pooledSummary.meanMs);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "utils/pooled_list.hpp"
+
+using namespace devilution;
+
+namespace {
+
+std::vector<int> Values(const PooledList<int, 4> &list)
+{
+	std::vector<int> values;
+	for (int value : list)
+		values.push_back(value);
+	return values;
+}
+
+} // namespace
+
+TEST(PooledListTest, KeepsOrderWhenRemoving)
+{
+	PooledList<int, 4> list;
+	for (int i = 0; i < 10; i++)
+		list.push_back(i);
+	list.remove_if([](int value) { return value % 3 == 0; });
+	EXPECT_EQ(Values(list), (std::vector<int> { 1, 2, 4, 5, 7, 8 }));
+	EXPECT_EQ(list.size(), 6U);
+	EXPECT_EQ(list[2], 4);
+	EXPECT_EQ(list.back(), 8);
+}
+
+TEST(PooledListTest, VisitsElementsAddedWhileIterating)
+{
+	PooledList<int, 4> list;
+	list.push_back(3);
+	std::vector<int> visited;
+	for (int &value : list) {
+		visited.push_back(value);
+		if (value > 0)
+			list.push_back(value - 1);
+	}
+	EXPECT_EQ(visited, (std::vector<int> { 3, 2, 1, 0 }));
+}
+
+TEST(PooledListTest, AddressesStayStable)
+{
+	PooledList<int, 4> list;
+	int &first = list.emplace_back(42);
+	for (int i = 0; i < 100; i++)
+		list.push_back(i);
+	EXPECT_EQ(&first, &list[0]);
+	EXPECT_EQ(first, 42);
+}
+
+TEST(PooledListTest, ReusesSlots)
+{
+	PooledList<int, 4> list;
+	for (int i = 0; i < 8; i++)
+		list.push_back(i);
+	EXPECT_EQ(list.capacity(), 8U);
+
+	list.remove_if([](int value) { return value < 4; });
+	for (int i = 0; i < 4; i++)
+		list.push_back(i);
+	EXPECT_EQ(list.capacity(), 8U);
+
+	list.clear();
+	EXPECT_TRUE(list.empty());
+	int &first = list.emplace_back(1);
+	list.push_back(2);
+	EXPECT_EQ(&list[1], &first + 1);
+	EXPECT_EQ(list.capacity(), 8U);
+}
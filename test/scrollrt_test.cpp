@@ -1,7 +1,20 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
 #include "control.h"
+#include "cursor.h"
 #include "diablo.h"
+#include "engine/render/dun_render.hpp"
+#include "gendung.h"
+#include "lighting.h"
+#include "options.h"
+#include "palette.h"
+#include "player.h"
 #include "scrollrt.h"
 #include "utils/ui_fwd.h"
 
@@ -166,3 +179,289 @@ TEST(Scroll_rt, calc_tiles_covered_by_panel_960_zoom)
 	CalculatePanelAreas();
 	EXPECT_EQ(RowsCoveredByPanel(), 2);
 }
+
+namespace devilution {
+extern void TestDrawFloorAndTileContent(const Surface &out, Point tilePosition, Point targetBufferPosition, int rows, int columns);
+}
+
+namespace {
+
+constexpr int ViewWidth = 320;
+/** Splitting this height into 3 bands puts both band boundaries in the middle of a tile row */
+constexpr int ViewHeight = 257;
+constexpr int RenderBands = 3;
+constexpr Point ViewTile { 30, 10 };
+constexpr Point ViewBufferPosition { -16, 5 };
+constexpr int ViewRows = 20;
+constexpr int ViewColumns = 7;
+
+constexpr int PieceCount = 16;
+constexpr int TileTypeCount = 6;
+constexpr int TransparentSquare = 1;
+constexpr int SpriteWidth = 32;
+constexpr int SpriteHeight = 40;
+constexpr int SpecialFrameCount = 3;
+
+/** Size reserved for every dungeon frame, large enough for any tile encoding. */
+constexpr std::size_t FrameSize = 1024;
+
+/** Fills the global tile data with one random frame per tile type, frame `n` having tile type `n`. */
+void FillDungeonCels(std::mt19937 &rng)
+{
+	const std::size_t headerSize = sizeof(std::uint32_t) * TileTypeCount;
+	pDungeonCels = std::make_unique<byte[]>(headerSize + FrameSize * TileTypeCount);
+	auto *data = reinterpret_cast<std::uint8_t *>(pDungeonCels.get());
+	for (int frame = 0; frame < TileTypeCount; frame++) {
+		const std::uint32_t offset = SDL_SwapLE32(static_cast<std::uint32_t>(headerSize + FrameSize * frame));
+		memcpy(&data[sizeof(std::uint32_t) * frame], &offset, sizeof(offset));
+
+		std::uint8_t *src = &data[headerSize + FrameSize * frame];
+		if (frame != TransparentSquare) {
+			for (std::size_t i = 0; i < FrameSize; i++)
+				src[i] = static_cast<std::uint8_t>(rng());
+			continue;
+		}
+
+		// Transparent squares are RLE encoded, the runs must add up to exactly 32 per row.
+		for (int row = 0; row < TILE_HEIGHT; row++) {
+			int remaining = TILE_WIDTH / 2;
+			while (remaining > 0) {
+				const int run = std::min<int>(remaining, 1 + rng() % 12);
+				if (rng() % 3 == 0) {
+					*src++ = static_cast<std::uint8_t>(-run);
+				} else {
+					*src++ = static_cast<std::uint8_t>(run);
+					for (int i = 0; i < run; i++)
+						*src++ = static_cast<std::uint8_t>(rng());
+				}
+				remaining -= run;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Builds a sprite file with the given number of frames of SpriteWidth x SpriteHeight pixels.
+ * @param cl2 Encode the frames as CL2 instead of CEL
+ */
+std::unique_ptr<byte[]> BuildSprite(std::mt19937 &rng, int frameCount, bool cl2)
+{
+	std::vector<std::uint8_t> frames;
+	std::vector<std::uint32_t> offsets;
+	const std::size_t headerSize = sizeof(std::uint32_t) * (frameCount + 2);
+	for (int frame = 0; frame < frameCount; frame++) {
+		offsets.push_back(static_cast<std::uint32_t>(headerSize + frames.size()));
+		// Frame header pointing past itself
+		frames.insert(frames.end(), { 10, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+		for (int row = 0; row < SpriteHeight; row++) {
+			if (cl2) {
+				// 4 transparent pixels, a fill of 8 pixels and 20 single pixels
+				frames.insert(frames.end(), { 4, 0xBF - 8, static_cast<std::uint8_t>(rng()), static_cast<std::uint8_t>(-20) });
+				for (int i = 0; i < 20; i++)
+					frames.push_back(static_cast<std::uint8_t>(rng()));
+			} else {
+				// 4 transparent pixels and 28 single pixels
+				frames.insert(frames.end(), { static_cast<std::uint8_t>(-4), 28 });
+				for (int i = 0; i < 28; i++)
+					frames.push_back(static_cast<std::uint8_t>(rng()));
+			}
+		}
+	}
+	offsets.push_back(static_cast<std::uint32_t>(headerSize + frames.size()));
+
+	auto data = std::make_unique<byte[]>(headerSize + frames.size());
+	auto *dst = reinterpret_cast<std::uint8_t *>(data.get());
+	const std::uint32_t count = SDL_SwapLE32(static_cast<std::uint32_t>(frameCount));
+	memcpy(dst, &count, sizeof(count));
+	for (std::size_t i = 0; i < offsets.size(); i++) {
+		const std::uint32_t offset = SDL_SwapLE32(offsets[i]);
+		memcpy(&dst[sizeof(std::uint32_t) * (i + 1)], &offset, sizeof(offset));
+	}
+	memcpy(&dst[headerSize], frames.data(), frames.size());
+	return data;
+}
+
+/**
+ * @brief Returns the tile drawn at the given row and column, walking the view like DrawFloor does.
+ */
+Point TileInView(int row, int column)
+{
+	Point tile = ViewTile;
+	for (int i = 0; i < row; i++) {
+		if ((i & 1) != 0)
+			tile.x++;
+		else
+			tile.y++;
+	}
+	return tile + Displacement(Direction::East) * column;
+}
+
+struct RenderResult {
+	std::vector<std::uint8_t> pixels;
+	std::vector<DungeonFlag> flags;
+};
+
+class DrawGameBandsTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		leveltype_ = leveltype;
+		microTileLen_ = MicroTileLen;
+		screenWidth_ = gnScreenWidth;
+		myPlayer_ = MyPlayer;
+		pcursplr_ = pcursplr;
+		renderThreads_ = *sgOptions.Graphics.renderThreads;
+	}
+
+	void TearDown() override
+	{
+		Player &deadPlayer = Players[1];
+		deadPlayer.plractive = false;
+		deadPlayer.AnimInfo = {};
+		deadPlayerSprite_ = nullptr;
+		pDungeonCels = nullptr;
+		pSpecialCels = std::nullopt;
+
+		leveltype = leveltype_;
+		MicroTileLen = microTileLen_;
+		gnScreenWidth = screenWidth_;
+		MyPlayer = myPlayer_;
+		pcursplr = pcursplr_;
+		sgOptions.Graphics.renderThreads.SetValue(renderThreads_);
+	}
+
+	/**
+	 * @brief Fills the map with random floors, walls, arches and lighting and puts a dead player on the given tile.
+	 *
+	 * The tiles in front of the dead player are plain floors, so that it stays visible.
+	 */
+	void CreateLevel(std::mt19937 &rng, Point deadPlayerTile)
+	{
+		leveltype = DTYPE_CATHEDRAL;
+		MicroTileLen = 10;
+		gnScreenWidth = ViewWidth;
+		MyPlayer = &Players[0];
+		pcursplr = -1;
+
+		FillDungeonCels(rng);
+		pSpecialCels.emplace(BuildSprite(rng, SpecialFrameCount, /*cl2=*/false), SpriteWidth);
+		for (auto &entry : LightTables)
+			entry = static_cast<std::uint8_t>(rng());
+		for (auto &row : paletteTransparencyLookup) {
+			for (auto &entry : row)
+				entry = static_cast<std::uint8_t>(rng());
+		}
+		for (int i = 0; i < 256; i++)
+			TransList[i] = i % 2 != 0;
+		for (int piece = 1; piece < PieceCount; piece++) {
+			nSolidTable[piece] = piece % 4 == 0;
+			nTransTable[piece] = piece % 3 == 0;
+			block_lvid[piece] = piece % 3;
+		}
+
+		for (int x = 0; x < MAXDUNX; x++) {
+			for (int y = 0; y < MAXDUNY; y++) {
+				dPiece[x][y] = rng() % 8 == 0 ? 0 : 1 + rng() % (PieceCount - 1);
+				// Only walls have micros above the floor
+				const int microCount = nSolidTable[dPiece[x][y]] ? MicroTileLen : 2;
+				for (int i = 0; i < MicroTileLen; i++) {
+					const int tileType = i < microCount ? rng() % TileTypeCount : 0;
+					dpiece_defs_map_2[x][y].mt[i] = static_cast<uint16_t>((tileType << 12) | tileType);
+				}
+				dTransVal[x][y] = static_cast<int8_t>(rng() % 4);
+				dLight[x][y] = static_cast<char>(rng() % (LightsMax + 1));
+				dSpecial[x][y] = rng() % 4 == 0 ? static_cast<char>(1 + rng() % SpecialFrameCount) : 0;
+				dFlags[x][y] = DungeonFlag::Lit;
+			}
+		}
+
+		for (int row = 1; row <= 10; row++) {
+			for (int column = -2; column <= 2; column++) {
+				const Point tile = deadPlayerTile + Displacement { row / 2, (row + 1) / 2 } + Displacement(Direction::East) * column;
+				dPiece[tile.x][tile.y] = 1;
+				dSpecial[tile.x][tile.y] = 0;
+				for (int i = 2; i < MicroTileLen; i++)
+					dpiece_defs_map_2[tile.x][tile.y].mt[i] = 0;
+			}
+		}
+		dPiece[deadPlayerTile.x][deadPlayerTile.y] = 1;
+		dSpecial[deadPlayerTile.x][deadPlayerTile.y] = 1;
+		dFlags[deadPlayerTile.x][deadPlayerTile.y] |= DungeonFlag::DeadPlayer;
+
+		deadPlayerSprite_ = BuildSprite(rng, 1, /*cl2=*/true);
+		Player &deadPlayer = Players[1];
+		deadPlayer.plractive = true;
+		deadPlayer._pHitPoints = 0;
+		deadPlayer.plrlevel = currlevel;
+		deadPlayer.position.tile = deadPlayerTile;
+		deadPlayer.position.offset = {};
+		deadPlayer.previewCelSprite = std::nullopt;
+		deadPlayer.pManaShield = false;
+		deadPlayer.wReflections = 0;
+		deadPlayer.AnimInfo = {};
+		deadPlayer.AnimInfo.SetNewAnimation(CelSprite { deadPlayerSprite_.get(), SpriteWidth }, 1, 1);
+	}
+
+	static RenderResult Render(int renderThreads)
+	{
+		const std::vector<DungeonFlag> initialFlags(&dFlags[0][0], &dFlags[0][0] + MAXDUNX * MAXDUNY);
+		sgOptions.Graphics.renderThreads.SetValue(renderThreads);
+
+		OwnedSurface out { ViewWidth, ViewHeight };
+		for (int y = 0; y < ViewHeight; y++)
+			memset(out.at(0, y), 0xAB, ViewWidth);
+		TestDrawFloorAndTileContent(out, ViewTile, ViewBufferPosition, ViewRows, ViewColumns);
+
+		RenderResult result;
+		result.pixels.resize(ViewWidth * ViewHeight);
+		for (int y = 0; y < ViewHeight; y++)
+			memcpy(&result.pixels[y * ViewWidth], out.at(0, y), ViewWidth);
+		result.flags.assign(&dFlags[0][0], &dFlags[0][0] + MAXDUNX * MAXDUNY);
+		std::copy(initialFlags.begin(), initialFlags.end(), &dFlags[0][0]);
+		return result;
+	}
+
+private:
+	std::unique_ptr<byte[]> deadPlayerSprite_;
+	dungeon_type leveltype_;
+	int microTileLen_;
+	Uint16 screenWidth_;
+	Player *myPlayer_;
+	int8_t pcursplr_;
+	int renderThreads_;
+};
+
+} // namespace
+
+TEST_F(DrawGameBandsTest, MatchesSerialRendering)
+{
+	static_assert(ViewHeight / RenderBands % (TILE_HEIGHT / 2) != 0, "The band boundaries have to cut through tiles");
+#ifdef DISABLE_RENDER_THREADS
+	GTEST_SKIP() << "Render threads are disabled";
+#endif
+	if (SDL_GetCPUCount() < RenderBands)
+		GTEST_SKIP() << "Render bands are limited to the number of CPU cores";
+
+	// The bottom of a sprite drawn in row 6 is at y 101, so the 40 pixel high dead player and arch cross the first band boundary at y 85.
+	const Point deadPlayerTile = TileInView(6, 3);
+	// A flagged tile without a dead player, which rendering clears the flag of
+	const Point staleFlagTile = TileInView(12, 2);
+
+	std::mt19937 rng(42);
+	CreateLevel(rng, deadPlayerTile);
+	dPiece[staleFlagTile.x][staleFlagTile.y] = 1;
+	dFlags[staleFlagTile.x][staleFlagTile.y] |= DungeonFlag::DeadPlayer;
+
+	const RenderResult serial = Render(1);
+	const RenderResult banded = Render(RenderBands);
+
+	EXPECT_TRUE(serial.pixels == banded.pixels) << "The banded rendering differs from the serial one";
+	EXPECT_TRUE(serial.flags == banded.flags) << "The banded rendering updated dFlags differently";
+	EXPECT_TRUE(HasAnyOf(banded.flags[deadPlayerTile.x * MAXDUNY + deadPlayerTile.y], DungeonFlag::DeadPlayer));
+	EXPECT_FALSE(HasAnyOf(banded.flags[staleFlagTile.x * MAXDUNY + staleFlagTile.y], DungeonFlag::DeadPlayer));
+
+	// The dead player has been drawn, the pixels around its tile differ without it
+	Players[1].plractive = false;
+	const RenderResult withoutDeadPlayer = Render(RenderBands);
+	EXPECT_FALSE(withoutDeadPlayer.pixels == banded.pixels);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "engine/assets.hpp"
+#include "engine/render/text_render.hpp"
+#include "engine/surface.hpp"
+#include "utils/stdcompat/string_view.hpp"
+
+using namespace devilution;
+
+namespace devilution {
+extern uint32_t TestDrawStringUncached(const Surface &out, string_view text, const Rectangle &rect, UiFlags flags, int spacing, int lineHeight);
+}
+
+namespace {
+
+constexpr Size SurfaceSize { 200, 100 };
+
+bool HasFont(const char *path)
+{
+	SDL_RWops *handle = OpenAsset(path);
+	if (handle == nullptr)
+		return false;
+	SDL_RWclose(handle);
+	return true;
+}
+
+bool SamePixels(const Surface &a, const Surface &b)
+{
+	for (int y = 0; y < a.h(); y++) {
+		for (int x = 0; x < a.w(); x++) {
+			if (*a.at(x, y) != *b.at(x, y))
+				return false;
+		}
+	}
+	return true;
+}
+
+bool AnyPixels(const Surface &surface)
+{
+	for (int y = 0; y < surface.h(); y++) {
+		for (int x = 0; x < surface.w(); x++) {
+			if (*surface.at(x, y) != 0)
+				return true;
+		}
+	}
+	return false;
+}
+
+class DrawStringTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		if (!HasFont("fonts\\12-00.pcx") || !HasFont("fonts\\24-00.pcx") || !HasFont("fonts\\white.trn"))
+			GTEST_SKIP() << "The fonts are not in the assets";
+		UnloadFonts();
+	}
+
+	void TearDown() override
+	{
+		UnloadFonts();
+	}
+
+	/**
+	 * @brief Draws the string twice through DrawString, so the second draw uses the cached layout, and compares it to the uncached path.
+	 */
+	static uint32_t ExpectSameAsUncached(string_view text, Rectangle rect, UiFlags flags, int spacing = 1, int lineHeight = -1, Size surfaceSize = SurfaceSize)
+	{
+		OwnedSurface first { surfaceSize };
+		OwnedSurface cached { surfaceSize };
+		OwnedSurface uncached { surfaceSize };
+
+		const uint32_t firstResult = DrawString(first, text, rect, flags, spacing, lineHeight);
+		const uint32_t cachedResult = DrawString(cached, text, rect, flags, spacing, lineHeight);
+		const uint32_t uncachedResult = TestDrawStringUncached(uncached, text, rect, flags, spacing, lineHeight);
+
+		EXPECT_EQ(firstResult, uncachedResult);
+		EXPECT_EQ(cachedResult, uncachedResult);
+		EXPECT_TRUE(AnyPixels(uncached));
+		EXPECT_TRUE(SamePixels(first, uncached));
+		EXPECT_TRUE(SamePixels(cached, uncached));
+		return uncachedResult;
+	}
+};
+
+TEST_F(DrawStringTest, MatchesUncachedSingleLine)
+{
+	const string_view text = "The Butcher";
+	EXPECT_EQ(ExpectSameAsUncached(text, { { 10, 10 }, { 180, 0 } }, UiFlags::FontSize12 | UiFlags::ColorWhite), text.size());
+}
+
+TEST_F(DrawStringTest, MatchesUncachedWrappedText)
+{
+	const std::string text = WordWrapString("Ah, sweet mother of all that is holy, the Lord of Terror has returned to Tristram.", 120);
+	ExpectSameAsUncached(text, { { 4, 0 }, { 120, 0 } }, UiFlags::FontSize12 | UiFlags::ColorWhite);
+	// Lines longer than the box are broken wherever they reach the right margin
+	ExpectSameAsUncached("Thisisalongwordwithoutanyplacetobreakit", { { 4, 0 }, { 60, 0 } }, UiFlags::FontSize12 | UiFlags::ColorWhite);
+}
+
+TEST_F(DrawStringTest, MatchesUncachedAlignment)
+{
+	const string_view text = "Stay awhile\nand listen";
+	const Rectangle rect { { 20, 5 }, { 160, 90 } };
+	ExpectSameAsUncached(text, rect, UiFlags::FontSize12 | UiFlags::ColorWhite | UiFlags::AlignCenter);
+	ExpectSameAsUncached(text, rect, UiFlags::FontSize12 | UiFlags::ColorWhite | UiFlags::AlignRight);
+	ExpectSameAsUncached(text, rect, UiFlags::FontSize24 | UiFlags::ColorGold | UiFlags::AlignCenter | UiFlags::VerticalCenter);
+	ExpectSameAsUncached("Too wide to fit the box", { { 20, 5 }, { 80, 20 } }, UiFlags::FontSize12 | UiFlags::ColorWhite | UiFlags::KerningFitSpacing, 2);
+}
+
+TEST_F(DrawStringTest, MatchesUncachedWhenStoppingAtSurfaceBottom)
+{
+	const string_view text = "One\nTwo\nThree\nFour\nFive\nSix";
+	const uint32_t bytesDrawn = ExpectSameAsUncached(text, { { 0, 0 }, { 200, 200 } }, UiFlags::FontSize12 | UiFlags::ColorWhite, 1, -1, { 200, 40 });
+	EXPECT_LT(bytesDrawn, text.size());
+}
+
+TEST_F(DrawStringTest, MatchesUncachedAtAnotherPosition)
+{
+	const string_view text = "Fresh meat!\nCome here";
+	const Rectangle box { { 0, 0 }, { 120, 30 } };
+	OwnedSurface scratch { SurfaceSize };
+	DrawString(scratch, text, box, UiFlags::FontSize12 | UiFlags::ColorWhite);
+	// The layout is cached relative to the box, so moving the box reuses it
+	ExpectSameAsUncached(text, { { 50, 60 }, box.size }, UiFlags::FontSize12 | UiFlags::ColorWhite);
+}
+
+TEST_F(DrawStringTest, MatchesUncachedAfterEviction)
+{
+	const string_view text = "Evicted";
+	OwnedSurface scratch { SurfaceSize };
+	DrawString(scratch, text, { { 0, 0 }, { 100, 0 } }, UiFlags::FontSize12 | UiFlags::ColorWhite);
+	// More distinct strings than layouts are kept
+	for (int i = 0; i < 300; i++)
+		DrawString(scratch, std::to_string(i), { { 0, 0 }, { 100, 0 } }, UiFlags::FontSize12 | UiFlags::ColorWhite);
+	ExpectSameAsUncached(text, { { 0, 0 }, { 100, 0 } }, UiFlags::FontSize12 | UiFlags::ColorWhite);
+}
+
+} // namespace
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "gendung.h"
+#include "tile_store.h"
+
+using namespace devilution;
+
+TEST(TileStoreTest, CopiesTileData)
+{
+	const Point position { 30, 40 };
+	dPiece[30][40] = 12;
+	nSolidTable[12] = true;
+	nTransTable[12] = false;
+	dpiece_defs_map_2[30][40].mt[0] = 101;
+	dpiece_defs_map_2[30][40].mt[1] = 102;
+	dTransVal[30][40] = 5;
+	dCorpse[30][40] = 3;
+	dLight[30][40] = 7;
+	dSpecial[30][40] = 2;
+	dPlayer[30][40] = 1;
+	dMonster[30][40] = -4;
+
+	UpdateTileRenderStore(Rectangle { position, 0 });
+
+	const TileRenderData &tile = GetTileRenderData(position);
+	EXPECT_EQ(tile.piece, 12);
+	EXPECT_EQ(tile.floor[0], 101);
+	EXPECT_EQ(tile.floor[1], 102);
+	EXPECT_EQ(tile.transVal, 5);
+	EXPECT_EQ(tile.corpse, 3);
+	EXPECT_EQ(tile.light, 7);
+	EXPECT_EQ(tile.special, 2);
+	// Monsters only moving onto the tile are not drawn there
+	EXPECT_EQ(tile.flags, TileRenderFlag::Solid | TileRenderFlag::Player);
+}
+
+TEST(TileStoreTest, OnlyUpdatesArea)
+{
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++)
+			dPiece[x][y] = 1;
+	}
+	UpdateTileRenderStore({ { 0, 0 }, Size { MAXDUNX, MAXDUNY } });
+
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++)
+			dPiece[x][y] = 2;
+	}
+	// Parts outside of the map are ignored
+	UpdateTileRenderStore({ { -5, MAXDUNY - 3 }, Size { 10, 10 } });
+
+	EXPECT_EQ(GetTileRenderData({ 0, MAXDUNY - 3 }).piece, 2);
+	EXPECT_EQ(GetTileRenderData({ 4, MAXDUNY - 1 }).piece, 2);
+	EXPECT_EQ(GetTileRenderData({ 5, MAXDUNY - 1 }).piece, 1);
+	EXPECT_EQ(GetTileRenderData({ 0, MAXDUNY - 4 }).piece, 1);
+}